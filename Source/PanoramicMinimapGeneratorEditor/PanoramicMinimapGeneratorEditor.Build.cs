@@ -23,13 +23,19 @@ public class PanoramicMinimapGeneratorEditor : ModuleRules
                 "SlateCore",
                 "Projects",
                 "UnrealEd",      // Required for Editor functionality
+                "EditorSubsystem",
                 "LevelEditor",   // Required to add items to the main menu
                 "ToolMenus",
                 "AssetTools",
                 "ImageWrapper",
+                "ImageCore",     // Reads texture sources for patch captures
+                "Json",
+                "JsonUtilities",
+                "PanoramicMinimapGeneratorImageKernels",
                 "PanoramicMinimapGeneratorRuntime",
                 "RHI",
                 "RenderCore",
+                "WorldPartitionEditor", // Loads the capture region's cells
                 "InputCore", "AppFramework", "PropertyEditor" 
             }
         );
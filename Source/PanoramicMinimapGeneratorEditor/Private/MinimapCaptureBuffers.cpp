@@ -0,0 +1,125 @@
+#include "MinimapCaptureBuffers.h"
+#include "MinimapGeneratorManager.h"
+#include "MinimapImageKernels.h"
+
+#include "Async/ParallelFor.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+
+namespace MinimapCaptureBuffers
+{
+	static FColor PackUnorm16(const double Value)
+	{
+		const uint16 Packed = static_cast<uint16>(FMath::RoundToInt(FMath::Clamp(Value, 0.0, 1.0) * 65535.0));
+		return FColor(static_cast<uint8>(Packed >> 8), static_cast<uint8>(Packed & 0xFF), 0, 255);
+	}
+
+	static uint8 PackSnorm8(const float Value)
+	{
+		return static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Value * 0.5f + 0.5f, 0.0f, 1.0f) * 255.0f));
+	}
+}
+
+TConstArrayView<EMinimapCaptureBuffer> MinimapCaptureBuffers::GetAll()
+{
+	static constexpr EMinimapCaptureBuffer Buffers[] = {
+		EMinimapCaptureBuffer::BaseColor, EMinimapCaptureBuffer::Height, EMinimapCaptureBuffer::Normal, EMinimapCaptureBuffer::Depth};
+	return Buffers;
+}
+
+ESceneCaptureSource MinimapCaptureBuffers::GetCaptureSource(const EMinimapCaptureBuffer Buffer)
+{
+	switch (Buffer)
+	{
+	case EMinimapCaptureBuffer::BaseColor: return SCS_BaseColor;
+	case EMinimapCaptureBuffer::Normal: return SCS_Normal;
+	case EMinimapCaptureBuffer::Height:
+	case EMinimapCaptureBuffer::Depth:
+	default: return SCS_SceneDepth;
+	}
+}
+
+bool MinimapCaptureBuffers::IsFloatBuffer(const EMinimapCaptureBuffer Buffer)
+{
+	return Buffer != EMinimapCaptureBuffer::BaseColor;
+}
+
+bool MinimapCaptureBuffers::Is16Bit(const EMinimapCaptureBuffer Buffer)
+{
+	return Buffer == EMinimapCaptureBuffer::Height || Buffer == EMinimapCaptureBuffer::Depth;
+}
+
+const TCHAR* MinimapCaptureBuffers::GetFileSuffix(const EMinimapCaptureBuffer Buffer)
+{
+	switch (Buffer)
+	{
+	case EMinimapCaptureBuffer::BaseColor: return TEXT("BaseColor");
+	case EMinimapCaptureBuffer::Height: return TEXT("Height");
+	case EMinimapCaptureBuffer::Normal: return TEXT("Normal");
+	case EMinimapCaptureBuffer::Depth:
+	default: return TEXT("Depth");
+	}
+}
+
+void MinimapCaptureBuffers::PackTile(const EMinimapCaptureBuffer Buffer, const FMinimapCaptureSettings& Settings,
+                                     TConstArrayView<FLinearColor> Samples, TArray<FColor>& OutPixels)
+{
+	OutPixels.SetNumUninitialized(Samples.Num());
+
+	// The camera looks straight down, so the scene depth of a pixel is its distance below the camera.
+	const double CameraHeight = Settings.CameraHeight;
+	const double MinHeight = Settings.CaptureBounds.Min.Z;
+	const double HeightRange = FMath::Max(Settings.CaptureBounds.Max.Z - MinHeight, UE_KINDA_SMALL_NUMBER);
+	const double DepthRange = FMath::Max(CameraHeight - MinHeight, UE_KINDA_SMALL_NUMBER);
+
+	constexpr int32 PixelsPerTask = 64 * 1024;
+	ParallelFor(FMath::DivideAndRoundUp(Samples.Num(), PixelsPerTask), [&](const int32 ChunkIndex)
+	{
+		const int32 Begin = ChunkIndex * PixelsPerTask;
+		const int32 End = FMath::Min(Begin + PixelsPerTask, Samples.Num());
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const FLinearColor& Sample = Samples[Index];
+			switch (Buffer)
+			{
+			case EMinimapCaptureBuffer::Height:
+				OutPixels[Index] = PackUnorm16((CameraHeight - Sample.R - MinHeight) / HeightRange);
+				break;
+			case EMinimapCaptureBuffer::Depth:
+				OutPixels[Index] = PackUnorm16(Sample.R / DepthRange);
+				break;
+			case EMinimapCaptureBuffer::Normal:
+				OutPixels[Index] = FColor(PackSnorm8(Sample.R), PackSnorm8(Sample.G), 0, 255);
+				break;
+			default:
+				OutPixels[Index] = Sample.ToFColor(false);
+				break;
+			}
+		}
+	});
+}
+
+bool MinimapCaptureBuffers::EncodePng(const EMinimapCaptureBuffer Buffer, TConstArrayView<FColor> Canvas, const FIntPoint& Size,
+                                      TArray64<uint8>& OutPng)
+{
+	if (!Is16Bit(Buffer))
+	{
+		return MinimapImageKernels::EncodePng(Canvas, Size, OutPng);
+	}
+
+	TArray<uint16> Gray;
+	Gray.SetNumUninitialized(Canvas.Num());
+	for (int32 Index = 0; Index < Canvas.Num(); ++Index)
+	{
+		Gray[Index] = static_cast<uint16>((Canvas[Index].R << 8) | Canvas[Index].G);
+	}
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(Gray.GetData(), Gray.Num() * sizeof(uint16), Size.X, Size.Y, ERGBFormat::Gray, 16))
+	{
+		return false;
+	}
+	OutPng = ImageWrapper->GetCompressed();
+	return OutPng.Num() > 0;
+}
@@ -0,0 +1,273 @@
+#include "MinimapCaptureCommandlet.h"
+#include "MinimapCaptureReport.h"
+#include "MinimapGeneratorManager.h"
+#include "MinimapGeneratorStats.h"
+#include "MinimapImageKernels.h"
+#include "MinimapTileSources.h"
+#include "MinimapTileStitcher.h"
+#include "PanoramicMinimapGeneratorEditor.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/SavePackage.h"
+
+namespace MinimapCaptureCommandlet
+{
+	static bool SavePackages(const TArray<UPackage*>& Packages)
+	{
+		bool bAllSaved = true;
+		for (UPackage* Package : Packages)
+		{
+			const FString PackageFilename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+			if (UPackage::SavePackage(Package, nullptr, *PackageFilename, SaveArgs))
+			{
+				UE_LOG(OBPanoramicMinimapGenerator, Display, TEXT("Saved %s"), *PackageFilename);
+			}
+			else
+			{
+				UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to save %s"), *PackageFilename);
+				bAllSaved = false;
+			}
+		}
+		return bAllSaved;
+	}
+}
+
+UMinimapCaptureCommandlet::UMinimapCaptureCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMinimapCaptureCommandlet::Main(const FString& Params)
+{
+	using namespace MinimapCaptureCommandlet;
+
+	FString SettingsPath;
+	FMinimapCaptureSettings Settings;
+	if (!FParse::Value(*Params, TEXT("settings="), SettingsPath) || !UMinimapGeneratorManager::ReadSettingsFile(SettingsPath, Settings))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Missing or unreadable -settings=<FileName>_settings.json. It is written next to the tiles of a tiled capture with Save Tiles."));
+		return 1;
+	}
+
+	if (!Settings.bUseTiling || Settings.OutputWidth <= 0 || Settings.OutputHeight <= 0 || Settings.TileResolution <= 0 ||
+		Settings.TileOverlap < 0 || UMinimapGeneratorManager::GetEffectiveTileOverlap(Settings) >= Settings.TileResolution)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%s does not describe a valid tiled capture."), *SettingsPath);
+		return 1;
+	}
+
+	FString TilesDirectory = FPaths::GetPath(SettingsPath);
+	FParse::Value(*Params, TEXT("tiles="), TilesDirectory);
+	Settings.TileSourceType = EMinimapTileSourceType::SavedTiles;
+	Settings.TileSourceDirectory = TilesDirectory;
+
+	FString OutputDirectory = TilesDirectory;
+	FParse::Value(*Params, TEXT("output="), OutputDirectory);
+	FString OutputName = Settings.FileName;
+	FParse::Value(*Params, TEXT("filename="), OutputName);
+
+	EMinimapImageFormat Format = EMinimapImageFormat::Png;
+	FString FormatName;
+	if (FParse::Value(*Params, TEXT("format="), FormatName) && !MinimapImageKernels::ParseImageFormat(FormatName, Format))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Unknown -format=%s. Use png, jpg or bmp."), *FormatName);
+		return 1;
+	}
+	int32 Quality = 90;
+	FParse::Value(*Params, TEXT("quality="), Quality);
+	int32 FeatherWidth = INDEX_NONE;
+	FParse::Value(*Params, TEXT("feather="), FeatherWidth);
+	int32 NumDownsamples = 0;
+	FParse::Value(*Params, TEXT("downsample="), NumDownsamples);
+	const bool bAllowMissingTiles = FParse::Param(*Params, TEXT("allowmissing"));
+
+	if (FParse::Param(*Params, TEXT("import")))
+	{
+		Settings.bImportAsTextureAsset = true;
+	}
+	if (FParse::Param(*Params, TEXT("definition")))
+	{
+		Settings.bExportDefinitionAsset = true;
+	}
+	if (FParse::Param(*Params, TEXT("noassets")))
+	{
+		Settings.bImportAsTextureAsset = false;
+		Settings.bExportDefinitionAsset = false;
+	}
+
+	FMinimapCaptureReport Report;
+	Report.Reset();
+
+	FMinimapTileSourceContext Context;
+	Context.Settings = Settings;
+	{
+		FMinimapScopedStageTimer StageTimer(Report, MinimapCaptureStage::GridPlanning);
+		Context.Layout = UMinimapGeneratorManager::MakeTileLayout(Settings);
+	}
+	const FMinimapTileLayout& Layout = Context.Layout;
+	Report.TileLayoutSummary = Layout.ToString();
+	UE_LOG(OBPanoramicMinimapGenerator, Display, TEXT("Re-stitching %s from '%s'."), *Layout.ToString(), *TilesDirectory);
+
+	FMinimapSavedTilesTileSource TileSource;
+	Report.TileSourceName = TileSource.GetName();
+	FString Error;
+	if (!TileSource.Begin(Context, Error))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+
+	// Tiles are read and decoded a batch at a time on the task graph, then composited in index order, so the canvas
+	// does not depend on which decode finishes first and peak memory is the canvas plus one batch of tiles.
+	FModuleManager::Get().LoadModuleChecked(TEXT("ImageWrapper"));
+	const int32 BatchSize = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	TArray<TArray<FColor>> BatchPixels;
+	BatchPixels.SetNum(BatchSize);
+	TArray<double> BatchReadSeconds;
+	BatchReadSeconds.SetNumZeroed(BatchSize);
+
+	FMinimapTileStitcher Stitcher(Settings, Layout, FeatherWidth);
+	int32 NumMissingTiles = 0;
+	int32 NumStitchedTiles = 0;
+	for (int32 BatchStart = 0; BatchStart < Layout.GetNumTiles(); BatchStart += BatchSize)
+	{
+		const int32 NumBatchTiles = FMath::Min(BatchSize, Layout.GetNumTiles() - BatchStart);
+		const double BatchStartTime = FPlatformTime::Seconds();
+		{
+			MINIMAP_STAGE_SCOPE(STAT_MinimapReadback);
+			ParallelFor(NumBatchTiles, [&TileSource, &BatchPixels, &BatchReadSeconds, BatchStart](const int32 Slot)
+			{
+				LLM_SCOPE_BYTAG(MinimapGenerator_CapturedTileData);
+				const double ReadStartTime = FPlatformTime::Seconds();
+				const int32 TileIndex = BatchStart + Slot;
+				BatchPixels[Slot].Reset();
+				if (TileSource.CanProvideTile(TileIndex))
+				{
+					FString TileError;
+					TileSource.ReadTile(TileIndex, BatchPixels[Slot], TileError);
+				}
+				BatchReadSeconds[Slot] = FPlatformTime::Seconds() - ReadStartTime;
+			});
+		}
+		Report.AddStageSeconds(MinimapCaptureStage::Readback, FPlatformTime::Seconds() - BatchStartTime);
+
+		for (int32 Slot = 0; Slot < NumBatchTiles; ++Slot)
+		{
+			const int32 TileIndex = BatchStart + Slot;
+			FMinimapTileStats TileStats;
+			TileStats.TileIndex = TileIndex;
+			TileStats.TileCoord = Layout.GetTileCoord(TileIndex);
+			TileStats.Size = Stitcher.GetTileSize(TileIndex);
+			TileStats.ReadbackSeconds = BatchReadSeconds[Slot];
+
+			if (BatchPixels[Slot].Num() == 0)
+			{
+				UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Tile (%d, %d) is missing."), TileStats.TileCoord.X, TileStats.TileCoord.Y);
+				TileStats.bSkipped = true;
+				Report.Tiles.Add(TileStats);
+				NumMissingTiles++;
+				continue;
+			}
+
+			{
+				MINIMAP_STAGE_SCOPE(STAT_MinimapComposite);
+				FMinimapScopedStageTimer StageTimer(Report, MinimapCaptureStage::Composite);
+				if (Stitcher.AddTile(TileIndex, BatchPixels[Slot], TileStats.Size))
+				{
+					NumStitchedTiles++;
+				}
+			}
+			TileStats.LatencySeconds = FPlatformTime::Seconds() - BatchStartTime;
+			Report.Tiles.Add(TileStats);
+		}
+	}
+	TileSource.End();
+	Report.SampleMemory();
+
+	if (NumStitchedTiles == 0 || (NumMissingTiles > 0 && !bAllowMissingTiles))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Stitched %d of %d tiles. Pass -allowmissing to fill missing tiles with the background color."),
+			NumStitchedTiles, Layout.GetNumTiles());
+		return 1;
+	}
+
+	FMinimapTrackedBytes CanvasBytes;
+	TArray<FColor> Canvas = Stitcher.ReleaseCanvas(CanvasBytes);
+	FIntPoint CanvasSize = Stitcher.GetCanvasSize();
+	for (int32 Step = 0; Step < NumDownsamples && CanvasSize.GetMin() > 1; ++Step)
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapComposite);
+		FMinimapScopedStageTimer StageTimer(Report, MinimapCaptureStage::Composite);
+		LLM_SCOPE_BYTAG(MinimapGenerator_StitchCanvas);
+		const FIntPoint DownsampledSize = MinimapImageKernels::GetDownsampledSize(CanvasSize);
+		TArray<FColor> Downsampled;
+		Downsampled.SetNumUninitialized(DownsampledSize.X * DownsampledSize.Y);
+		MinimapImageKernels::Downsample2x(Canvas, CanvasSize, Downsampled);
+		Canvas = MoveTemp(Downsampled);
+		CanvasSize = DownsampledSize;
+		CanvasBytes = FMinimapTrackedBytes(EMinimapMemoryTag::StitchCanvas, Canvas.GetAllocatedSize());
+	}
+
+	// The definition asset maps world bounds onto the image it references, so it has to know the final size.
+	Settings.OutputWidth = CanvasSize.X;
+	Settings.OutputHeight = CanvasSize.Y;
+
+	TArray64<uint8> EncodedImage;
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapEncode);
+		FMinimapScopedStageTimer StageTimer(Report, MinimapCaptureStage::Encode);
+		LLM_SCOPE_BYTAG(MinimapGenerator_ImageWrapperBuffers);
+		if (!MinimapImageKernels::EncodeImage(Canvas, CanvasSize, Format, Quality, EncodedImage))
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to encode the %dx%d image."), CanvasSize.X, CanvasSize.Y);
+			return 1;
+		}
+	}
+	Canvas.Empty();
+	CanvasBytes.Reset();
+
+	const FString ImagePath = FPaths::Combine(OutputDirectory, OutputName + TEXT(".") + MinimapImageKernels::GetImageFormatExtension(Format));
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapDiskWrite);
+		FMinimapScopedStageTimer StageTimer(Report, MinimapCaptureStage::DiskWrite);
+		if (!FFileHelper::SaveArrayToFile(EncodedImage, *ImagePath))
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to write %s"), *ImagePath);
+			return 1;
+		}
+	}
+	Report.FinalImageBytes = EncodedImage.Num();
+	UE_LOG(OBPanoramicMinimapGenerator, Display, TEXT("Wrote %s (%dx%d, %.1f MB)."), *ImagePath, CanvasSize.X, CanvasSize.Y,
+		EncodedImage.Num() / (1024.0 * 1024.0));
+	EncodedImage.Empty();
+
+	if (Settings.bImportAsTextureAsset || Settings.bExportDefinitionAsset)
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapTextureImport);
+		FMinimapScopedStageTimer StageTimer(Report, MinimapCaptureStage::TextureImport);
+		UMinimapGeneratorManager* Manager = NewObject<UMinimapGeneratorManager>();
+		TArray<UPackage*> Packages;
+		const bool bImported = Manager->ImportSavedImage(Settings, ImagePath, Packages);
+		if (!bImported || !SavePackages(Packages))
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to import %s as assets."), *ImagePath);
+			return 1;
+		}
+	}
+
+	Report.SampleMemory();
+	if (const FString ReportPath = Report.WriteJson(ImagePath, Settings, true); !ReportPath.IsEmpty())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Display, TEXT("Capture report written: %s"), *ReportPath);
+	}
+	return 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MinimapCaptureCommandlet.generated.h"
+
+/**
+ * Re-stitches, re-encodes and optionally re-imports a tiled capture from its saved tiles, without a world or a GPU:
+ *
+ *   UnrealEditor-Cmd <Project> -run=MinimapCapture -nullrhi -unattended
+ *       -settings=<Dir>/<FileName>_settings.json [-tiles=<Dir>] [-output=<Dir>] [-filename=<Name>]
+ *       [-format=png|jpg|bmp] [-quality=90] [-feather=<px>] [-downsample=<N>] [-allowmissing]
+ *       [-import] [-definition] [-noassets]
+ *
+ * The settings file is the one a tiled capture with Save Tiles writes next to its tiles; the tile layout is planned
+ * from it, so the tiles must come from a capture with the same output size and tiling settings. -feather narrows the
+ * blended band inside the tile overlap, -downsample halves the output N times. Texture and DataAsset export follow
+ * the settings file unless -import / -definition force them on or -noassets turns both off.
+ * Returns a non-zero exit code when the capture could not be rebuilt.
+ */
+UCLASS()
+class UMinimapCaptureCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMinimapCaptureCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,411 @@
+#include "MinimapCaptureEstimate.h"
+#include "MinimapGeneratorManager.h"
+#include "MinimapImageKernels.h"
+
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Misc/Compression.h"
+#include "RHI.h"
+
+namespace MinimapCaptureEstimate
+{
+	constexpr int64 BytesPerPixel = sizeof(FColor);
+
+	/** Rough size of the renderer's own per-view targets (GBuffer, depth, scene color, velocity) per rendered pixel. */
+	constexpr int64 SceneTextureBytesPerPixel = 40;
+
+	/** Blending with LerpUsingHSV is slow; benchmark a slice of the image rather than all of it. */
+	constexpr int32 MaxBlendBenchmarkPixels = 256 * 1024;
+
+	/** Output resolution steps tried when nothing else brings the capture under the RAM budget. */
+	constexpr int32 MaxResolutionHalvings = 4;
+
+	static FString FormatBytes(const int64 Bytes)
+	{
+		return Bytes >= 1024ll * 1024 * 1024
+			       ? FString::Printf(TEXT("%.2f GB"), Bytes / (1024.0 * 1024.0 * 1024.0))
+			       : FString::Printf(TEXT("%.1f MB"), Bytes / (1024.0 * 1024.0));
+	}
+
+	static FString FormatSeconds(const double Seconds)
+	{
+		if (Seconds >= 3600.0)
+		{
+			return FString::Printf(TEXT("%dh %02dm"), FMath::FloorToInt32(Seconds / 3600.0), FMath::FloorToInt32(FMath::Fmod(Seconds, 3600.0) / 60.0));
+		}
+		if (Seconds >= 60.0)
+		{
+			return FString::Printf(TEXT("%dm %02ds"), FMath::FloorToInt32(Seconds / 60.0), FMath::FloorToInt32(FMath::Fmod(Seconds, 60.0)));
+		}
+		return FString::Printf(TEXT("%.1fs"), Seconds);
+	}
+
+	/** Seconds elapsed since StartTime, never zero so it can be divided by. */
+	static double ElapsedSince(const double StartTime)
+	{
+		return FMath::Max(FPlatformTime::Seconds() - StartTime, 1.0e-6);
+	}
+}
+
+void FMinimapCaptureCalibration::MeasureCpuCosts(const TArray<FColor>& Pixels, const FIntPoint& Size)
+{
+	using namespace MinimapCaptureEstimate;
+
+	const int32 NumPixels = Pixels.Num();
+	if (NumPixels == 0 || NumPixels != Size.X * Size.Y)
+	{
+		return;
+	}
+	const double Megapixels = NumPixels / 1000000.0;
+	const int32 RawBytes = NumPixels * BytesPerPixel;
+
+	// PNG, with the same wrapper and format as the save task and the texture import.
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	double StartTime = FPlatformTime::Seconds();
+	const TSharedPtr<IImageWrapper> Encoder = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	if (Encoder.IsValid() && Encoder->SetRaw(Pixels.GetData(), RawBytes, Size.X, Size.Y, ERGBFormat::BGRA, 8))
+	{
+		const TArray64<uint8> Png = Encoder->GetCompressed();
+		PngEncodeMegapixelsPerSecond = Megapixels / ElapsedSince(StartTime);
+		PngBytesPerPixel = static_cast<double>(Png.Num()) / NumPixels;
+
+		StartTime = FPlatformTime::Seconds();
+		const TSharedPtr<IImageWrapper> Decoder = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+		TArray<uint8> Decoded;
+		if (Decoder.IsValid() && Decoder->SetCompressed(Png.GetData(), Png.Num()) && Decoder->GetRaw(ERGBFormat::BGRA, 8, Decoded))
+		{
+			PngDecodeMegapixelsPerSecond = Megapixels / ElapsedSince(StartTime);
+		}
+	}
+
+	// In-memory tile store.
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_LZ4, RawBytes);
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (FCompression::CompressMemory(NAME_LZ4, Compressed.GetData(), CompressedSize, Pixels.GetData(), RawBytes))
+	{
+		TileStoreCompressionRatio = static_cast<double>(RawBytes) / FMath::Max(1, CompressedSize);
+
+		TArray<FColor> Decompressed;
+		Decompressed.SetNumUninitialized(NumPixels);
+		StartTime = FPlatformTime::Seconds();
+		FCompression::UncompressMemory(NAME_LZ4, Decompressed.GetData(), RawBytes, Compressed.GetData(), CompressedSize);
+		TileDecompressNanosecondsPerPixel = ElapsedSince(StartTime) * 1.0e9 / NumPixels;
+	}
+
+	// Stitching, with the same kernels as the stitcher: row copies, the per-pixel (rotated) composite, and feather blending.
+	TArray<FColor> Canvas;
+	Canvas.SetNumUninitialized(NumPixels);
+	MinimapImageKernels::FTilePlacement Placement;
+	StartTime = FPlatformTime::Seconds();
+	MinimapImageKernels::CompositeTile(Canvas, Size, Pixels, Size, Placement);
+	CopyNanosecondsPerPixel = ElapsedSince(StartTime) * 1.0e9 / NumPixels;
+
+	// Rotation swaps the axes; measure on the square part so the tile fits the canvas.
+	const int32 SquareSide = FMath::Min(Size.X, Size.Y);
+	Placement.bRotateClockwise = true;
+	StartTime = FPlatformTime::Seconds();
+	MinimapImageKernels::CompositeTile(Canvas, Size, MakeArrayView(Pixels.GetData(), SquareSide * SquareSide), FIntPoint(SquareSide, SquareSide), Placement);
+	CompositeNanosecondsPerPixel = ElapsedSince(StartTime) * 1.0e9 / FMath::Max(1, SquareSide * SquareSide);
+
+	const int32 NumBlendPixels = FMath::Min(NumPixels, MaxBlendBenchmarkPixels);
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumBlendPixels; ++Index)
+	{
+		Canvas[Index] = MinimapImageKernels::FeatherBlend(Canvas[Index], Pixels[Index], 0.5f);
+	}
+	BlendNanosecondsPerPixel = ElapsedSince(StartTime) * 1.0e9 / NumBlendPixels;
+}
+
+FMinimapCaptureEstimate FMinimapCaptureEstimate::Predict(const FMinimapCaptureSettings& InSettings, const FMinimapCaptureCalibration& InCalibration,
+                                                         const int64 InRamBudgetBytes, const int64 InVramBudgetBytes)
+{
+	using namespace MinimapCaptureEstimate;
+
+	FMinimapCaptureEstimate Estimate;
+	Estimate.Calibration = InCalibration;
+	Estimate.RamBudgetBytes = InRamBudgetBytes;
+	Estimate.VramBudgetBytes = InVramBudgetBytes;
+
+	if (InSettings.OutputWidth <= 0 || InSettings.OutputHeight <= 0)
+	{
+		Estimate.Error = TEXT("Invalid output size.");
+		return Estimate;
+	}
+
+	const FMinimapCaptureCalibration& Calibration = InCalibration;
+	const int64 OutputPixels = static_cast<int64>(InSettings.OutputWidth) * InSettings.OutputHeight;
+	const double OutputMegapixels = OutputPixels / 1000000.0;
+	const int64 CanvasBytes = OutputPixels * BytesPerPixel;
+	const int64 PngBytes = static_cast<int64>(OutputPixels * Calibration.PngBytesPerPixel);
+	const bool bImportsTexture = InSettings.bImportAsTextureAsset || InSettings.bExportDefinitionAsset;
+
+	int64 CaptureStageRam = 0;
+	int64 StitchStageRam = 0;
+	int64 LargestTargetPixels = OutputPixels;
+	int64 RenderTargetBytes = CanvasBytes;
+
+	if (InSettings.bUseTiling)
+	{
+		const FMinimapTileLayout Layout = UMinimapGeneratorManager::MakeTileLayout(InSettings);
+		if (!Layout.IsValid())
+		{
+			Estimate.Error = TEXT("Invalid tiling settings.");
+			return Estimate;
+		}
+
+		Estimate.TileLayoutSummary = Layout.ToString();
+		Estimate.NumTiles = Layout.GetNumTiles();
+		const bool bSkipsEmptyTiles = InSettings.bSkipEmptyTiles && InSettings.bIsOrthographic;
+		Estimate.NumRenderedTiles = FMath::Max(0, Estimate.NumTiles - (bSkipsEmptyTiles ? Calibration.NumEmptyTiles : 0));
+
+		// Empty tiles can be anywhere in the grid, so scale the rendered pixels by the fraction of tiles rendered.
+		const int64 RenderedPixels = Layout.GetRenderedPixelCount() * Estimate.NumRenderedTiles / Estimate.NumTiles;
+		const double RenderedMegapixels = RenderedPixels / 1000000.0;
+		const int64 TilePixels = static_cast<int64>(Layout.TileSize.X) * Layout.TileSize.Y;
+		LargestTargetPixels = TilePixels;
+
+		// Render targets are pooled by size: full tiles, last column, last row and the corner.
+		TSet<FIntPoint> TargetSizes;
+		for (const int32 Width : {Layout.TileSize.X, Layout.EdgeTileSize.X})
+		{
+			for (const int32 Height : {Layout.TileSize.Y, Layout.EdgeTileSize.Y})
+			{
+				TargetSizes.Add(FIntPoint(Width, Height));
+			}
+		}
+		RenderTargetBytes = 0;
+		for (const FIntPoint& TargetSize : TargetSizes)
+		{
+			RenderTargetBytes += static_cast<int64>(TargetSize.X) * TargetSize.Y * BytesPerPixel;
+		}
+
+		Estimate.CaptureSeconds = Estimate.NumRenderedTiles * (MinimapCapture::TileReadbackDelaySeconds + Calibration.CaptureFixedSeconds) +
+			RenderedMegapixels * Calibration.CaptureSecondsPerMegapixel;
+
+		if (InSettings.bSaveTiles)
+		{
+			// Debug tiles are encoded on the thread pool while the next tiles render; they only cost time once they fall behind.
+			const int32 NumWorkers = FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+			const double DebugEncodeSeconds = Calibration.PngEncodeMegapixelsPerSecond > 0.0
+				                                  ? RenderedMegapixels / (Calibration.PngEncodeMegapixelsPerSecond * NumWorkers)
+				                                  : 0.0;
+			Estimate.CaptureSeconds = FMath::Max(Estimate.CaptureSeconds, DebugEncodeSeconds);
+			Estimate.DebugTileBytes = static_cast<int64>(RenderedPixels * Calibration.PngBytesPerPixel);
+		}
+
+		// Mirrors StartStitching: a background fill, then either row copies or the per-pixel feather loop for each tile.
+		const bool bRowCopy = Layout.Overlap == 0 && InSettings.OutputWidth >= InSettings.OutputHeight;
+		const int64 BlendedPixels = Layout.Overlap > 0 ? FMath::Max<int64>(0, RenderedPixels - OutputPixels) : 0;
+		const double CompositeNanoseconds = bRowCopy
+			                                    ? RenderedPixels * Calibration.CopyNanosecondsPerPixel
+			                                    : (RenderedPixels - BlendedPixels) * Calibration.CompositeNanosecondsPerPixel +
+			                                    BlendedPixels * Calibration.BlendNanosecondsPerPixel;
+		const double UnpackNanoseconds = RenderedPixels * (InSettings.bCompressTilesInMemory
+			                                                   ? Calibration.TileDecompressNanosecondsPerPixel
+			                                                   : Calibration.CopyNanosecondsPerPixel);
+		Estimate.StitchSeconds = (OutputPixels * Calibration.CopyNanosecondsPerPixel + CompositeNanoseconds + UnpackNanoseconds) * 1.0e-9;
+
+		const double StoreRatio = InSettings.bCompressTilesInMemory ? FMath::Max(1.0, Calibration.TileStoreCompressionRatio) : 1.0;
+		const int64 StoreBytes = static_cast<int64>(RenderedPixels * BytesPerPixel / StoreRatio);
+
+		// Capturing: the growing tile store, the tile being read back and the copy handed to the debug tile task.
+		CaptureStageRam = StoreBytes + TilePixels * BytesPerPixel * (InSettings.bSaveTiles ? 2 : 1);
+		// Stitching: the canvas, the complete store and the scratch tile it is unpacked into.
+		StitchStageRam = CanvasBytes + StoreBytes + TilePixels * BytesPerPixel;
+	}
+	else
+	{
+		Estimate.NumTiles = 1;
+		Estimate.NumRenderedTiles = 1;
+		Estimate.TileLayoutSummary = FString::Printf(TEXT("Single %dx%d capture"), InSettings.OutputWidth, InSettings.OutputHeight);
+
+		// One capture, then the readback fence is polled every 0.1s.
+		Estimate.CaptureSeconds = Calibration.CaptureFixedSeconds + OutputMegapixels * Calibration.CaptureSecondsPerMegapixel + 0.1;
+		CaptureStageRam = CanvasBytes;
+	}
+
+	Estimate.EncodeSeconds = Calibration.PngEncodeMegapixelsPerSecond > 0.0 ? OutputMegapixels / Calibration.PngEncodeMegapixelsPerSecond : 0.0;
+	if (bImportsTexture)
+	{
+		Estimate.ImportSeconds = (Calibration.PngDecodeMegapixelsPerSecond > 0.0 ? OutputMegapixels / Calibration.PngDecodeMegapixelsPerSecond : 0.0) +
+			OutputPixels * Calibration.CopyNanosecondsPerPixel * 1.0e-9;
+	}
+	Estimate.TotalSeconds = Estimate.CaptureSeconds + Estimate.StitchSeconds + Estimate.EncodeSeconds + Estimate.ImportSeconds;
+
+	// Encoding: the pixels moved into the save task, the image wrapper's raw copy and the compressed PNG.
+	const int64 EncodeStageRam = 2 * CanvasBytes + PngBytes;
+	// Import: the PNG file and the wrapper's copy of it, the decoded image, the BGRA copy and the texture source.
+	const int64 ImportStageRam = bImportsTexture ? 2 * PngBytes + 3 * CanvasBytes : 0;
+
+	const TPair<const TCHAR*, int64> Stages[] = {
+		{TEXT("capture"), CaptureStageRam},
+		{TEXT("stitch"), StitchStageRam},
+		{TEXT("encode"), EncodeStageRam},
+		{TEXT("import"), ImportStageRam},
+	};
+	for (const TPair<const TCHAR*, int64>& Stage : Stages)
+	{
+		if (Stage.Value > Estimate.PeakRamBytes)
+		{
+			Estimate.PeakRamBytes = Stage.Value;
+			Estimate.PeakRamStage = Stage.Key;
+		}
+	}
+
+	Estimate.PeakVramBytes = RenderTargetBytes + LargestTargetPixels * SceneTextureBytesPerPixel;
+
+	Estimate.FinalImageBytes = PngBytes;
+	// The imported texture keeps its source in the package, compressed to roughly the size of the PNG.
+	Estimate.AssetBytes = bImportsTexture ? PngBytes : 0;
+	Estimate.TotalDiskBytes = Estimate.FinalImageBytes + Estimate.DebugTileBytes + Estimate.AssetBytes;
+
+	Estimate.bIsValid = true;
+	return Estimate;
+}
+
+void FMinimapCaptureEstimate::AddRecommendations(const FMinimapCaptureSettings& InSettings)
+{
+	using namespace MinimapCaptureEstimate;
+
+	Recommendations.Reset();
+	if (!bIsValid)
+	{
+		return;
+	}
+
+	auto Repredict = [this](const FMinimapCaptureSettings& TweakedSettings)
+	{
+		return Predict(TweakedSettings, Calibration, RamBudgetBytes, VramBudgetBytes);
+	};
+
+	const int32 MaxTextureSize = static_cast<int32>(GetMax2DTextureDimension());
+
+	if (!InSettings.bUseTiling && (FMath::Max(InSettings.OutputWidth, InSettings.OutputHeight) > MaxTextureSize || !FitsVramBudget()))
+	{
+		FMinimapCaptureSettings Tweaked = InSettings;
+		Tweaked.bUseTiling = true;
+		Tweaked.TileResolution = FMath::Min(Tweaked.TileResolution, MaxTextureSize);
+		if (const FMinimapCaptureEstimate Tiled = Repredict(Tweaked); Tiled.bIsValid)
+		{
+			Recommendations.Add(FString::Printf(TEXT("Enable tiled capture: peak VRAM drops from %s to %s."),
+				*FormatBytes(PeakVramBytes), *FormatBytes(Tiled.PeakVramBytes)));
+		}
+	}
+
+	if (InSettings.bUseTiling)
+	{
+		if (!FitsRamBudget() && !InSettings.bCompressTilesInMemory)
+		{
+			FMinimapCaptureSettings Tweaked = InSettings;
+			Tweaked.bCompressTilesInMemory = true;
+			Recommendations.Add(FString::Printf(TEXT("Enable Compress Tiles In Memory: peak RAM drops from %s to %s."),
+				*FormatBytes(PeakRamBytes), *FormatBytes(Repredict(Tweaked).PeakRamBytes)));
+		}
+
+		if (!FitsVramBudget())
+		{
+			FMinimapCaptureSettings Tweaked = InSettings;
+			for (int32 TileResolution = InSettings.TileResolution / 2; TileResolution >= 256; TileResolution /= 2)
+			{
+				Tweaked.TileResolution = TileResolution;
+				if (UMinimapGeneratorManager::GetEffectiveTileOverlap(Tweaked) >= TileResolution)
+				{
+					break;
+				}
+				if (const FMinimapCaptureEstimate Smaller = Repredict(Tweaked); Smaller.bIsValid && Smaller.FitsVramBudget())
+				{
+					Recommendations.Add(FString::Printf(TEXT("Lower Tile Resolution to %d: peak VRAM %s, %d tiles, about %s."),
+						TileResolution, *FormatBytes(Smaller.PeakVramBytes), Smaller.NumTiles, *FormatSeconds(Smaller.TotalSeconds)));
+					break;
+				}
+			}
+		}
+		else if (InSettings.TileResolution < MaxTextureSize && NumRenderedTiles * MinimapCapture::TileReadbackDelaySeconds > 0.5 * CaptureSeconds)
+		{
+			// Most of the capture is per-tile overhead: fewer, larger tiles finish sooner if they still fit.
+			FMinimapCaptureSettings Tweaked = InSettings;
+			Tweaked.TileResolution = FMath::Min(InSettings.TileResolution * 2, MaxTextureSize);
+			if (const FMinimapCaptureEstimate Larger = Repredict(Tweaked);
+				Larger.bIsValid && Larger.FitsVramBudget() && Larger.FitsRamBudget() && Larger.TotalSeconds < TotalSeconds * 0.9)
+			{
+				Recommendations.Add(FString::Printf(TEXT("Raise Tile Resolution to %d: %d tiles, about %s instead of %s."),
+					Tweaked.TileResolution, Larger.NumTiles, *FormatSeconds(Larger.TotalSeconds), *FormatSeconds(TotalSeconds)));
+			}
+		}
+
+		if (InSettings.bIsOrthographic && !InSettings.bSkipEmptyTiles && Calibration.NumEmptyTiles > 0)
+		{
+			Recommendations.Add(FString::Printf(TEXT("Enable Skip Empty Tiles: %d of %d tiles have nothing to render."),
+				Calibration.NumEmptyTiles, NumTiles));
+		}
+
+		if (InSettings.bSaveTiles && DebugTileBytes > 0)
+		{
+			Recommendations.Add(FString::Printf(TEXT("Disable Save Tiles unless debugging seams: saves %s of disk."), *FormatBytes(DebugTileBytes)));
+		}
+	}
+
+	if (!FitsRamBudget())
+	{
+		if (PeakRamStage == TEXT("import"))
+		{
+			FMinimapCaptureSettings Tweaked = InSettings;
+			Tweaked.bImportAsTextureAsset = false;
+			Tweaked.bExportDefinitionAsset = false;
+			Recommendations.Add(FString::Printf(TEXT("Texture import peaks at %s. Disable import and DataAsset export and import the PNG later: peak RAM %s."),
+				*FormatBytes(PeakRamBytes), *FormatBytes(Repredict(Tweaked).PeakRamBytes)));
+		}
+
+		// The canvas is held in memory whole, so past this point only a smaller output fits.
+		FMinimapCaptureSettings Tweaked = InSettings;
+		Tweaked.bCompressTilesInMemory = true;
+		for (int32 Halving = 0; Halving < MaxResolutionHalvings; ++Halving)
+		{
+			Tweaked.OutputWidth = FMath::Max(1, Tweaked.OutputWidth / 2);
+			Tweaked.OutputHeight = FMath::Max(1, Tweaked.OutputHeight / 2);
+			if (const FMinimapCaptureEstimate Smaller = Repredict(Tweaked); Smaller.bIsValid && Smaller.FitsRamBudget())
+			{
+				Recommendations.Add(FString::Printf(TEXT("Lower the output resolution to %dx%d: peak RAM %s."),
+					Tweaked.OutputWidth, Tweaked.OutputHeight, *FormatBytes(Smaller.PeakRamBytes)));
+				break;
+			}
+		}
+	}
+}
+
+FString FMinimapCaptureEstimate::ToString() const
+{
+	using namespace MinimapCaptureEstimate;
+
+	if (!bIsValid)
+	{
+		return FString::Printf(TEXT("Estimate unavailable: %s"), *Error);
+	}
+
+	FString Report;
+	Report += FString::Printf(TEXT("Layout: %s\n"), *TileLayoutSummary);
+	Report += FString::Printf(TEXT("Tiles rendered: %d of %d\n"), NumRenderedTiles, NumTiles);
+	Report += FString::Printf(TEXT("Time: about %s (capture %s, stitch %s, encode %s, import %s)\n"),
+		*FormatSeconds(TotalSeconds), *FormatSeconds(CaptureSeconds), *FormatSeconds(StitchSeconds),
+		*FormatSeconds(EncodeSeconds), *FormatSeconds(ImportSeconds));
+	Report += FString::Printf(TEXT("Peak RAM: %s during %s (budget %s)%s\n"), *FormatBytes(PeakRamBytes), *PeakRamStage,
+		RamBudgetBytes > 0 ? *FormatBytes(RamBudgetBytes) : TEXT("unlimited"), FitsRamBudget() ? TEXT("") : TEXT(" - OVER BUDGET"));
+	Report += FString::Printf(TEXT("Peak VRAM: %s (adapter %s)%s\n"), *FormatBytes(PeakVramBytes),
+		VramBudgetBytes > 0 ? *FormatBytes(VramBudgetBytes) : TEXT("unknown"), FitsVramBudget() ? TEXT("") : TEXT(" - OVER BUDGET"));
+	Report += FString::Printf(TEXT("Disk: %s (image %s, debug tiles %s, assets %s)\n"), *FormatBytes(TotalDiskBytes),
+		*FormatBytes(FinalImageBytes), *FormatBytes(DebugTileBytes), *FormatBytes(AssetBytes));
+	Report += FString::Printf(TEXT("Calibrated at %dx%d: %.1f ms + %.1f ms/MPix per capture, PNG %.1f MPix/s, tile store %.1f:1\n"),
+		Calibration.CalibrationSize.X, Calibration.CalibrationSize.Y, Calibration.CaptureFixedSeconds * 1000.0,
+		Calibration.CaptureSecondsPerMegapixel * 1000.0, Calibration.PngEncodeMegapixelsPerSecond, Calibration.TileStoreCompressionRatio);
+
+	if (Recommendations.Num() > 0)
+	{
+		Report += TEXT("Recommendations:\n");
+		for (const FString& Recommendation : Recommendations)
+		{
+			Report += FString::Printf(TEXT("- %s\n"), *Recommendation);
+		}
+	}
+	return Report;
+}
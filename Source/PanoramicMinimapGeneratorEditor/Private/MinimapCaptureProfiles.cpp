@@ -0,0 +1,200 @@
+#include "MinimapCaptureProfiles.h"
+#include "MinimapGeneratorManager.h"
+
+#include "Engine/Scene.h"
+#include "ShowFlags.h"
+
+namespace MinimapCaptureProfiles
+{
+	/**
+	 * Screen-space effects that depend on where a pixel sits in the frame or on the previous frame. Every tile is its
+	 * own frame, so they would show as seams at tile edges in every profile.
+	 */
+	static void DisableFrameEffects(FEngineShowFlags& Flags)
+	{
+		Flags.SetMotionBlur(false);
+		Flags.SetDepthOfField(false);
+		Flags.SetEyeAdaptation(false);
+		Flags.SetLocalExposure(false);
+		Flags.SetVignette(false);
+		Flags.SetGrain(false);
+		Flags.SetSceneColorFringe(false);
+		Flags.SetLensFlares(false);
+	}
+
+	/** Volumes and effects seen from the side; from far above they mostly add haze. */
+	static void DisableAtmosphericEffects(FEngineShowFlags& Flags)
+	{
+		Flags.SetFog(false);
+		Flags.SetVolumetricFog(false);
+		Flags.SetCloud(false);
+		Flags.SetLightShafts(false);
+		Flags.SetParticles(false);
+	}
+
+	static void DisableExpensiveLighting(FEngineShowFlags& Flags)
+	{
+		Flags.SetLumenGlobalIllumination(false);
+		Flags.SetLumenReflections(false);
+		Flags.SetDistanceFieldAO(false);
+		Flags.SetScreenSpaceReflections(false);
+		Flags.SetContactShadows(false);
+		Flags.SetCapsuleShadows(false);
+	}
+
+	/**
+	 * Temporal AA, TSR and motion blur smear pixels across tile borders from frame history. Pixel-aligned tiles have
+	 * no overlap to hide that in, so they are turned off in that mode whatever the profile.
+	 */
+	static void DisableTemporalEffectsForZeroOverlap(const FMinimapCaptureSettings& Settings, FEngineShowFlags& Flags)
+	{
+		if (UMinimapGeneratorManager::IsPixelAlignedTiling(Settings))
+		{
+			Flags.SetTemporalAA(false);
+			Flags.SetMotionBlur(false);
+		}
+	}
+}
+
+TConstArrayView<EMinimapCaptureProfile> MinimapCaptureProfiles::GetAll()
+{
+	static constexpr EMinimapCaptureProfile Profiles[] = {
+		EMinimapCaptureProfile::Schematic, EMinimapCaptureProfile::Fast, EMinimapCaptureProfile::Balanced,
+		EMinimapCaptureProfile::Cinematic, EMinimapCaptureProfile::Custom};
+	return Profiles;
+}
+
+FEngineShowFlags MinimapCaptureProfiles::MakeShowFlags(const FMinimapCaptureSettings& Settings, const FEngineShowFlags& Defaults)
+{
+	FEngineShowFlags Flags = Defaults;
+	if (Settings.CaptureProfile == EMinimapCaptureProfile::Custom)
+	{
+		Flags.SetDynamicShadows(Settings.bCaptureDynamicShadows);
+		DisableTemporalEffectsForZeroOverlap(Settings, Flags);
+		return Flags;
+	}
+
+	DisableFrameEffects(Flags);
+	DisableTemporalEffectsForZeroOverlap(Settings, Flags);
+	switch (Settings.CaptureProfile)
+	{
+	case EMinimapCaptureProfile::Schematic:
+		DisableAtmosphericEffects(Flags);
+		DisableExpensiveLighting(Flags);
+		// Unlit: the renderer outputs base colors, so no light, shadow or sky feature contributes.
+		Flags.SetLighting(false);
+		Flags.SetDynamicShadows(false);
+		Flags.SetAmbientOcclusion(false);
+		Flags.SetGlobalIllumination(false);
+		Flags.SetSkyLighting(false);
+		Flags.SetAtmosphere(false);
+		Flags.SetTranslucency(false);
+		Flags.SetBloom(false);
+		Flags.SetPostProcessMaterial(false);
+		break;
+
+	case EMinimapCaptureProfile::Fast:
+		DisableAtmosphericEffects(Flags);
+		DisableExpensiveLighting(Flags);
+		Flags.SetDynamicShadows(false);
+		Flags.SetAmbientOcclusion(false);
+		Flags.SetGlobalIllumination(false);
+		Flags.SetAtmosphere(false);
+		Flags.SetTranslucency(false);
+		Flags.SetBloom(false);
+		break;
+
+	case EMinimapCaptureProfile::Balanced:
+		DisableAtmosphericEffects(Flags);
+		DisableExpensiveLighting(Flags);
+		Flags.SetDynamicShadows(true);
+		Flags.SetBloom(false);
+		break;
+
+	case EMinimapCaptureProfile::Cinematic:
+		Flags.SetDynamicShadows(true);
+		break;
+
+	default:
+		break;
+	}
+	return Flags;
+}
+
+void MinimapCaptureProfiles::ApplyPostProcessOverrides(const FMinimapCaptureSettings& Settings, FPostProcessSettings& OutPostProcess)
+{
+	auto ApplyQualityOverrides = [&Settings, &OutPostProcess]
+	{
+		OutPostProcess.bOverride_AmbientOcclusionIntensity = true;
+		OutPostProcess.AmbientOcclusionIntensity = Settings.AmbientOcclusionIntensity;
+		OutPostProcess.bOverride_AmbientOcclusionQuality = true;
+		OutPostProcess.AmbientOcclusionQuality = Settings.AmbientOcclusionQuality;
+		OutPostProcess.bOverride_ScreenSpaceReflectionIntensity = true;
+		OutPostProcess.ScreenSpaceReflectionIntensity = Settings.ScreenSpaceReflectionIntensity;
+		OutPostProcess.bOverride_ScreenSpaceReflectionQuality = true;
+		OutPostProcess.ScreenSpaceReflectionQuality = Settings.ScreenSpaceReflectionQuality;
+	};
+
+	if (Settings.CaptureProfile == EMinimapCaptureProfile::Custom)
+	{
+		if (Settings.bOverrideWithHighQualitySettings)
+		{
+			ApplyQualityOverrides();
+		}
+		if (UMinimapGeneratorManager::IsPixelAlignedTiling(Settings))
+		{
+			OutPostProcess.bOverride_MotionBlurAmount = true;
+			OutPostProcess.MotionBlurAmount = 0.0f;
+		}
+		return;
+	}
+
+	// Post-process volumes in the level can turn the frame effects back on; the show flags do not cover all of them.
+	OutPostProcess.bOverride_MotionBlurAmount = true;
+	OutPostProcess.MotionBlurAmount = 0.0f;
+	OutPostProcess.bOverride_VignetteIntensity = true;
+	OutPostProcess.VignetteIntensity = 0.0f;
+	OutPostProcess.bOverride_FilmGrainIntensity = true;
+	OutPostProcess.FilmGrainIntensity = 0.0f;
+	OutPostProcess.bOverride_SceneFringeIntensity = true;
+	OutPostProcess.SceneFringeIntensity = 0.0f;
+	OutPostProcess.bOverride_LensFlareIntensity = true;
+	OutPostProcess.LensFlareIntensity = 0.0f;
+
+	switch (Settings.CaptureProfile)
+	{
+	case EMinimapCaptureProfile::Schematic:
+	case EMinimapCaptureProfile::Fast:
+		OutPostProcess.bOverride_BloomIntensity = true;
+		OutPostProcess.BloomIntensity = 0.0f;
+		OutPostProcess.bOverride_AmbientOcclusionIntensity = true;
+		OutPostProcess.AmbientOcclusionIntensity = 0.0f;
+		break;
+
+	case EMinimapCaptureProfile::Balanced:
+		OutPostProcess.bOverride_BloomIntensity = true;
+		OutPostProcess.BloomIntensity = 0.0f;
+		OutPostProcess.bOverride_AmbientOcclusionQuality = true;
+		OutPostProcess.AmbientOcclusionQuality = 50.0f;
+		OutPostProcess.bOverride_ScreenSpaceReflectionIntensity = true;
+		OutPostProcess.ScreenSpaceReflectionIntensity = 0.0f;
+		break;
+
+	case EMinimapCaptureProfile::Cinematic:
+		ApplyQualityOverrides();
+		break;
+
+	default:
+		break;
+	}
+}
+
+FString FMinimapCaptureProfileCost::ToString() const
+{
+	const FString ProfileName = UEnum::GetDisplayValueAsText(Profile).ToString();
+	if (GpuMillisecondsPerTile >= 0.0)
+	{
+		return FString::Printf(TEXT("%s: %.1f ms GPU per tile"), *ProfileName, GpuMillisecondsPerTile);
+	}
+	return FString::Printf(TEXT("%s: %.1f ms per tile"), *ProfileName, WallMillisecondsPerTile);
+}
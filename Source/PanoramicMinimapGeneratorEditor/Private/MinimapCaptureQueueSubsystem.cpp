@@ -0,0 +1,367 @@
+#include "MinimapCaptureQueueSubsystem.h"
+#include "PanoramicMinimapGeneratorEditor.h"
+
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "Misc/PackageName.h"
+#include "TimerManager.h"
+
+namespace MinimapCaptureQueue
+{
+	/**
+	 * Captures that may still be encoding or importing while the next one renders. Each one holds its full-resolution
+	 * canvas until it is encoded, so deeper pipelining would only add memory.
+	 */
+	constexpr int32 MaxFinalizingJobs = 1;
+
+	/** Area shared by two capture regions on the ground plane. */
+	static double GetOverlapArea(const FBox& A, const FBox& B)
+	{
+		const double Width = FMath::Min(A.Max.X, B.Max.X) - FMath::Max(A.Min.X, B.Min.X);
+		const double Height = FMath::Min(A.Max.Y, B.Max.Y) - FMath::Max(A.Min.Y, B.Min.Y);
+		return Width > 0.0 && Height > 0.0 ? Width * Height : 0.0;
+	}
+}
+
+void UMinimapCaptureQueueSubsystem::Deinitialize()
+{
+	CancelAll();
+	if (GEditor)
+	{
+		GEditor->GetTimerManager()->ClearAllTimersForObject(this);
+	}
+	Super::Deinitialize();
+}
+
+void UMinimapCaptureQueueSubsystem::EnqueueJobs(const TArray<FMinimapCaptureJob>& InJobs)
+{
+	if (InJobs.Num() == 0)
+	{
+		return;
+	}
+
+	if (!bIsRunning)
+	{
+		Jobs.Reset();
+		JobStates.Reset();
+		NextJobIndex = 0;
+		NumSucceeded = 0;
+		NumFailed = 0;
+		QueueStartSeconds = FPlatformTime::Seconds();
+	}
+
+	TArray<FMinimapCaptureJob> NewJobs = InJobs;
+	SortJobs(NewJobs);
+	for (FMinimapCaptureJob& Job : NewJobs)
+	{
+		FJobState& State = JobStates.AddDefaulted_GetRef();
+		State.NumPixels = static_cast<int64>(Job.Settings.OutputWidth) * Job.Settings.OutputHeight;
+		Jobs.Add(MoveTemp(Job));
+	}
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Queued %d minimap capture job(s); %d waiting."), InJobs.Num(), Jobs.Num() - NextJobIndex);
+
+	if (!bIsRunning)
+	{
+		bIsRunning = true;
+		ScheduleNextJob();
+	}
+}
+
+void UMinimapCaptureQueueSubsystem::CancelAll()
+{
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Cancelling the minimap capture queue; dropping %d queued job(s)."), Jobs.Num() - NextJobIndex);
+	const int32 NumJobs = Jobs.Num();
+	for (int32 JobIndex = NextJobIndex; JobIndex < NumJobs; ++JobIndex)
+	{
+		CompleteJob(JobIndex, false, TEXT("Cancelled."));
+	}
+	NextJobIndex = NumJobs;
+
+	if (RenderingManager)
+	{
+		RenderingManager->CancelCapture();
+	}
+	ScheduleNextJob();
+}
+
+void UMinimapCaptureQueueSubsystem::SortJobs(TArray<FMinimapCaptureJob>& InOutJobs)
+{
+	TArray<FSoftObjectPath> Levels;
+	for (const FMinimapCaptureJob& Job : InOutJobs)
+	{
+		Levels.AddUnique(Job.Level.ToSoftObjectPath());
+	}
+
+	TArray<FMinimapCaptureJob> SortedJobs;
+	SortedJobs.Reserve(InOutJobs.Num());
+	for (const FSoftObjectPath& Level : Levels)
+	{
+		TArray<int32> Remaining;
+		for (int32 JobIndex = 0; JobIndex < InOutJobs.Num(); ++JobIndex)
+		{
+			if (InOutJobs[JobIndex].Level.ToSoftObjectPath() == Level)
+			{
+				Remaining.Add(JobIndex);
+			}
+		}
+
+		// From each job, go on to the one sharing the most ground with it, or to the nearest one when none does.
+		int32 Current = Remaining[0];
+		Remaining.RemoveAt(0);
+		SortedJobs.Add(InOutJobs[Current]);
+		while (Remaining.Num() > 0)
+		{
+			const FBox& From = InOutJobs[Current].Settings.CaptureBounds;
+			int32 BestSlot = 0;
+			double BestOverlap = -1.0;
+			double BestDistanceSq = TNumericLimits<double>::Max();
+			for (int32 Slot = 0; Slot < Remaining.Num(); ++Slot)
+			{
+				const FBox& To = InOutJobs[Remaining[Slot]].Settings.CaptureBounds;
+				const double Overlap = MinimapCaptureQueue::GetOverlapArea(From, To);
+				const double DistanceSq = FVector2D::DistSquared(FVector2D(From.GetCenter()), FVector2D(To.GetCenter()));
+				if (Overlap > BestOverlap || (Overlap == BestOverlap && DistanceSq < BestDistanceSq))
+				{
+					BestSlot = Slot;
+					BestOverlap = Overlap;
+					BestDistanceSq = DistanceSq;
+				}
+			}
+			Current = Remaining[BestSlot];
+			Remaining.RemoveAt(BestSlot);
+			SortedJobs.Add(InOutJobs[Current]);
+		}
+	}
+	InOutJobs = MoveTemp(SortedJobs);
+}
+
+void UMinimapCaptureQueueSubsystem::ScheduleNextJob()
+{
+	// Never start a capture from inside another capture's callbacks.
+	if (GEditor)
+	{
+		GEditor->GetTimerManager()->SetTimerForNextTick(this, &UMinimapCaptureQueueSubsystem::StartNextJob);
+	}
+}
+
+void UMinimapCaptureQueueSubsystem::StartNextJob()
+{
+	if (!bIsRunning || RenderingManager)
+	{
+		return;
+	}
+
+	if (NextJobIndex >= Jobs.Num())
+	{
+		if (FinalizingManagers.Num() == 0)
+		{
+			FinishQueue();
+		}
+		return;
+	}
+
+	// One job renders while up to MaxFinalizingJobs earlier ones encode and import.
+	if (FinalizingManagers.Num() > MinimapCaptureQueue::MaxFinalizingJobs)
+	{
+		return;
+	}
+
+	const int32 JobIndex = NextJobIndex;
+	if (!IsJobLevelOpen(Jobs[JobIndex]))
+	{
+		// Opening a level collects garbage and tears down the world; let the previous job finish importing first.
+		if (FinalizingManagers.Num() > 0)
+		{
+			return;
+		}
+
+		if (FString Error; !OpenJobLevel(Jobs[JobIndex], Error))
+		{
+			NextJobIndex++;
+			CompleteJob(JobIndex, false, Error);
+			ScheduleNextJob();
+			return;
+		}
+	}
+	NextJobIndex++;
+
+	UMinimapGeneratorManager* Manager = AcquireManager();
+	RenderingManager = Manager;
+	Manager->OnProgress.AddUObject(this, &UMinimapCaptureQueueSubsystem::HandleJobProgress, JobIndex);
+	Manager->OnRenderComplete.AddUObject(this, &UMinimapCaptureQueueSubsystem::HandleJobRenderComplete, JobIndex, Manager);
+	Manager->OnCaptureComplete.AddUObject(this, &UMinimapCaptureQueueSubsystem::HandleJobComplete, JobIndex, Manager);
+
+	const FMinimapCaptureSettings& JobSettings = Jobs[JobIndex].Settings;
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Starting minimap capture job %d/%d: %s (%dx%d)."), JobIndex + 1, Jobs.Num(),
+		*JobSettings.FileName, JobSettings.OutputWidth, JobSettings.OutputHeight);
+	Manager->StartCaptureProcess(JobSettings);
+}
+
+bool UMinimapCaptureQueueSubsystem::IsJobLevelOpen(const FMinimapCaptureJob& Job) const
+{
+	if (Job.Level.IsNull())
+	{
+		return true;
+	}
+	const UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	return World && World->GetPackage()->GetName() == Job.Level.GetLongPackageName();
+}
+
+bool UMinimapCaptureQueueSubsystem::OpenJobLevel(const FMinimapCaptureJob& Job, FString& OutError)
+{
+	const FString LevelName = Job.Level.GetLongPackageName();
+	if (const UWorld* World = GEditor->GetEditorWorldContext().World(); World && World->GetPackage()->IsDirty())
+	{
+		OutError = FString::Printf(TEXT("%s has unsaved changes. Save it before the queue opens %s."), *World->GetName(), *LevelName);
+		return false;
+	}
+
+	// The retained capture actors live in the level being closed.
+	for (UMinimapGeneratorManager* Manager : Managers)
+	{
+		Manager->ReleaseRetainedCaptureResources();
+	}
+
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Opening %s for the next minimap capture."), *LevelName);
+	const FString Filename = FPackageName::LongPackageNameToFilename(LevelName, FPackageName::GetMapPackageExtension());
+	if (!UEditorLoadingAndSavingUtils::LoadMap(Filename))
+	{
+		OutError = FString::Printf(TEXT("Failed to open %s."), *LevelName);
+		return false;
+	}
+	return true;
+}
+
+UMinimapGeneratorManager* UMinimapCaptureQueueSubsystem::AcquireManager()
+{
+	UMinimapGeneratorManager* Manager = nullptr;
+	for (UMinimapGeneratorManager* Candidate : Managers)
+	{
+		if (Candidate != RenderingManager && !FinalizingManagers.Contains(Candidate))
+		{
+			Manager = Candidate;
+			break;
+		}
+	}
+
+	if (!Manager)
+	{
+		Manager = NewObject<UMinimapGeneratorManager>(this);
+		Manager->SetRetainCaptureResources(true);
+		Managers.Add(Manager);
+	}
+
+	// The previous job may have rendered on another manager, which no longer needs its actor and render targets.
+	for (UMinimapGeneratorManager* Other : Managers)
+	{
+		Manager->AdoptCaptureResources(*Other);
+	}
+	return Manager;
+}
+
+void UMinimapCaptureQueueSubsystem::HandleJobProgress(const FText& Status, const float Percentage, int32 CurrentTile, int32 TotalTiles,
+                                                      const int32 JobIndex)
+{
+	JobStates[JobIndex].Progress = FMath::Clamp(Percentage, 0.0f, 1.0f);
+	BroadcastProgress(FText::Format(FText::FromString(TEXT("Job {0}/{1} ({2}): {3}")), FText::AsNumber(JobIndex + 1),
+	                                FText::AsNumber(Jobs.Num()), FText::FromString(Jobs[JobIndex].Settings.FileName), Status));
+}
+
+void UMinimapCaptureQueueSubsystem::HandleJobRenderComplete(const int32 JobIndex, UMinimapGeneratorManager* Manager)
+{
+	if (RenderingManager == Manager)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Minimap capture job %d/%d rendered; encoding it while the next job renders."),
+			JobIndex + 1, Jobs.Num());
+		RenderingManager = nullptr;
+		FinalizingManagers.Add(Manager);
+	}
+	ScheduleNextJob();
+}
+
+void UMinimapCaptureQueueSubsystem::HandleJobComplete(const bool bSuccess, const FString& FinalImagePath, const int32 JobIndex,
+                                                      UMinimapGeneratorManager* Manager)
+{
+	if (RenderingManager == Manager)
+	{
+		RenderingManager = nullptr;
+	}
+	FinalizingManagers.Remove(Manager);
+	Manager->OnProgress.RemoveAll(this);
+	Manager->OnRenderComplete.RemoveAll(this);
+	Manager->OnCaptureComplete.RemoveAll(this);
+
+	if (!bSuccess)
+	{
+		// A failed capture can stop anywhere, holding its actor and tile source; retire the manager rather than reuse it.
+		Managers.Remove(Manager);
+		GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(Manager, [Manager]
+		{
+			Manager->ShutdownCapture(false);
+			Manager->ReleaseRetainedCaptureResources();
+		}));
+	}
+
+	CompleteJob(JobIndex, bSuccess, FinalImagePath);
+	ScheduleNextJob();
+}
+
+void UMinimapCaptureQueueSubsystem::CompleteJob(const int32 JobIndex, const bool bSuccess, const FString& FinalImagePath)
+{
+	FJobState& State = JobStates[JobIndex];
+	if (State.bDone)
+	{
+		return;
+	}
+	State.bDone = true;
+	State.Progress = 1.0f;
+
+	if (bSuccess)
+	{
+		NumSucceeded++;
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Minimap capture job %d/%d finished: %s"), JobIndex + 1, Jobs.Num(), *FinalImagePath);
+	}
+	else
+	{
+		NumFailed++;
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Minimap capture job %d/%d (%s) failed: %s"), JobIndex + 1, Jobs.Num(),
+			*Jobs[JobIndex].Settings.FileName, *FinalImagePath);
+	}
+
+	OnJobComplete.Broadcast(Jobs[JobIndex], bSuccess, FinalImagePath);
+	BroadcastProgress(FText::Format(FText::FromString(TEXT("Finished {0} of {1} jobs.")), FText::AsNumber(NumSucceeded + NumFailed),
+	                                FText::AsNumber(Jobs.Num())));
+}
+
+void UMinimapCaptureQueueSubsystem::BroadcastProgress(const FText& Status)
+{
+	// Weighted by output pixels, so a 16k region moves the bar more than a 1k floor plan.
+	int64 TotalPixels = 0;
+	double DonePixels = 0.0;
+	for (const FJobState& State : JobStates)
+	{
+		TotalPixels += State.NumPixels;
+		DonePixels += State.Progress * State.NumPixels;
+	}
+	const float Percentage = TotalPixels > 0 ? static_cast<float>(DonePixels / TotalPixels) : 0.0f;
+	OnProgress.Broadcast(Status, Percentage, NumSucceeded + NumFailed, Jobs.Num());
+}
+
+void UMinimapCaptureQueueSubsystem::FinishQueue()
+{
+	bIsRunning = false;
+	for (UMinimapGeneratorManager* Manager : Managers)
+	{
+		Manager->ReleaseRetainedCaptureResources();
+	}
+	Managers.Empty();
+
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Minimap capture queue finished in %.1fs: %d succeeded, %d failed."),
+		FPlatformTime::Seconds() - QueueStartSeconds, NumSucceeded, NumFailed);
+	OnQueueComplete.Broadcast(NumSucceeded, NumFailed);
+}
@@ -0,0 +1,236 @@
+#include "MinimapCaptureReport.h"
+#include "MinimapGeneratorManager.h"
+#include "MinimapMemoryTracking.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace MinimapCaptureReport
+{
+	/** Slowest tiles listed by name in the report so pathological tiles stand out without reading every entry. */
+	constexpr int32 NumSlowestTiles = 10;
+
+	static TSharedRef<FJsonObject> MakeDistribution(const TArray<double>& Seconds)
+	{
+		double Sum = 0.0;
+		double Max = 0.0;
+		for (const double Value : Seconds)
+		{
+			Sum += Value;
+			Max = FMath::Max(Max, Value);
+		}
+
+		TSharedRef<FJsonObject> Distribution = MakeShared<FJsonObject>();
+		Distribution->SetNumberField(TEXT("count"), Seconds.Num());
+		Distribution->SetNumberField(TEXT("meanMs"), Seconds.Num() > 0 ? Sum / Seconds.Num() * 1000.0 : 0.0);
+		Distribution->SetNumberField(TEXT("p50Ms"), FMinimapCaptureReport::Percentile(Seconds, 50.0) * 1000.0);
+		Distribution->SetNumberField(TEXT("p90Ms"), FMinimapCaptureReport::Percentile(Seconds, 90.0) * 1000.0);
+		Distribution->SetNumberField(TEXT("p99Ms"), FMinimapCaptureReport::Percentile(Seconds, 99.0) * 1000.0);
+		Distribution->SetNumberField(TEXT("maxMs"), Max * 1000.0);
+		return Distribution;
+	}
+
+	static TSharedRef<FJsonObject> MakeTileObject(const FMinimapTileStats& Tile)
+	{
+		TSharedRef<FJsonObject> TileObject = MakeShared<FJsonObject>();
+		TileObject->SetNumberField(TEXT("index"), Tile.TileIndex);
+		TileObject->SetNumberField(TEXT("x"), Tile.TileCoord.X);
+		TileObject->SetNumberField(TEXT("y"), Tile.TileCoord.Y);
+		TileObject->SetNumberField(TEXT("width"), Tile.Size.X);
+		TileObject->SetNumberField(TEXT("height"), Tile.Size.Y);
+		TileObject->SetBoolField(TEXT("skipped"), Tile.bSkipped);
+		TileObject->SetNumberField(TEXT("renderMs"), Tile.RenderSeconds * 1000.0);
+		TileObject->SetNumberField(TEXT("gpuRenderMs"), Tile.GpuRenderSeconds * 1000.0);
+		TileObject->SetNumberField(TEXT("streamingWaitMs"), Tile.StreamingWaitSeconds * 1000.0);
+		TileObject->SetNumberField(TEXT("readbackMs"), Tile.ReadbackSeconds * 1000.0);
+		TileObject->SetNumberField(TEXT("latencyMs"), Tile.LatencySeconds * 1000.0);
+		TileObject->SetNumberField(TEXT("frames"), Tile.FramesRendered);
+		return TileObject;
+	}
+}
+
+void FMinimapCaptureReport::Reset()
+{
+	*this = FMinimapCaptureReport();
+	StartTime = FDateTime::Now();
+	StartSeconds = FPlatformTime::Seconds();
+	MinimapMemory::ResetHighWater();
+	SampleMemory();
+}
+
+void FMinimapCaptureReport::AddStageSeconds(const TCHAR* Stage, const double Seconds)
+{
+	for (TPair<FString, double>& Entry : StageSeconds)
+	{
+		if (Entry.Key == Stage)
+		{
+			Entry.Value += Seconds;
+			return;
+		}
+	}
+	StageSeconds.Emplace(Stage, Seconds);
+}
+
+double FMinimapCaptureReport::GetStageSeconds(const TCHAR* Stage) const
+{
+	for (const TPair<FString, double>& Entry : StageSeconds)
+	{
+		if (Entry.Key == Stage)
+		{
+			return Entry.Value;
+		}
+	}
+	return 0.0;
+}
+
+void FMinimapCaptureReport::SampleMemory()
+{
+	PeakUsedPhysicalBytes = FMath::Max<uint64>(PeakUsedPhysicalBytes, FPlatformMemory::GetStats().UsedPhysical);
+	PeakTrackedBytes = MinimapMemory::GetHighWaterBytes();
+}
+
+double FMinimapCaptureReport::Percentile(TArray<double> Values, const double InPercentile)
+{
+	if (Values.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	Values.Sort();
+	const int32 Rank = FMath::CeilToInt32(FMath::Clamp(InPercentile, 0.0, 100.0) / 100.0 * Values.Num());
+	return Values[FMath::Clamp(Rank - 1, 0, Values.Num() - 1)];
+}
+
+FString FMinimapCaptureReport::WriteJson(const FString& ImagePath, const FMinimapCaptureSettings& Settings, const bool bSuccess) const
+{
+	using namespace MinimapCaptureReport;
+
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("OBPanoramicMinimapGenerator")))
+	{
+		Root->SetStringField(TEXT("pluginVersion"), Plugin->GetDescriptor().VersionName);
+	}
+	Root->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("startTime"), StartTime.ToIso8601());
+	Root->SetBoolField(TEXT("success"), bSuccess);
+	Root->SetStringField(TEXT("image"), ImagePath);
+
+	const TSharedRef<FJsonObject> SettingsObject = MakeShared<FJsonObject>();
+	SettingsObject->SetNumberField(TEXT("outputWidth"), Settings.OutputWidth);
+	SettingsObject->SetNumberField(TEXT("outputHeight"), Settings.OutputHeight);
+	SettingsObject->SetBoolField(TEXT("tiled"), Settings.bUseTiling);
+	SettingsObject->SetNumberField(TEXT("tileResolution"), Settings.TileResolution);
+	SettingsObject->SetNumberField(TEXT("tileOverlap"), UMinimapGeneratorManager::GetEffectiveTileOverlap(Settings));
+	SettingsObject->SetBoolField(TEXT("planTileLayout"), Settings.bPlanTileLayout);
+	SettingsObject->SetBoolField(TEXT("pixelAligned"), UMinimapGeneratorManager::IsPixelAlignedTiling(Settings));
+	SettingsObject->SetBoolField(TEXT("skipEmptyTiles"), Settings.bSkipEmptyTiles);
+	SettingsObject->SetBoolField(TEXT("compressTilesInMemory"), Settings.bCompressTilesInMemory);
+	SettingsObject->SetBoolField(TEXT("saveTiles"), Settings.bSaveTiles);
+	SettingsObject->SetBoolField(TEXT("orthographic"), Settings.bIsOrthographic);
+	SettingsObject->SetBoolField(TEXT("importAsTexture"), Settings.bImportAsTextureAsset);
+	SettingsObject->SetBoolField(TEXT("exportDefinitionAsset"), Settings.bExportDefinitionAsset);
+	SettingsObject->SetStringField(TEXT("tileLayout"), TileLayoutSummary);
+	SettingsObject->SetStringField(TEXT("tileSource"), TileSourceName);
+	Root->SetObjectField(TEXT("settings"), SettingsObject);
+
+	const TSharedRef<FJsonObject> StagesObject = MakeShared<FJsonObject>();
+	for (const TPair<FString, double>& Entry : StageSeconds)
+	{
+		StagesObject->SetNumberField(Entry.Key, Entry.Value);
+	}
+	Root->SetObjectField(TEXT("stageSeconds"), StagesObject);
+	Root->SetNumberField(TEXT("totalSeconds"), FPlatformTime::Seconds() - StartSeconds);
+
+	// Percentiles only cover tiles that were actually rendered; skipped tiles would drag them towards zero.
+	TArray<double> Latencies;
+	TArray<double> Readbacks;
+	TArray<double> GpuRenders;
+	TArray<double> StreamingWaits;
+	TArray<const FMinimapTileStats*> RenderedTiles;
+	int32 NumSkipped = 0;
+	int32 NumFrames = 0;
+	int32 MaxFrames = 0;
+	for (const FMinimapTileStats& Tile : Tiles)
+	{
+		if (Tile.bSkipped)
+		{
+			NumSkipped++;
+			continue;
+		}
+		Latencies.Add(Tile.LatencySeconds);
+		Readbacks.Add(Tile.ReadbackSeconds);
+		StreamingWaits.Add(Tile.StreamingWaitSeconds);
+		if (Tile.GpuRenderSeconds >= 0.0)
+		{
+			GpuRenders.Add(Tile.GpuRenderSeconds);
+		}
+		NumFrames += Tile.FramesRendered;
+		MaxFrames = FMath::Max(MaxFrames, Tile.FramesRendered);
+		RenderedTiles.Add(&Tile);
+	}
+	RenderedTiles.Sort([](const FMinimapTileStats& A, const FMinimapTileStats& B) { return A.LatencySeconds > B.LatencySeconds; });
+
+	const TSharedRef<FJsonObject> TilesObject = MakeShared<FJsonObject>();
+	TilesObject->SetNumberField(TEXT("rendered"), Latencies.Num());
+	TilesObject->SetNumberField(TEXT("skipped"), NumSkipped);
+	TilesObject->SetNumberField(TEXT("frames"), NumFrames);
+	TilesObject->SetNumberField(TEXT("maxFramesPerTile"), MaxFrames);
+	TilesObject->SetObjectField(TEXT("latency"), MakeDistribution(Latencies));
+	TilesObject->SetObjectField(TEXT("readback"), MakeDistribution(Readbacks));
+	TilesObject->SetObjectField(TEXT("gpuRender"), MakeDistribution(GpuRenders));
+	TilesObject->SetObjectField(TEXT("streamingWait"), MakeDistribution(StreamingWaits));
+
+	TArray<TSharedPtr<FJsonValue>> SlowestValues;
+	for (int32 Index = 0; Index < FMath::Min(NumSlowestTiles, RenderedTiles.Num()); ++Index)
+	{
+		SlowestValues.Add(MakeShared<FJsonValueObject>(MakeTileObject(*RenderedTiles[Index])));
+	}
+	TilesObject->SetArrayField(TEXT("slowest"), SlowestValues);
+
+	TArray<TSharedPtr<FJsonValue>> TileValues;
+	TileValues.Reserve(Tiles.Num());
+	for (const FMinimapTileStats& Tile : Tiles)
+	{
+		TileValues.Add(MakeShared<FJsonValueObject>(MakeTileObject(Tile)));
+	}
+	TilesObject->SetArrayField(TEXT("perTile"), TileValues);
+	Root->SetObjectField(TEXT("tiles"), TilesObject);
+
+	const TSharedRef<FJsonObject> BytesObject = MakeShared<FJsonObject>();
+	BytesObject->SetNumberField(TEXT("finalImage"), FinalImageBytes);
+	BytesObject->SetNumberField(TEXT("debugTiles"), DebugTileBytes);
+	BytesObject->SetNumberField(TEXT("totalWritten"), FinalImageBytes + DebugTileBytes);
+	BytesObject->SetNumberField(TEXT("tileStoreStored"), TileStoreStoredBytes);
+	BytesObject->SetNumberField(TEXT("tileStoreRaw"), TileStoreRawBytes);
+	Root->SetObjectField(TEXT("bytes"), BytesObject);
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	const TSharedRef<FJsonObject> MemoryObject = MakeShared<FJsonObject>();
+	MemoryObject->SetNumberField(TEXT("peakUsedPhysicalDuringCapture"), static_cast<double>(FMath::Max<uint64>(PeakUsedPhysicalBytes, MemoryStats.UsedPhysical)));
+	MemoryObject->SetNumberField(TEXT("processPeakUsedPhysical"), static_cast<double>(MemoryStats.PeakUsedPhysical));
+	MemoryObject->SetNumberField(TEXT("peakCaptureBuffers"), static_cast<double>(FMath::Max(PeakTrackedBytes, MinimapMemory::GetHighWaterBytes())));
+	const TSharedRef<FJsonObject> BufferPeaksObject = MakeShared<FJsonObject>();
+	for (int32 TagIndex = 0; TagIndex < static_cast<int32>(EMinimapMemoryTag::Num); ++TagIndex)
+	{
+		const EMinimapMemoryTag Tag = static_cast<EMinimapMemoryTag>(TagIndex);
+		BufferPeaksObject->SetNumberField(MinimapMemory::GetTagName(Tag), static_cast<double>(MinimapMemory::GetHighWaterBytes(Tag)));
+	}
+	MemoryObject->SetObjectField(TEXT("peakCaptureBuffersByTag"), BufferPeaksObject);
+	Root->SetObjectField(TEXT("memory"), MemoryObject);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	if (!FJsonSerializer::Serialize(Root, Writer))
+	{
+		return FString();
+	}
+
+	const FString ReportPath = FPaths::Combine(FPaths::GetPath(ImagePath), FPaths::GetBaseFilename(ImagePath) + TEXT("_report.json"));
+	return FFileHelper::SaveStringToFile(JsonText, *ReportPath) ? ReportPath : FString();
+}
@@ -0,0 +1,124 @@
+#include "MinimapCaptureShardCommandlet.h"
+#include "MinimapCaptureShards.h"
+#include "MinimapGeneratorManager.h"
+#include "MinimapGeneratorStats.h"
+#include "MinimapImageKernels.h"
+#include "MinimapTileSources.h"
+#include "PanoramicMinimapGeneratorEditor.h"
+
+#include "FileHelpers.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+UMinimapCaptureShardCommandlet::UMinimapCaptureShardCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMinimapCaptureShardCommandlet::Main(const FString& Params)
+{
+	FString ManifestPath;
+	FMinimapShardManifest Manifest;
+	if (!FParse::Value(*Params, TEXT("manifest="), ManifestPath) || !MinimapShards::ReadManifest(ManifestPath, Manifest))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Missing or unreadable -manifest=<FileName>_shards.json."));
+		return 1;
+	}
+
+	int32 ShardIndex = INDEX_NONE;
+	if (!FParse::Value(*Params, TEXT("shard="), ShardIndex) || ShardIndex < 0 || ShardIndex >= Manifest.GetNumShards())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("-shard= must be between 0 and %d."), Manifest.GetNumShards() - 1);
+		return 1;
+	}
+
+	if (!IsAllowCommandletRendering())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Capture workers render the level; pass -AllowCommandletRendering and no -nullrhi."));
+		return 1;
+	}
+
+	const FMinimapCaptureSettings& Settings = Manifest.Settings;
+	const FMinimapTileLayout Layout = UMinimapGeneratorManager::MakeTileLayout(Settings);
+	if (!Manifest.MatchesLayout(Layout))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("The manifest's grid does not match %s planned from its settings."), *Layout.ToString());
+		return 1;
+	}
+
+	const FString MapFilename = FPackageName::LongPackageNameToFilename(Manifest.MapPackage, FPackageName::GetMapPackageExtension());
+	if (!UEditorLoadingAndSavingUtils::LoadMap(MapFilename))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to load %s."), *Manifest.MapPackage);
+		return 1;
+	}
+
+	const int32 FirstTile = Manifest.ShardFirstTiles[ShardIndex];
+	const int32 EndTile = Manifest.ShardFirstTiles[ShardIndex + 1];
+	UE_LOG(OBPanoramicMinimapGenerator, Display, TEXT("Shard %d of %d: rendering tiles [%d, %d) of %s."), ShardIndex, Manifest.GetNumShards(),
+		FirstTile, EndTile, *Layout.ToString());
+
+	const FString IndexPath = FPaths::Combine(Manifest.TileDirectory, MinimapShards::GetIndexFileName(Settings.FileName, ShardIndex));
+	TArray<FMinimapShardTileRecord> Records;
+	if (!MinimapShards::WriteIndex(IndexPath, ShardIndex, Records))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to write %s"), *IndexPath);
+		return 1;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	UMinimapGeneratorManager* Manager = NewObject<UMinimapGeneratorManager>();
+	FString Error;
+	const bool bCaptured = Manager->CaptureTilesBlocking(Settings, FirstTile, EndTile,
+		[&](const int32 TileIndex, const TArray<FColor>& Pixels, const FIntPoint& Size)
+		{
+			TArray64<uint8> PngData;
+			{
+				MINIMAP_STAGE_SCOPE(STAT_MinimapEncode);
+				LLM_SCOPE_BYTAG(MinimapGenerator_ImageWrapperBuffers);
+				if (!MinimapImageKernels::EncodePng(Pixels, Size, PngData))
+				{
+					UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to encode tile %d."), TileIndex);
+					return false;
+				}
+			}
+
+			// The file is complete on disk before the index lists it, so the merge never reads a partial tile.
+			const FString TilePath = FPaths::Combine(Manifest.TileDirectory, GetSavedTileFileName(Settings.FileName, Layout.GetTileCoord(TileIndex)));
+			{
+				MINIMAP_STAGE_SCOPE(STAT_MinimapDiskWrite);
+				if (!FFileHelper::SaveArrayToFile(PngData, *TilePath))
+				{
+					UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to write %s"), *TilePath);
+					return false;
+				}
+			}
+
+			FMinimapShardTileRecord& Record = Records.AddDefaulted_GetRef();
+			Record.TileIndex = TileIndex;
+			Record.Size = Size;
+			Record.FileBytes = PngData.Num();
+			Record.FileCrc = FCrc::MemCrc32(PngData.GetData(), PngData.Num());
+			if (!MinimapShards::WriteIndex(IndexPath, ShardIndex, Records))
+			{
+				UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to write %s"), *IndexPath);
+				return false;
+			}
+			return true;
+		},
+		Error);
+
+	if (!bCaptured)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Shard %d failed after %d tiles: %s"), ShardIndex, Records.Num(), *Error);
+		return 1;
+	}
+
+	UE_LOG(OBPanoramicMinimapGenerator, Display, TEXT("Shard %d rendered %d of %d tiles in %.1fs."), ShardIndex, Records.Num(),
+		EndTile - FirstTile, FPlatformTime::Seconds() - StartTime);
+	return 0;
+}
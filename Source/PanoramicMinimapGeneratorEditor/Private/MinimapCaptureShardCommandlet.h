@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MinimapCaptureShardCommandlet.generated.h"
+
+/**
+ * Worker of a sharded capture. The editor launches one per shard on the same machine when Worker Processes is above 1:
+ *
+ *   UnrealEditor-Cmd <Project> -run=MinimapCaptureShard -manifest=<Dir>/<FileName>_shards.json -shard=<Index>
+ *       -AllowCommandletRendering -unattended
+ *
+ * Loads the manifest's level, renders the shard's tiles with the scene capture and writes each one to the shared
+ * folder as <FileName>_Tile_X_Y.png, then rewrites <FileName>_Shard_<Index>.idx to list it. The editor merges the
+ * tiles once every worker has exited. Returns a non-zero exit code when the shard could not be rendered.
+ */
+UCLASS()
+class UMinimapCaptureShardCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMinimapCaptureShardCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
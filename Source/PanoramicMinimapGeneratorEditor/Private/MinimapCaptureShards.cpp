@@ -0,0 +1,119 @@
+#include "MinimapCaptureShards.h"
+
+#include "HAL/FileManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace MinimapShards
+{
+	static constexpr uint32 IndexMagic = 0x4D4D5348; // "MMSH"
+	static constexpr int32 IndexVersion = 1;
+}
+
+void FMinimapShardManifest::SetLayout(const FMinimapTileLayout& Layout)
+{
+	OutputSize = Layout.OutputSize;
+	TileSize = Layout.TileSize;
+	EdgeTileSize = Layout.EdgeTileSize;
+	NumTiles = Layout.NumTiles;
+	Overlap = Layout.Overlap;
+}
+
+bool FMinimapShardManifest::MatchesLayout(const FMinimapTileLayout& Layout) const
+{
+	return OutputSize == Layout.OutputSize && TileSize == Layout.TileSize && EdgeTileSize == Layout.EdgeTileSize &&
+		NumTiles == Layout.NumTiles && Overlap == Layout.Overlap;
+}
+
+void FMinimapShardManifest::AssignShards(const FMinimapTileLayout& Layout, const int32 InNumShards)
+{
+	const int32 NumTilesTotal = Layout.GetNumTiles();
+	const int32 NumShards = FMath::Clamp(InNumShards, 1, FMath::Max(NumTilesTotal, 1));
+	const bool bSplitRows = NumShards <= Layout.NumTiles.Y;
+
+	ShardFirstTiles.SetNum(NumShards + 1);
+	for (int32 ShardIndex = 0; ShardIndex <= NumShards; ++ShardIndex)
+	{
+		ShardFirstTiles[ShardIndex] = bSplitRows
+			                              ? static_cast<int32>(static_cast<int64>(ShardIndex) * Layout.NumTiles.Y / NumShards) * Layout.NumTiles.X
+			                              : static_cast<int32>(static_cast<int64>(ShardIndex) * NumTilesTotal / NumShards);
+	}
+}
+
+FString MinimapShards::GetManifestFileName(const FString& BaseFileName)
+{
+	return BaseFileName + TEXT("_shards.json");
+}
+
+FString MinimapShards::GetIndexFileName(const FString& BaseFileName, const int32 ShardIndex)
+{
+	return FString::Printf(TEXT("%s_Shard_%d.idx"), *BaseFileName, ShardIndex);
+}
+
+bool MinimapShards::WriteManifest(const FMinimapShardManifest& Manifest, const FString& Path)
+{
+	FString JsonText;
+	return FJsonObjectConverter::UStructToJsonObjectString(Manifest, JsonText) && FFileHelper::SaveStringToFile(JsonText, *Path);
+}
+
+bool MinimapShards::ReadManifest(const FString& Path, FMinimapShardManifest& OutManifest)
+{
+	FString JsonText;
+	return FFileHelper::LoadFileToString(JsonText, *Path) && FJsonObjectConverter::JsonObjectStringToUStruct(JsonText, &OutManifest) &&
+		OutManifest.GetNumShards() > 0;
+}
+
+bool MinimapShards::WriteIndex(const FString& Path, const int32 ShardIndex, const TArray<FMinimapShardTileRecord>& Records)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	uint32 Magic = IndexMagic;
+	int32 Version = IndexVersion;
+	int32 Shard = ShardIndex;
+	int32 NumRecords = Records.Num();
+	Writer << Magic << Version << Shard << NumRecords;
+	for (FMinimapShardTileRecord Record : Records)
+	{
+		Writer << Record;
+	}
+
+	// The coordinator polls the index while the worker runs; a rename is atomic on the same volume.
+	const FString TempPath = Path + TEXT(".tmp");
+	return FFileHelper::SaveArrayToFile(Data, *TempPath) && IFileManager::Get().Move(*Path, *TempPath, true, true);
+}
+
+bool MinimapShards::ReadIndex(const FString& Path, const int32 ShardIndex, TArray<FMinimapShardTileRecord>& OutRecords)
+{
+	OutRecords.Reset();
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 Shard = INDEX_NONE;
+	int32 NumRecords = 0;
+	Reader << Magic << Version << Shard << NumRecords;
+	if (Reader.IsError() || Magic != IndexMagic || Version != IndexVersion || Shard != ShardIndex || NumRecords < 0 ||
+		Reader.TotalSize() - Reader.Tell() < static_cast<int64>(NumRecords) * (sizeof(int32) * 3 + sizeof(int64) + sizeof(uint32)))
+	{
+		return false;
+	}
+
+	OutRecords.SetNum(NumRecords);
+	for (FMinimapShardTileRecord& Record : OutRecords)
+	{
+		Reader << Record;
+	}
+	if (Reader.IsError())
+	{
+		OutRecords.Reset();
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinimapGeneratorManager.h"
+#include "MinimapTileLayout.h"
+#include "MinimapCaptureShards.generated.h"
+
+/**
+ * What the coordinator of a sharded capture hands its worker processes: the settings, the level, the grid it planned
+ * and which tiles each worker renders. Written as "<FileName>_shards.json" in the shared tile folder.
+ */
+USTRUCT()
+struct FMinimapShardManifest
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FMinimapCaptureSettings Settings;
+
+	/** Long package name of the level the workers load, e.g. /Game/Maps/World. */
+	UPROPERTY()
+	FString MapPackage;
+
+	/** Folder the workers write their tiles and indices to. */
+	UPROPERTY()
+	FString TileDirectory;
+
+	/** The coordinator's grid; a worker refuses to render when its own plan differs. */
+	UPROPERTY()
+	FIntPoint OutputSize = FIntPoint::ZeroValue;
+
+	UPROPERTY()
+	FIntPoint TileSize = FIntPoint::ZeroValue;
+
+	UPROPERTY()
+	FIntPoint EdgeTileSize = FIntPoint::ZeroValue;
+
+	UPROPERTY()
+	FIntPoint NumTiles = FIntPoint::ZeroValue;
+
+	UPROPERTY()
+	int32 Overlap = 0;
+
+	/** Shard I renders tiles [ShardFirstTiles[I], ShardFirstTiles[I + 1]); NumShards + 1 entries. */
+	UPROPERTY()
+	TArray<int32> ShardFirstTiles;
+
+	int32 GetNumShards() const { return FMath::Max(ShardFirstTiles.Num() - 1, 0); }
+	void SetLayout(const FMinimapTileLayout& Layout);
+	bool MatchesLayout(const FMinimapTileLayout& Layout) const;
+
+	/** Splits the grid into NumShards bands of whole rows where possible, so each worker streams one region of the level. */
+	void AssignShards(const FMinimapTileLayout& Layout, int32 InNumShards);
+};
+
+/** One tile a worker has finished and written to the shared folder. */
+struct FMinimapShardTileRecord
+{
+	int32 TileIndex = INDEX_NONE;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	/** Size and CRC of the tile file, so the merge never reads a tile that is still being written or was left truncated. */
+	int64 FileBytes = 0;
+	uint32 FileCrc = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FMinimapShardTileRecord& Record)
+	{
+		return Ar << Record.TileIndex << Record.Size << Record.FileBytes << Record.FileCrc;
+	}
+};
+
+namespace MinimapShards
+{
+	/** "<BaseFileName>_shards.json". */
+	FString GetManifestFileName(const FString& BaseFileName);
+	/** "<BaseFileName>_Shard_<Index>.idx": the binary index a worker rewrites after every tile. */
+	FString GetIndexFileName(const FString& BaseFileName, int32 ShardIndex);
+
+	bool WriteManifest(const FMinimapShardManifest& Manifest, const FString& Path);
+	bool ReadManifest(const FString& Path, FMinimapShardManifest& OutManifest);
+
+	/** Writes the index next to its final path and moves it into place, so readers only ever see a complete index. */
+	bool WriteIndex(const FString& Path, int32 ShardIndex, const TArray<FMinimapShardTileRecord>& Records);
+	/** False when the index is missing, still being replaced, or was written for another shard. */
+	bool ReadIndex(const FString& Path, int32 ShardIndex, TArray<FMinimapShardTileRecord>& OutRecords);
+}
@@ -4,29 +4,38 @@
 #include "MinimapGeneratorBPLibrary.h"
 #include "PanoramicMinimapGeneratorEditor.h"
 
+#include "Editor.h"
+
 void UMinimapGeneratorBPLibrary::StartMinimapCapture(const FMinimapCaptureSettings& Settings)
+{
+	FMinimapCaptureJob Job;
+	Job.Settings = Settings;
+	EnqueueMinimapCaptures({Job});
+}
+
+void UMinimapGeneratorBPLibrary::EnqueueMinimapCaptures(const TArray<FMinimapCaptureJob>& Jobs)
 {
 #if WITH_EDITOR
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("StartMinimapCapture called from Blueprint library."));
-	// This is an editor-only process.
-	UMinimapGeneratorManager* Manager = NewObject<UMinimapGeneratorManager>();
-	if (!Manager)
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("EnqueueMinimapCaptures called from Blueprint library with %d job(s)."), Jobs.Num());
+	// This is an editor-only process. Captures share the GPU, so they always run one at a time through the queue.
+	UMinimapCaptureQueueSubsystem* Queue = GEditor ? GEditor->GetEditorSubsystem<UMinimapCaptureQueueSubsystem>() : nullptr;
+	if (!Queue)
 	{
-		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to create UMinimapGeneratorManager."));
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Minimap capture queue is not available."));
 		return;
 	}
+	Queue->EnqueueJobs(Jobs);
+#else
+	UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("EnqueueMinimapCaptures called outside editor; ignored."));
+#endif
+}
 
-	// Keep the manager alive during the process
-	Manager->AddToRoot();
-	Manager->OnCaptureComplete.AddLambda([Manager](bool, const FString&)
+void UMinimapGeneratorBPLibrary::CancelMinimapCaptures()
+{
+#if WITH_EDITOR
+	if (UMinimapCaptureQueueSubsystem* Queue = GEditor ? GEditor->GetEditorSubsystem<UMinimapCaptureQueueSubsystem>() : nullptr)
 	{
-		if (Manager && Manager->IsRooted())
-		{
-			Manager->RemoveFromRoot();
-		}
-	});
-	Manager->StartCaptureProcess(Settings);
-#else
-	UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("StartMinimapCapture called outside editor; ignored."));
+		Queue->CancelAll();
+	}
 #endif
 }
@@ -2,27 +2,44 @@
 
 
 #include "MinimapGeneratorManager.h"
+#include "MinimapCaptureShards.h"
+#include "MinimapGeneratorStats.h"
+#include "MinimapGpuTimer.h"
+#include "MinimapImageKernels.h"
+#include "MinimapPrimitiveBoundsIndex.h"
+#include "MinimapStreamingSource.h"
+#include "MinimapTextureSourceUpdate.h"
+#include "MinimapTileSources.h"
+#include "MinimapTileStitcher.h"
+#include "MinimapTileStore.h"
 #include "PanoramicMinimapGeneratorEditor.h"
 
+#include "ContentStreaming.h"
 #include "Editor.h"
 #include "IImageWrapperModule.h"
 #include "IImageWrapper.h"
+#include "ImageCore.h"
 #include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
 #include "Async/Async.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "Engine/SceneCapture2D.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "RHICommandList.h"
+#include "RHI.h"
 #include "Kismet/GameplayStatics.h"
+#include "JsonObjectConverter.h"
+#include "Misc/PackageName.h"
+#include "UnrealEdMisc.h"
 
 class FSaveImageTask : public FNonAbandonableTask
 {
 public:
-	FSaveImageTask(TArray<FColor> InPixelData, const int32 InWidth, const int32 InHeight, FString InFullPath,
-	               const TWeakObjectPtr<UMinimapGeneratorManager> InManager)
-		: PixelData(MoveTemp(InPixelData)), Width(InWidth), Height(InHeight), FullPath(MoveTemp(InFullPath)),
-		  ManagerPtr(InManager)
+	FSaveImageTask(TArray<FColor> InPixelData, FMinimapTrackedBytes InPixelDataBytes, const int32 InWidth, const int32 InHeight,
+	               FString InFullPath, const TWeakObjectPtr<UMinimapGeneratorManager> InManager, const bool bInKeepEncodedImage)
+		: PixelData(MoveTemp(InPixelData)), PixelDataBytes(MoveTemp(InPixelDataBytes)), Width(InWidth), Height(InHeight),
+		  FullPath(MoveTemp(InFullPath)), ManagerPtr(InManager), bKeepEncodedImage(bInKeepEncodedImage)
 	{
 	}
 
@@ -30,12 +47,48 @@ public:
 	{
 		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(
 			FName("ImageWrapper"));
-		if (const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-			ImageWrapper.IsValid() && ImageWrapper->SetRaw(PixelData.GetData(), PixelData.Num() * sizeof(FColor), Width,
-			                                               Height, ERGBFormat::BGRA, 8))
+		FMinimapSaveStats SaveStats;
+		double StageStartTime = FPlatformTime::Seconds();
+		TArray64<uint8> CompressedData;
+		FMinimapTrackedBytes CompressedDataBytes;
+		{
+			LLM_SCOPE_BYTAG(MinimapGenerator_ImageWrapperBuffers);
+			const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+			if (ImageWrapper.IsValid() && ImageWrapper->SetRaw(PixelData.GetData(), PixelData.Num() * sizeof(FColor), Width, Height,
+			                                                   ERGBFormat::BGRA, 8))
+			{
+				// The wrapper keeps its own copy of the raw pixels, and of the PNG next to the one it returns.
+				MINIMAP_STAGE_SCOPE(STAT_MinimapEncode);
+				FMinimapTrackedBytes WrapperRawBytes(EMinimapMemoryTag::ImageWrapperBuffers, PixelData.Num() * sizeof(FColor));
+				CompressedData = ImageWrapper->GetCompressed();
+				CompressedDataBytes = FMinimapTrackedBytes(EMinimapMemoryTag::ImageWrapperBuffers, CompressedData.Num() * 2);
+				SaveStats.PeakUsedPhysicalBytes = FPlatformMemory::GetStats().UsedPhysical;
+			}
+		}
+		SaveStats.EncodeSeconds = FPlatformTime::Seconds() - StageStartTime;
+
+		// Only the PNG is needed from here on; release the full-resolution pixels before writing to disk.
+		PixelData.Empty();
+		PixelDataBytes.Reset();
+		CompressedDataBytes = FMinimapTrackedBytes(EMinimapMemoryTag::ImageWrapperBuffers, CompressedData.Num());
+
+		if (CompressedData.Num() > 0)
 		{
-			const bool bSuccess = FFileHelper::SaveArrayToFile(ImageWrapper->GetCompressed(), *FullPath);
-			AsyncTask(ENamedThreads::GameThread, [ManagerPtr = this->ManagerPtr, bSuccess, Path = this->FullPath]
+			StageStartTime = FPlatformTime::Seconds();
+			bool bSuccess;
+			{
+				MINIMAP_STAGE_SCOPE(STAT_MinimapDiskWrite);
+				bSuccess = FFileHelper::SaveArrayToFile(CompressedData, *FullPath);
+			}
+			SaveStats.WriteSeconds = FPlatformTime::Seconds() - StageStartTime;
+			SaveStats.BytesWritten = bSuccess ? CompressedData.Num() : 0;
+
+			if (!bKeepEncodedImage)
+			{
+				CompressedData.Empty();
+			}
+			AsyncTask(ENamedThreads::GameThread, [ManagerPtr = this->ManagerPtr, bSuccess, Path = this->FullPath, SaveStats,
+				EncodedImage = MoveTemp(CompressedData)]() mutable
 			{
 				if (IsEngineExitRequested())
 				{
@@ -44,7 +97,7 @@ public:
 
 				if (UMinimapGeneratorManager* Manager = ManagerPtr.Get())
 				{
-					Manager->OnSaveTaskCompleted(bSuccess, Path);
+					Manager->OnSaveTaskCompleted(bSuccess, Path, SaveStats, MoveTemp(EncodedImage));
 				}
 			});
 		}
@@ -73,10 +126,32 @@ public:
 
 protected:
 	TArray<FColor> PixelData;
+	FMinimapTrackedBytes PixelDataBytes;
 	int32 Width;
 	int32 Height;
 	FString FullPath;
 	TWeakObjectPtr<UMinimapGeneratorManager> ManagerPtr;
+	bool bKeepEncodedImage;
+};
+
+/** The texture and DataAsset import that follows a successful save, driven from the game thread one image at a time. */
+struct FMinimapAssetImport
+{
+	FString SavedImagePath;
+	/** The image the texture and DataAsset are named after: the saved image, or "<Base>.png" for UDIM pages. */
+	FString AssetImagePath;
+	/** The base map, except for UDIM pages, then each floor's image. */
+	TArray<FString> ImagePaths;
+	/** Images imported so far; the next one to decode. */
+	int32 NumImported = 0;
+	/** The base map then one per floor, null where the image could not be imported. */
+	TArray<TWeakObjectPtr<UTexture2D>> Textures;
+	/** Buffer saves still running when the import started; the first worker waits for them. */
+	TArray<TPair<FString, UE::Tasks::TTask<bool>>> BufferSaveTasks;
+	/** The next image, once its worker has decoded it. */
+	TUniquePtr<FMinimapDecodedImage> DecodedImage;
+	/** Existing asset packages still loading in the background. */
+	int32 NumPendingLoads = 0;
 };
 
 // =================== START OF NEW CODE ===================
@@ -85,8 +160,10 @@ protected:
 class FSaveDebugTileTask : public FNonAbandonableTask
 {
 public:
-	FSaveDebugTileTask(TArray<FColor> InPixelData, const int32 InWidth, const int32 InHeight, FString InFullPath)
-		: PixelData(MoveTemp(InPixelData)), Width(InWidth), Height(InHeight), FullPath(MoveTemp(InFullPath))
+	FSaveDebugTileTask(TArray<FColor> InPixelData, const int32 InWidth, const int32 InHeight, FString InFullPath,
+	                   TSharedPtr<FThreadSafeCounter64, ESPMode::ThreadSafe> InBytesWritten)
+		: PixelData(MoveTemp(InPixelData)), Width(InWidth), Height(InHeight), FullPath(MoveTemp(InFullPath)),
+		  BytesWritten(MoveTemp(InBytesWritten))
 	{
 	}
 
@@ -94,11 +171,17 @@ public:
 	{
 		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(
 			FName("ImageWrapper"));
+		LLM_SCOPE_BYTAG(MinimapGenerator_ImageWrapperBuffers);
 		if (const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
 			ImageWrapper.IsValid() && ImageWrapper->SetRaw(PixelData.GetData(), PixelData.Num() * sizeof(FColor), Width,
 			                                               Height, ERGBFormat::BGRA, 8))
 		{
-			const bool bSuccess = FFileHelper::SaveArrayToFile(ImageWrapper->GetCompressed(), *FullPath);
+			const TArray64<uint8> CompressedData = ImageWrapper->GetCompressed();
+			const bool bSuccess = FFileHelper::SaveArrayToFile(CompressedData, *FullPath);
+			if (bSuccess && BytesWritten.IsValid())
+			{
+				BytesWritten->Add(CompressedData.Num());
+			}
 
 			// Log the result back on the game thread for visibility
 			AsyncTask(ENamedThreads::GameThread, [bSuccess, Path = this->FullPath]
@@ -144,30 +227,109 @@ protected:
 	int32 Width;
 	int32 Height;
 	FString FullPath;
+	TSharedPtr<FThreadSafeCounter64, ESPMode::ThreadSafe> BytesWritten;
 };
 
 // Helper function to start the debug tile saving task
 void SaveDebugTileImage(const FString& BasePath, const FString& BaseFileName, const TArray<FColor>& PixelData,
-                        const int32 TileX, const int32 TileY, int32 TileResolution)
+                        const int32 TileX, const int32 TileY, const int32 TileWidth, const int32 TileHeight,
+                        TSharedPtr<FThreadSafeCounter64, ESPMode::ThreadSafe> BytesWritten)
 {
 	// Create a descriptive filename for the debug tile, e.g., "Minimap_Result_Tile_0_1.png"
-	const FString DebugFileName = FString::Printf(TEXT("%s_Tile_%d_%d.png"), *BaseFileName, TileX, TileY);
+	const FString DebugFileName = GetSavedTileFileName(BaseFileName, FIntPoint(TileX, TileY));
 	const FString FullPath = FPaths::Combine(BasePath, DebugFileName);
 
 	// Start the dedicated async task for saving the debug tile.
 	// We pass a copy of PixelData because the original will be moved into the main TMap.
-	(new FAutoDeleteAsyncTask<FSaveDebugTileTask>(PixelData, TileResolution, TileResolution, FullPath))->
+	(new FAutoDeleteAsyncTask<FSaveDebugTileTask>(PixelData, TileWidth, TileHeight, FullPath, MoveTemp(BytesWritten)))->
 		StartBackgroundTask();
 }
 
 // =================== END OF NEW CODE ===================
 
 void UMinimapGeneratorManager::StartCaptureProcess(const FMinimapCaptureSettings& InSettings)
+{
+	PatchTexture.Reset();
+	PatchRect = FIntRect();
+	bPatchAwaitsEncodedImage = false;
+	BeginCaptureProcess(InSettings);
+}
+
+void UMinimapGeneratorManager::StartPatchCapture(const FMinimapCaptureSettings& InSettings, UMinimapDefinitionDataAsset* Target,
+                                                 const FBox& PatchBounds)
+{
+	PatchTexture.Reset();
+	PatchRect = FIntRect();
+	bPatchAwaitsEncodedImage = false;
+	UTexture2D* Texture = Target ? Target->BaseMapTexture.Get() : nullptr;
+	if (!Texture || !Texture->Source.IsValid())
+	{
+		OnCaptureComplete.Broadcast(false, TEXT("The minimap DataAsset has no base map texture with source data to patch."));
+		return;
+	}
+	if (Target->TextureMode == EMinimapTextureMode::VirtualTextureUDIM)
+	{
+		OnCaptureComplete.Broadcast(false, TEXT("Virtual texture (UDIM) minimaps cannot be patched; capture them again."));
+		return;
+	}
+	if (Texture->Source.GetSizeX() != Target->OutputSize.X || Texture->Source.GetSizeY() != Target->OutputSize.Y)
+	{
+		OnCaptureComplete.Broadcast(false, FString::Printf(TEXT("%s is %dx%d but the DataAsset records a %dx%d capture."),
+			*Texture->GetName(), Texture->Source.GetSizeX(), Texture->Source.GetSizeY(), Target->OutputSize.X, Target->OutputSize.Y));
+		return;
+	}
+
+	// Same world-to-pixel mapping as the original capture; only the tiles around the patch are rendered.
+	FMinimapCaptureSettings PatchSettings = InSettings;
+	PatchSettings.CaptureBounds = Target->WorldBounds;
+	PatchSettings.OutputWidth = Target->OutputSize.X;
+	PatchSettings.OutputHeight = Target->OutputSize.Y;
+	PatchSettings.CameraRotation.Yaw = Target->MapRotationDegrees;
+	PatchSettings.bUseTiling = true;
+	PatchSettings.NumCaptureShards = 1;
+	PatchSettings.AdditionalBuffers.Empty();
+	PatchSettings.Floors.Empty();
+	PatchSettings.TextureMode = EMinimapTextureMode::SingleTexture;
+	// The texture is updated in place and the DataAsset's bounds do not change.
+	PatchSettings.bImportAsTextureAsset = false;
+	PatchSettings.bExportDefinitionAsset = false;
+
+	Settings = PatchSettings;
+	const double WorldUnitsPerPixel = GetWorldUnitsPerPixel();
+	if (WorldUnitsPerPixel <= 0.0)
+	{
+		OnCaptureComplete.Broadcast(false, TEXT("The minimap DataAsset has invalid bounds or output size."));
+		return;
+	}
+	const FVector2D BoundsMin(PatchSettings.CaptureBounds.Min);
+	PatchRect = FIntRect(
+		FMath::FloorToInt32((PatchBounds.Min.X - BoundsMin.X) / WorldUnitsPerPixel),
+		FMath::FloorToInt32((PatchBounds.Min.Y - BoundsMin.Y) / WorldUnitsPerPixel),
+		FMath::CeilToInt32((PatchBounds.Max.X - BoundsMin.X) / WorldUnitsPerPixel),
+		FMath::CeilToInt32((PatchBounds.Max.Y - BoundsMin.Y) / WorldUnitsPerPixel));
+	PatchRect.Clip(FIntRect(FIntPoint::ZeroValue, Target->OutputSize));
+	if (PatchRect.Area() <= 0)
+	{
+		OnCaptureComplete.Broadcast(false, TEXT("The patch region does not overlap the minimap's bounds."));
+		return;
+	}
+
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Patching %s: pixels %s of %dx%d."), *Texture->GetName(), *PatchRect.ToString(),
+		Target->OutputSize.X, Target->OutputSize.Y);
+	PatchTexture = Texture;
+	BeginCaptureProcess(PatchSettings);
+}
+
+void UMinimapGeneratorManager::BeginCaptureProcess(const FMinimapCaptureSettings& InSettings)
 {
 	bIsShuttingDown = false;
 	bCancelRequested = false;
+	bMergingShards = false;
 	UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("[%s::%s] - Starting minimap capture process."), *GetName(), *FString(__FUNCTION__));
 	this->Settings = InSettings;
+	CaptureReport.Reset();
+	DebugTileBytesWritten = MakeShared<FThreadSafeCounter64, ESPMode::ThreadSafe>();
+	TileGpuTimer = MakeShared<FMinimapGpuTimer, ESPMode::ThreadSafe>();
 
 	if (!Settings.CaptureBounds.IsValid || Settings.OutputWidth <= 0 || Settings.OutputHeight <= 0)
 	{
@@ -175,12 +337,22 @@ void UMinimapGeneratorManager::StartCaptureProcess(const FMinimapCaptureSettings
 		return;
 	}
 
-	if (Settings.bUseTiling && (Settings.TileResolution <= 0 || Settings.TileOverlap < 0 || Settings.TileOverlap >= Settings.TileResolution))
+	if (Settings.bUseTiling && (Settings.TileResolution <= 0 || Settings.TileOverlap < 0 || GetEffectiveTileOverlap(Settings) >= Settings.TileResolution))
 	{
 		OnCaptureComplete.Broadcast(false, TEXT("Invalid tiling settings. Tile overlap must be lower than tile resolution."));
 		return;
 	}
 
+	PagedTexture.Reset();
+	PageOutputBasePath.Empty();
+	bPagedTextureLoadRequested = false;
+	if (FString Error; !ValidateTextureMode(Error))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%s"), *Error);
+		OnCaptureComplete.Broadcast(false, Error);
+		return;
+	}
+
 	OnProgress.Broadcast(FText::FromString(TEXT("Starting capture process...")), 0.0f, 0, 1);
 	if (Settings.bUseTiling)
 	{
@@ -192,6 +364,66 @@ void UMinimapGeneratorManager::StartCaptureProcess(const FMinimapCaptureSettings
 	}
 }
 
+bool UMinimapGeneratorManager::ValidateTextureMode(FString& OutError) const
+{
+	const FIntPoint OutputSize(Settings.OutputWidth, Settings.OutputHeight);
+	// The largest texture the engine builds; the image itself can still be saved without the import.
+	constexpr int32 MaxTextureSize = 16384;
+	if (Settings.TextureMode != EMinimapTextureMode::VirtualTextureUDIM)
+	{
+		if ((Settings.bImportAsTextureAsset || Settings.bExportDefinitionAsset) && OutputSize.GetMax() > MaxTextureSize)
+		{
+			OutError = FString::Printf(TEXT("A %dx%d minimap is larger than a %d px texture. Use the Virtual Texture (UDIM) output or turn off the import."),
+				OutputSize.X, OutputSize.Y, MaxTextureSize);
+			return false;
+		}
+		return true;
+	}
+
+	if (!Settings.bUseTiling)
+	{
+		OutError = TEXT("The Virtual Texture (UDIM) output is stitched from tiles; turn on tiling.");
+		return false;
+	}
+	if (Settings.UDIMPageSize < 512 || Settings.UDIMPageSize > 8192 || !FMath::IsPowerOfTwo(Settings.UDIMPageSize))
+	{
+		OutError = FString::Printf(TEXT("The UDIM page size must be a power of two from 512 to 8192, not %d."), Settings.UDIMPageSize);
+		return false;
+	}
+	const FIntPoint PageCount = MinimapTextureSource::GetPageCount(OutputSize, Settings.UDIMPageSize);
+	if (PageCount.X > MinimapTextureSource::MaxUDIMColumns)
+	{
+		OutError = FString::Printf(TEXT("%d px needs %d UDIM pages across, but at most %d fit in a row. Raise the page size."), OutputSize.X,
+			PageCount.X, MinimapTextureSource::MaxUDIMColumns);
+		return false;
+	}
+	// Only the base map is paged: floors and additional buffers are still stitched as one canvas and floors are
+	// imported as single textures, which the engine cannot build past the texture size limit.
+	if (OutputSize.GetMax() > MaxTextureSize && (!Settings.Floors.IsEmpty() || !Settings.AdditionalBuffers.IsEmpty()))
+	{
+		OutError = FString::Printf(TEXT("Floors and additional buffers are saved as single images, which cannot be larger than %d px. Remove them or capture them in a separate run of at most %d px."),
+			MaxTextureSize, MaxTextureSize);
+		return false;
+	}
+	// UDIM blocks have no compressed source format, so every page is held raw in the texture's source and package.
+	const int64 SourceMB = int64(PageCount.X) * PageCount.Y * Settings.UDIMPageSize * Settings.UDIMPageSize * 4 / (1024 * 1024);
+	if ((Settings.bImportAsTextureAsset || Settings.bExportDefinitionAsset) && SourceMB > Settings.UDIMSourceBudgetMB)
+	{
+		OutError = FString::Printf(TEXT("The virtual texture source would hold %lld MB of raw pixels in editor memory and in the package, over the %d MB budget. Lower the output size, turn off the import, or raise the budget."),
+			SourceMB, Settings.UDIMSourceBudgetMB);
+		return false;
+	}
+
+	if (const IConsoleVariable* VirtualTexturesCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.VirtualTextures"));
+		VirtualTexturesCVar && VirtualTexturesCVar->GetInt() == 0)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning,
+			TEXT("Virtual textures are disabled in this project (Project Settings > Rendering > Virtual Textures). The UDIM minimap is imported but does not render until they are enabled."));
+	}
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Virtual texture output: %dx%d UDIM pages of %d px."), PageCount.X, PageCount.Y, Settings.UDIMPageSize);
+	return true;
+}
+
 void UMinimapGeneratorManager::CancelCapture()
 {
 	UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("[%s::%s] - Capture process cancelled by user."), *GetName(), *FString(__FUNCTION__));
@@ -204,7 +436,12 @@ void UMinimapGeneratorManager::ShutdownCapture(const bool bBroadcastResult)
 	bIsShuttingDown = !bBroadcastResult;
 
 	CleanupCaptureResources();
-	CapturedTileData.Empty();
+	AssetImport.Reset();
+	if (TileStore.IsValid())
+	{
+		TileStore->Empty();
+		TileStore.Reset();
+	}
 
 	if (bBroadcastResult && !IsEngineExitRequested())
 	{
@@ -220,19 +457,80 @@ void UMinimapGeneratorManager::ShutdownCapture(const bool bBroadcastResult)
 void UMinimapGeneratorManager::BeginDestroy()
 {
 	ShutdownCapture(false);
+	ReleaseRetainedCaptureResources();
 	Super::BeginDestroy();
 }
 
-void UMinimapGeneratorManager::OnSaveTaskCompleted(const bool bSuccess, const FString& SavedImagePath)
+void UMinimapGeneratorManager::ReleaseRetainedCaptureResources()
+{
+	TGuardValue<bool> RetainGuard(bRetainCaptureResources, false);
+	if (RetainedCaptureActor.IsValid())
+	{
+		RetainedCaptureActor->Destroy();
+	}
+	RetainedCaptureActor.Reset();
+	ReleaseRenderTargets();
+}
+
+void UMinimapGeneratorManager::AdoptCaptureResources(UMinimapGeneratorManager& Other)
+{
+	if (&Other == this)
+	{
+		return;
+	}
+
+	if (!RetainedCaptureActor.IsValid())
+	{
+		RetainedCaptureActor = Other.RetainedCaptureActor;
+		Other.RetainedCaptureActor.Reset();
+	}
+	// The float targets of additional buffers are pooled by size just like the color ones.
+	auto AdoptRenderTargets = [](TMap<FIntPoint, TObjectPtr<UTextureRenderTarget2D>>& Into, TMap<FIntPoint, TObjectPtr<UTextureRenderTarget2D>>& From)
+	{
+		for (const TPair<FIntPoint, TObjectPtr<UTextureRenderTarget2D>>& Pair : From)
+		{
+			if (!Pair.Value)
+			{
+				continue;
+			}
+			if (Into.Contains(Pair.Key))
+			{
+				Pair.Value->ConditionalBeginDestroy();
+			}
+			else
+			{
+				Into.Add(Pair.Key, Pair.Value);
+			}
+		}
+		From.Empty();
+	};
+	AdoptRenderTargets(TileRenderTargets, Other.TileRenderTargets);
+	AdoptRenderTargets(FloatTileRenderTargets, Other.FloatTileRenderTargets);
+}
+
+void UMinimapGeneratorManager::OnSaveTaskCompleted(const bool bSuccess, const FString& SavedImagePath, const FMinimapSaveStats& SaveStats,
+                                                   TArray64<uint8> EncodedImage)
 {
 	if (bIsShuttingDown || IsEngineExitRequested())
 	{
 		return;
 	}
 
+	CaptureReport.AddStageSeconds(MinimapCaptureStage::Encode, SaveStats.EncodeSeconds);
+	CaptureReport.AddStageSeconds(MinimapCaptureStage::DiskWrite, SaveStats.WriteSeconds);
+	CaptureReport.FinalImageBytes = SaveStats.BytesWritten;
+	CaptureReport.PeakUsedPhysicalBytes = FMath::Max(CaptureReport.PeakUsedPhysicalBytes, SaveStats.PeakUsedPhysicalBytes);
+	CaptureReport.SampleMemory();
+
+	const bool bPatchSourcePending = bPatchAwaitsEncodedImage;
+	bPatchAwaitsEncodedImage = false;
 	if (bSuccess)
 	{
 		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Async save task completed successfully. Path: %s"), *SavedImagePath);
+		if (bPatchSourcePending && EncodedImage.Num() > 0)
+		{
+			WritePatchSource({}, FIntPoint(Settings.OutputWidth, Settings.OutputHeight), EncodedImage);
+		}
 	}
 	else
 	{
@@ -242,15 +540,177 @@ void UMinimapGeneratorManager::OnSaveTaskCompleted(const bool bSuccess, const FS
 		return;
 	}
 
-	UTexture2D* ImportedTexture = nullptr;
+	StartAssetImport(SavedImagePath);
+}
+
+void UMinimapGeneratorManager::StartAssetImport(const FString& SavedImagePath)
+{
+	AssetImport = MakeShared<FMinimapAssetImport>();
+	AssetImport->SavedImagePath = SavedImagePath;
+	AssetImport->AssetImagePath = PageOutputBasePath.IsEmpty() ? SavedImagePath : PageOutputBasePath + TEXT(".png");
+	AssetImport->BufferSaveTasks = MoveTemp(BufferSaveTasks);
+	BufferSaveTasks.Empty();
 	if (!SavedImagePath.IsEmpty() && (Settings.bImportAsTextureAsset || Settings.bExportDefinitionAsset))
 	{
-		ImportedTexture = ImportTextureAssetFromSavedImage(SavedImagePath);
+		if (PageOutputBasePath.IsEmpty())
+		{
+			AssetImport->ImagePaths.Add(SavedImagePath);
+		}
+		else
+		{
+			// The UDIM pages went into the texture while they were stitched.
+			AssetImport->Textures.Add(PagedTexture);
+		}
+		AssetImport->ImagePaths.Append(FloorImagePaths);
+	}
+	FloorImagePaths.Empty();
+	PageOutputBasePath.Empty();
+	PagedTexture.Reset();
+
+	// Existing assets that are not loaded yet come in on the async loading thread while the images decode, rather than
+	// through FullyLoad on the game thread.
+	TArray<FString> PackageNames;
+	for (const FString& ImagePath : AssetImport->ImagePaths)
+	{
+		PackageNames.Add(MakeTextureAssetPath(ImagePath));
+	}
+	if (!SavedImagePath.IsEmpty() && Settings.bExportDefinitionAsset)
+	{
+		PackageNames.Add(MakeDefinitionAssetPath(AssetImport->AssetImagePath));
+	}
+	for (const FString& PackageName : PackageNames)
+	{
+		if (FindPackage(nullptr, *PackageName) || !FPackageName::DoesPackageExist(PackageName))
+		{
+			continue;
+		}
+
+		AssetImport->NumPendingLoads++;
+		LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateWeakLambda(this,
+			[this, WeakImport = TWeakPtr<FMinimapAssetImport>(AssetImport)](const FName& LoadedPackageName, UPackage*,
+			                                                                  const EAsyncLoadingResult::Type Result)
+			{
+				if (Result != EAsyncLoadingResult::Succeeded)
+				{
+					UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Background load of %s failed; it is loaded when imported."),
+						*LoadedPackageName.ToString());
+				}
+				if (bIsShuttingDown || IsEngineExitRequested() || !AssetImport.IsValid() || WeakImport.Pin() != AssetImport)
+				{
+					return;
+				}
+				AssetImport->NumPendingLoads--;
+				ContinueAssetImport();
+			}));
+	}
+
+	if (!AssetImport->ImagePaths.IsEmpty())
+	{
+		OnProgress.Broadcast(WithMemoryHighWater(FText::FromString(TEXT("Importing assets..."))), 0.97f, 0, 0);
+	}
+	DecodeNextImportImage();
+}
+
+void UMinimapGeneratorManager::DecodeNextImportImage()
+{
+	FMinimapAssetImport& Import = *AssetImport;
+	const int32 ImageIndex = Import.NumImported;
+	if (ImageIndex == Import.ImagePaths.Num() && Import.BufferSaveTasks.IsEmpty())
+	{
+		FinishAssetImport();
+		return;
+	}
+
+	FString Path = Import.ImagePaths.IsValidIndex(ImageIndex) ? Import.ImagePaths[ImageIndex] : FString();
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis = TWeakObjectPtr<UMinimapGeneratorManager>(this), WeakImport = TWeakPtr<FMinimapAssetImport>(AssetImport), Path = MoveTemp(Path),
+			BufferSaves = MoveTemp(Import.BufferSaveTasks)]() mutable
+		{
+			// The floor images are written by the buffer saves, so those have to finish before anything is decoded.
+			for (TPair<FString, UE::Tasks::TTask<bool>>& BufferSave : BufferSaves)
+			{
+				if (BufferSave.Value.GetResult())
+				{
+					UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Buffer saved: %s"), *BufferSave.Key);
+				}
+				else
+				{
+					UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to save buffer %s"), *BufferSave.Key);
+				}
+			}
+
+			TUniquePtr<FMinimapDecodedImage> Image = MakeUnique<FMinimapDecodedImage>();
+			if (FString Error; !Path.IsEmpty() && IFileManager::Get().FileExists(*Path) && !MinimapTextureSource::DecodeImageFile(Path, *Image, Error))
+			{
+				UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%s"), *Error);
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, WeakImport, Image = MoveTemp(Image)]() mutable
+			{
+				if (IsEngineExitRequested())
+				{
+					return;
+				}
+
+				UMinimapGeneratorManager* Manager = WeakThis.Get();
+				const TSharedPtr<FMinimapAssetImport> Import = WeakImport.Pin();
+				if (Manager && !Manager->bIsShuttingDown && Import.IsValid() && Import == Manager->AssetImport)
+				{
+					Import->DecodedImage = MoveTemp(Image);
+					Manager->ContinueAssetImport();
+				}
+			});
+		});
+}
+
+void UMinimapGeneratorManager::ContinueAssetImport()
+{
+	FMinimapAssetImport& Import = *AssetImport;
+	// The import needs the asset packages loaded; it picks up again when the last background load completes.
+	if (!Import.DecodedImage.IsValid() || Import.NumPendingLoads > 0)
+	{
+		return;
+	}
+
+	TUniquePtr<FMinimapDecodedImage> Image = MoveTemp(Import.DecodedImage);
+	if (Import.NumImported < Import.ImagePaths.Num())
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapTextureImport);
+		FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::TextureImport);
+		CaptureReport.AddStageSeconds(MinimapCaptureStage::TextureImport, Image->DecodeSeconds);
+		Import.Textures.Add(Image->IsValid() ? ImportDecodedTexture(*Image) : nullptr);
+		Import.NumImported++;
+		CaptureReport.SampleMemory();
 	}
 
+	// Released before the next image decodes, so only one full-size image is held at a time.
+	Image.Reset();
+	DecodeNextImportImage();
+}
+
+void UMinimapGeneratorManager::FinishAssetImport()
+{
+	const TSharedPtr<FMinimapAssetImport> Import = MoveTemp(AssetImport);
+	const FString& SavedImagePath = Import->SavedImagePath;
+	UTexture2D* ImportedTexture = Import->Textures.IsEmpty() ? nullptr : Import->Textures[0].Get();
+
 	if (Settings.bExportDefinitionAsset)
 	{
-		if (UMinimapDefinitionDataAsset* DefinitionAsset = CreateOrUpdateDefinitionAsset(SavedImagePath, ImportedTexture))
+		TArray<FMinimapFloor> Floors;
+		for (int32 FloorIndex = 0; FloorIndex + 1 < Import->Textures.Num() && FloorIndex < Settings.Floors.Num(); ++FloorIndex)
+		{
+			FMinimapFloor& Floor = Floors.AddDefaulted_GetRef();
+			Floor.Range = Settings.Floors[FloorIndex];
+			Floor.Texture = Import->Textures[FloorIndex + 1].Get();
+		}
+
+		UMinimapDefinitionDataAsset* DefinitionAsset;
+		{
+			MINIMAP_STAGE_SCOPE(STAT_MinimapDataAssetExport);
+			FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::DataAssetExport);
+			DefinitionAsset = CreateOrUpdateDefinitionAsset(Import->AssetImagePath, ImportedTexture, Floors);
+		}
+		if (DefinitionAsset)
 		{
 			if (GEditor && !IsEngineExitRequested())
 			{
@@ -265,126 +725,678 @@ void UMinimapGeneratorManager::OnSaveTaskCompleted(const bool bSuccess, const FS
 		}
 	}
 
-	OnProgress.Broadcast(FText::FromString(TEXT("Done!")), 1.0f, 0, 0);
+	CaptureReport.DebugTileBytes = DebugTileBytesWritten.IsValid() ? DebugTileBytesWritten->GetValue() : 0;
+	if (const FString ReportPath = CaptureReport.WriteJson(SavedImagePath, Settings, true); !ReportPath.IsEmpty())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Capture report written: %s"), *ReportPath);
+	}
+	else
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Failed to write capture report next to %s"), *SavedImagePath);
+	}
+
+	OnProgress.Broadcast(WithMemoryHighWater(FText::FromString(TEXT("Done!"))), 1.0f, 0, 0);
 	OnCaptureComplete.Broadcast(true, SavedImagePath);
 }
 
-// ===================================================================
-// FLOW 1: SINGLE CAPTURE
-// ===================================================================
-
-void UMinimapGeneratorManager::StartSingleCaptureForValidation()
+bool UMinimapGeneratorManager::ImportSavedImage(const FMinimapCaptureSettings& InSettings, const FString& ImagePath, TArray<UPackage*>& OutPackages)
 {
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Starting single capture validation flow."));
-	const UWorld* World = GEditor->GetEditorWorldContext().World();
-	if (!World)
+	TGuardValue<FMinimapCaptureSettings> SettingsGuard(Settings, InSettings);
+	if (Settings.TextureMode == EMinimapTextureMode::VirtualTextureUDIM)
 	{
-		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to start single capture: editor world is null."));
-		return;
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("%s is imported as a single texture; UDIM pages are only imported by a capture."), *ImagePath);
+		Settings.TextureMode = EMinimapTextureMode::SingleTexture;
 	}
 
-	ActiveRenderTarget = CreateRenderTarget();
-	if (!ActiveRenderTarget.IsValid())
+	UTexture2D* ImportedTexture = nullptr;
+	if (Settings.bImportAsTextureAsset || Settings.bExportDefinitionAsset)
 	{
-		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%hs: CreateRenderTarget() returned invalid target. Aborting."), __FUNCTION__);
-		OnCaptureComplete.Broadcast(false, TEXT("Failed to create render target."));
-		return;
+		ImportedTexture = ImportTextureAssetFromSavedImage(ImagePath);
+		if (!ImportedTexture)
+		{
+			return false;
+		}
+		OutPackages.AddUnique(ImportedTexture->GetPackage());
 	}
 
-	ActiveCaptureActor = SpawnAndConfigureCaptureActor(ActiveRenderTarget.Get());
-	if (!ActiveCaptureActor.IsValid())
+	if (Settings.bExportDefinitionAsset)
 	{
-		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%hs: SpawnAndConfigureCaptureActor() returned invalid actor. Aborting."), __FUNCTION__);
-		OnCaptureComplete.Broadcast(false, TEXT("Failed to spawn capture actor."));
-		return;
+		const UMinimapDefinitionDataAsset* DefinitionAsset = CreateOrUpdateDefinitionAsset(ImagePath, ImportedTexture);
+		if (!DefinitionAsset)
+		{
+			return false;
+		}
+		OutPackages.AddUnique(DefinitionAsset->GetPackage());
 	}
+	return true;
+}
 
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: Calling CaptureScene()..."), __FUNCTION__);
-	ActiveCaptureActor->GetCaptureComponent2D()->CaptureScene();
+FString UMinimapGeneratorManager::WriteSettingsFile(const FMinimapCaptureSettings& InSettings, const FString& Path)
+{
+	FString JsonText;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(InSettings, JsonText) || !FFileHelper::SaveStringToFile(JsonText, *Path))
+	{
+		return FString();
+	}
+	return Path;
+}
 
-	// Flush the rendering pipeline so the render target is fully populated before scheduling readback.
-	// This is critical on macOS Metal where async capture may not complete in time.
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: Flushing rendering commands..."), __FUNCTION__);
-	FlushRenderingCommands();
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: FlushRenderingCommands() completed. Scheduling ReadPixelsAndFinalize for next tick."), __FUNCTION__);
+bool UMinimapGeneratorManager::ReadSettingsFile(const FString& Path, FMinimapCaptureSettings& OutSettings)
+{
+	FString JsonText;
+	return FFileHelper::LoadFileToString(JsonText, *Path) && FJsonObjectConverter::JsonObjectStringToUStruct(JsonText, &OutSettings);
+}
 
-	GEditor->GetTimerManager()->SetTimerForNextTick(this, &UMinimapGeneratorManager::ReadPixelsAndFinalize);
+FText UMinimapGeneratorManager::WithMemoryHighWater(const FText& Status)
+{
+	CaptureReport.SampleMemory();
+	return FText::Format(FText::FromString(TEXT("{0}  (peak RAM {1}, capture buffers {2})")), Status,
+	                     FText::AsMemory(CaptureReport.PeakUsedPhysicalBytes), FText::AsMemory(CaptureReport.PeakTrackedBytes));
 }
 
 // ===================================================================
-// SHARED HELPER FUNCTIONS
+// DRY RUN: ESTIMATE
 // ===================================================================
 
-UTexture2D* UMinimapGeneratorManager::ImportTextureAssetFromSavedImage(const FString& SavedImagePath) const
+FMinimapCaptureEstimate UMinimapGeneratorManager::EstimateCapture(const FMinimapCaptureSettings& InSettings)
 {
-	if (SavedImagePath.IsEmpty())
+	FMinimapCaptureEstimate Estimate;
+	if (ActiveCaptureActor.IsValid() || TileStore.IsValid())
 	{
-		return nullptr;
+		Estimate.Error = TEXT("A capture is already running.");
+		return Estimate;
 	}
 
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: Starting texture asset import..."), __FUNCTION__);
-	const double ImportStartTime = FPlatformTime::Seconds();
+	const FVector BoundsSize = InSettings.CaptureBounds.GetSize();
+	if (!InSettings.CaptureBounds.IsValid || BoundsSize.X <= 0.0 || BoundsSize.Y <= 0.0 || InSettings.OutputWidth <= 0 || InSettings.OutputHeight <= 0)
+	{
+		Estimate.Error = TEXT("Invalid capture bounds or output size.");
+		return Estimate;
+	}
 
-	FString PackagePath = Settings.AssetPath;
-	if (!PackagePath.StartsWith(TEXT("/Game")))
+	if (InSettings.bUseTiling && (InSettings.TileResolution <= 0 || InSettings.TileOverlap < 0 || GetEffectiveTileOverlap(InSettings) >= InSettings.TileResolution))
 	{
-		PackagePath = TEXT("/Game/Minimaps/");
+		Estimate.Error = TEXT("Invalid tiling settings. Tile overlap must be lower than tile resolution.");
+		return Estimate;
 	}
-	if (!PackagePath.EndsWith(TEXT("/")))
+
+	FMinimapCaptureCalibration Calibration;
+	if (!CalibrateCapture(InSettings, Calibration))
 	{
-		PackagePath += TEXT("/");
+		Estimate.Error = TEXT("Calibration capture failed.");
+		return Estimate;
 	}
 
-	const FString AssetName = TEXT("T_") + FPaths::GetBaseFilename(SavedImagePath);
-	const FString FullAssetPath = PackagePath + AssetName;
+	const int64 RamBudgetBytes = InSettings.MemoryBudgetMB > 0
+		                             ? static_cast<int64>(InSettings.MemoryBudgetMB) * 1024 * 1024
+		                             : static_cast<int64>(FPlatformMemory::GetStats().AvailablePhysical);
+	FTextureMemoryStats TextureMemoryStats;
+	RHIGetTextureMemoryStats(TextureMemoryStats);
+	const int64 VramBudgetBytes = FMath::Max<int64>(0, TextureMemoryStats.DedicatedVideoMemory);
 
-	UPackage* Package = CreatePackage(*FullAssetPath);
-	Package->FullyLoad();
+	Estimate = FMinimapCaptureEstimate::Predict(InSettings, Calibration, RamBudgetBytes, VramBudgetBytes);
+	Estimate.AddRecommendations(InSettings);
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Capture estimate:\n%s"), *Estimate.ToString());
+	return Estimate;
+}
 
-	TArray<uint8> PngData;
-	if (!FFileHelper::LoadFileToArray(PngData, *SavedImagePath))
+bool UMinimapGeneratorManager::CalibrateCapture(const FMinimapCaptureSettings& InSettings, FMinimapCaptureCalibration& OutCalibration)
+{
+	// The capture helpers read the member settings and layout; point them at the settings being estimated.
+	TGuardValue<FMinimapCaptureSettings> SettingsGuard(Settings, InSettings);
+	TGuardValue<FMinimapTileLayout> LayoutGuard(TileLayout, MakeTileLayout(InSettings));
+
+	// Calibrate on a real tile (or the single capture), capped so the dry run stays quick; a second capture
+	// at a quarter of the pixels separates the fixed per-capture cost from the per-pixel cost.
+	constexpr int32 MaxCalibrationSize = 2048;
+	const FIntPoint TargetSize = Settings.bUseTiling
+		                             ? GetTileRenderTargetSize(TileLayout.GetTileRect(0, 0))
+		                             : FIntPoint(Settings.OutputWidth, Settings.OutputHeight);
+	const double Downscale = FMath::Min(1.0, static_cast<double>(MaxCalibrationSize) / TargetSize.GetMax());
+	const FIntPoint LargeSize(FMath::Max(64, FMath::RoundToInt32(TargetSize.X * Downscale)),
+	                          FMath::Max(64, FMath::RoundToInt32(TargetSize.Y * Downscale)));
+	const FIntPoint SmallSize(LargeSize.X / 2, LargeSize.Y / 2);
+
+	UTextureRenderTarget2D* LargeTarget = CreateRenderTarget(LargeSize);
+	UTextureRenderTarget2D* SmallTarget = CreateRenderTarget(SmallSize);
+	ASceneCapture2D* CaptureActor = SpawnAndConfigureCaptureActor(LargeTarget);
+	if (!CaptureActor)
 	{
-		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to load saved PNG file from disk: %s"), *SavedImagePath);
-		return nullptr;
+		LargeTarget->ConditionalBeginDestroy();
+		SmallTarget->ConditionalBeginDestroy();
+		return false;
 	}
 
-	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-	const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-	if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(PngData.GetData(), PngData.Num()))
+	USceneCaptureComponent2D* CaptureComponent = CaptureActor->GetCaptureComponent2D();
+	if (Settings.bUseTiling)
 	{
-		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to decode PNG data from file: %s"), *SavedImagePath);
-		return nullptr;
+		// Frame one tile's worth of world at the center of the bounds, where there is most likely something to render.
+		CaptureComponent->OrthoWidth = static_cast<float>(TargetSize.X * GetWorldUnitsPerPixel());
+
+		// Count the tiles empty-tile skipping would drop while the filtered show-only list is at hand.
+		if (Settings.bIsOrthographic)
+		{
+			Settings.bSkipEmptyTiles = true;
+			TArray<AActor*> VisibleActors;
+			GatherVisibleActors(CaptureComponent, VisibleActors);
+			BuildPrimitiveBoundsIndex(VisibleActors);
+			OutCalibration.NumEmptyTiles = PrimitiveBoundsIndex.IsValid() ? PrimitiveBoundsIndex->GetNumEmptyTiles() : 0;
+			PrimitiveBoundsIndex.Reset();
+		}
 	}
 
-	TArray<uint8> UncompressedBGRA;
-	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, UncompressedBGRA))
+	// Same synchronous capture + readback the tiled flow does per tile.
+	auto TimeCapture = [CaptureComponent](UTextureRenderTarget2D* RenderTarget, TArray<FColor>& OutPixels)
 	{
-		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to read PNG raw data from file: %s"), *SavedImagePath);
-		return nullptr;
-	}
+		CaptureComponent->TextureTarget = RenderTarget;
+		const double StartTime = FPlatformTime::Seconds();
+		CaptureComponent->CaptureScene();
+		if (FTextureRenderTargetResource* Resource = RenderTarget->GameThread_GetRenderTargetResource())
+		{
+			FlushRenderingCommands();
+			Resource->ReadPixels(OutPixels);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	TArray<FColor> LargePixels;
+	TArray<FColor> SmallPixels;
+	// The first capture pays for shader compilation and streaming, so it is not timed.
+	TimeCapture(LargeTarget, LargePixels);
+	const double LargeSeconds = TimeCapture(LargeTarget, LargePixels);
+	const double SmallSeconds = TimeCapture(SmallTarget, SmallPixels);
+
+	CaptureActor->Destroy();
+	LargeTarget->ConditionalBeginDestroy();
+	SmallTarget->ConditionalBeginDestroy();
 
-	UTexture2D* NewTexture = FindObject<UTexture2D>(Package, *AssetName);
-	if (!NewTexture)
+	if (LargePixels.Num() != LargeSize.X * LargeSize.Y)
 	{
-		NewTexture = NewObject<UTexture2D>(Package, *AssetName, RF_Public | RF_Standalone);
-		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-		AssetRegistryModule.AssetCreated(NewTexture);
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%hs: Calibration readback returned %d pixels, expected %dx%d."),
+			__FUNCTION__, LargePixels.Num(), LargeSize.X, LargeSize.Y);
+		return false;
 	}
 
-	NewTexture->Source.Init(ImageWrapper->GetWidth(), ImageWrapper->GetHeight(), 1, 1, TSF_BGRA8, UncompressedBGRA.GetData());
-	NewTexture->SRGB = true;
-	NewTexture->CompressionSettings = TC_Default;
-	NewTexture->UpdateResource();
-	NewTexture->MarkPackageDirty();
-	Package->MarkPackageDirty();
+	const double LargeMegapixels = LargeSize.X * LargeSize.Y / 1000000.0;
+	const double SmallMegapixels = SmallSize.X * SmallSize.Y / 1000000.0;
+	OutCalibration.CalibrationSize = LargeSize;
+	OutCalibration.CaptureSecondsPerMegapixel = FMath::Max(0.0, (LargeSeconds - SmallSeconds) / (LargeMegapixels - SmallMegapixels));
+	OutCalibration.CaptureFixedSeconds = FMath::Max(0.0, LargeSeconds - OutCalibration.CaptureSecondsPerMegapixel * LargeMegapixels);
+	OutCalibration.MeasureCpuCosts(LargePixels, LargeSize);
 
-	const double ImportDuration = FPlatformTime::Seconds() - ImportStartTime;
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Imported minimap texture asset: %s (%.2fs)"), *FullAssetPath, ImportDuration);
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Calibration: %dx%d capture %.1f ms, %dx%d capture %.1f ms."),
+		LargeSize.X, LargeSize.Y, LargeSeconds * 1000.0, SmallSize.X, SmallSize.Y, SmallSeconds * 1000.0);
+	return true;
+}
 
-	return NewTexture;
+TArray<FMinimapCaptureProfileCost> UMinimapGeneratorManager::MeasureCaptureProfiles(const FMinimapCaptureSettings& InSettings, FString& OutError)
+{
+	TArray<FMinimapCaptureProfileCost> Costs;
+	if (ActiveCaptureActor.IsValid() || TileStore.IsValid())
+	{
+		OutError = TEXT("A capture is already running.");
+		return Costs;
+	}
+
+	const FVector BoundsSize = InSettings.CaptureBounds.GetSize();
+	if (!InSettings.CaptureBounds.IsValid || BoundsSize.X <= 0.0 || BoundsSize.Y <= 0.0 || InSettings.OutputWidth <= 0 || InSettings.OutputHeight <= 0 ||
+		(InSettings.bUseTiling && InSettings.TileResolution <= 0))
+	{
+		OutError = TEXT("Invalid capture bounds, output size or tile resolution.");
+		return Costs;
+	}
+
+	TGuardValue<FMinimapCaptureSettings> SettingsGuard(Settings, InSettings);
+	TGuardValue<FMinimapTileLayout> LayoutGuard(TileLayout, MakeTileLayout(InSettings));
+
+	// Time what one tile costs, framed like CalibrateCapture frames it, capped so the measurement stays quick. A tile
+	// over the cap is also timed at a quarter of the pixels, like CalibrateCapture does, so only the per-pixel part of
+	// the cost is scaled up to the tile and the fixed per-capture part is counted once.
+	constexpr int32 MaxMeasuredSize = 2048;
+	const FIntPoint TileSize = Settings.bUseTiling
+		                           ? GetTileRenderTargetSize(TileLayout.GetTileRect(0, 0))
+		                           : FIntPoint(Settings.OutputWidth, Settings.OutputHeight);
+	const double Downscale = FMath::Min(1.0, static_cast<double>(MaxMeasuredSize) / TileSize.GetMax());
+	const FIntPoint MeasuredSize(FMath::Max(64, FMath::RoundToInt32(TileSize.X * Downscale)),
+	                             FMath::Max(64, FMath::RoundToInt32(TileSize.Y * Downscale)));
+	const FIntPoint SmallSize(MeasuredSize.X / 2, MeasuredSize.Y / 2);
+	const bool bExtrapolate = MeasuredSize != TileSize;
+
+	UTextureRenderTarget2D* RenderTarget = CreateRenderTarget(MeasuredSize);
+	UTextureRenderTarget2D* SmallTarget = bExtrapolate ? CreateRenderTarget(SmallSize) : nullptr;
+	ASceneCapture2D* CaptureActor = SpawnAndConfigureCaptureActor(RenderTarget);
+	if (!CaptureActor)
+	{
+		RenderTarget->ConditionalBeginDestroy();
+		if (SmallTarget)
+		{
+			SmallTarget->ConditionalBeginDestroy();
+		}
+		OutError = TEXT("Failed to spawn capture actor.");
+		return Costs;
+	}
+
+	USceneCaptureComponent2D* CaptureComponent = CaptureActor->GetCaptureComponent2D();
+	const TSharedRef<FMinimapGpuTimer, ESPMode::ThreadSafe> GpuTimer = MakeShared<FMinimapGpuTimer, ESPMode::ThreadSafe>();
+
+	// The first capture with a new set of show flags or a new target size compiles shaders or allocates scene
+	// textures, so it is not timed. The fastest of the timed ones is the least disturbed by the rest of the editor.
+	auto TimeCaptures = [CaptureComponent, &GpuTimer](UTextureRenderTarget2D* Target, double& OutWallSeconds, double& OutGpuSeconds)
+	{
+		constexpr int32 NumTimedCaptures = 3;
+		CaptureComponent->TextureTarget = Target;
+		OutGpuSeconds = -1.0;
+		OutWallSeconds = TNumericLimits<double>::Max();
+		for (int32 CaptureIndex = 0; CaptureIndex <= NumTimedCaptures; ++CaptureIndex)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			GpuTimer->Begin();
+			CaptureComponent->CaptureScene();
+			GpuTimer->End();
+			GpuTimer->Resolve();
+			FlushRenderingCommands();
+			if (CaptureIndex > 0)
+			{
+				OutWallSeconds = FMath::Min(OutWallSeconds, FPlatformTime::Seconds() - StartTime);
+				if (GpuTimer->GetElapsedSeconds() >= 0.0)
+				{
+					OutGpuSeconds = OutGpuSeconds < 0.0 ? GpuTimer->GetElapsedSeconds() : FMath::Min(OutGpuSeconds, GpuTimer->GetElapsedSeconds());
+				}
+			}
+		}
+	};
+
+	const double MeasuredPixels = static_cast<double>(MeasuredSize.X) * MeasuredSize.Y;
+	const double SmallPixels = static_cast<double>(SmallSize.X) * SmallSize.Y;
+	const double TilePixels = static_cast<double>(TileSize.X) * TileSize.Y;
+	auto ScaleToTile = [bExtrapolate, MeasuredPixels, SmallPixels, TilePixels](const double MeasuredSeconds, const double SmallSeconds)
+	{
+		if (!bExtrapolate)
+		{
+			return MeasuredSeconds;
+		}
+		const double SecondsPerPixel = FMath::Max(0.0, (MeasuredSeconds - SmallSeconds) / (MeasuredPixels - SmallPixels));
+		return MeasuredSeconds + SecondsPerPixel * (TilePixels - MeasuredPixels);
+	};
+
+	for (const EMinimapCaptureProfile Profile : MinimapCaptureProfiles::GetAll())
+	{
+		Settings.CaptureProfile = Profile;
+		ConfigureCaptureActor(*CaptureActor, RenderTarget);
+		if (Settings.bUseTiling)
+		{
+			CaptureComponent->OrthoWidth = static_cast<float>(TileSize.X * GetWorldUnitsPerPixel());
+		}
+
+		double WallSeconds = 0.0;
+		double GpuSeconds = -1.0;
+		TimeCaptures(RenderTarget, WallSeconds, GpuSeconds);
+		double SmallWallSeconds = WallSeconds;
+		double SmallGpuSeconds = GpuSeconds;
+		if (SmallTarget)
+		{
+			TimeCaptures(SmallTarget, SmallWallSeconds, SmallGpuSeconds);
+		}
+
+		FMinimapCaptureProfileCost& Cost = Costs.AddDefaulted_GetRef();
+		Cost.Profile = Profile;
+		Cost.MeasuredSize = MeasuredSize;
+		Cost.WallMillisecondsPerTile = ScaleToTile(WallSeconds, SmallWallSeconds) * 1000.0;
+		Cost.GpuMillisecondsPerTile = GpuSeconds >= 0.0 && SmallGpuSeconds >= 0.0 ? ScaleToTile(GpuSeconds, SmallGpuSeconds) * 1000.0 : -1.0;
+		if (bExtrapolate)
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Capture profile %s (%dx%d and %dx%d timed, extrapolated to %dx%d)."),
+				*Cost.ToString(), MeasuredSize.X, MeasuredSize.Y, SmallSize.X, SmallSize.Y, TileSize.X, TileSize.Y);
+		}
+		else
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Capture profile %s (%dx%d timed)."), *Cost.ToString(), MeasuredSize.X, MeasuredSize.Y);
+		}
+	}
+
+	CaptureActor->Destroy();
+	RenderTarget->ConditionalBeginDestroy();
+	if (SmallTarget)
+	{
+		SmallTarget->ConditionalBeginDestroy();
+	}
+	return Costs;
+}
+
+// ===================================================================
+// FLOW 1: SINGLE CAPTURE
+// ===================================================================
+
+void UMinimapGeneratorManager::StartSingleCaptureForValidation()
+{
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Starting single capture validation flow."));
+	const UWorld* World = GEditor->GetEditorWorldContext().World();
+	if (!World)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to start single capture: editor world is null."));
+		return;
+	}
+
+	// The single capture is one tile covering the whole image, so per-tile tooling can treat both flows alike.
+	TileLayout = FMinimapTileLayout::MakeUniform(FIntPoint(Settings.OutputWidth, Settings.OutputHeight),
+	                                             FMath::Max(Settings.OutputWidth, Settings.OutputHeight), 0);
+	LoadCaptureRegion();
+
+	ActiveRenderTarget = AcquireTileRenderTarget(FIntPoint(Settings.OutputWidth, Settings.OutputHeight));
+	if (!ActiveRenderTarget.IsValid())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%hs: AcquireTileRenderTarget() returned invalid target. Aborting."), __FUNCTION__);
+		OnCaptureComplete.Broadcast(false, TEXT("Failed to create render target."));
+		return;
+	}
+
+	{
+		FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::FilterBuild);
+		ActiveCaptureActor = AcquireCaptureActor(ActiveRenderTarget.Get());
+	}
+	if (!ActiveCaptureActor.IsValid())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%hs: AcquireCaptureActor() returned invalid actor. Aborting."), __FUNCTION__);
+		OnCaptureComplete.Broadcast(false, TEXT("Failed to spawn capture actor."));
+		return;
+	}
+
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: Calling CaptureScene()..."), __FUNCTION__);
+	TileCaptureStartSeconds = FPlatformTime::Seconds();
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapTileRender);
+		TileGpuTimer->Begin();
+		ActiveCaptureActor->GetCaptureComponent2D()->CaptureScene();
+		TileGpuTimer->End();
+		TileGpuTimer->Resolve();
+
+		// Flush the rendering pipeline so the render target is fully populated before scheduling readback.
+		// This is critical on macOS Metal where async capture may not complete in time.
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: Flushing rendering commands..."), __FUNCTION__);
+		FlushRenderingCommands();
+	}
+	TileRenderSeconds = FPlatformTime::Seconds() - TileCaptureStartSeconds;
+	CaptureReport.AddStageSeconds(MinimapCaptureStage::Render, TileRenderSeconds);
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: FlushRenderingCommands() completed. Scheduling ReadPixelsAndFinalize for next tick."), __FUNCTION__);
+
+	GEditor->GetTimerManager()->SetTimerForNextTick(this, &UMinimapGeneratorManager::ReadPixelsAndFinalize);
+}
+
+// ===================================================================
+// SHARED HELPER FUNCTIONS
+// ===================================================================
+
+namespace MinimapPreview
+{
+	/** Longest side of the one-shot coarse pass. */
+	constexpr int32 CoarseSize = 512;
+	/** Longest side the preview refines to; larger outputs are previewed scaled down. */
+	constexpr int32 MaxRefinedSize = 4096;
+
+	static FMinimapCaptureSettings ScaleOutput(const FMinimapCaptureSettings& InSettings, const int32 MaxSize)
+	{
+		FMinimapCaptureSettings Scaled = InSettings;
+		const int32 LongestSide = FMath::Max(InSettings.OutputWidth, InSettings.OutputHeight);
+		if (LongestSide > MaxSize)
+		{
+			Scaled.OutputWidth = FMath::Max(1, FMath::RoundToInt(static_cast<double>(InSettings.OutputWidth) * MaxSize / LongestSide));
+			Scaled.OutputHeight = FMath::Max(1, FMath::RoundToInt(static_cast<double>(InSettings.OutputHeight) * MaxSize / LongestSide));
+		}
+		return Scaled;
+	}
+}
+
+void UMinimapGeneratorManager::StartProgressivePreview(const FMinimapCaptureSettings& InSettings, const FVector& FocusLocation)
+{
+	bIsShuttingDown = false;
+	bCancelRequested = false;
+	bMergingShards = false;
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("[%s::%s] - Starting progressive preview."), *GetName(), *FString(__FUNCTION__));
+	CaptureReport.Reset();
+	TileGpuTimer = MakeShared<FMinimapGpuTimer, ESPMode::ThreadSafe>();
+
+	if (!InSettings.CaptureBounds.IsValid || InSettings.OutputWidth <= 0 || InSettings.OutputHeight <= 0)
+	{
+		OnCaptureComplete.Broadcast(false, TEXT("Invalid capture bounds or output size."));
+		return;
+	}
+
+	// The refinement renders the preview canvas with the regular tiled layout. Tiles are copied without feathering,
+	// in any order, so overlap would only cost render time.
+	FMinimapCaptureSettings RefineSettings = MinimapPreview::ScaleOutput(InSettings, MinimapPreview::MaxRefinedSize);
+	RefineSettings.bUseTiling = true;
+	RefineSettings.TileSourceType = EMinimapTileSourceType::SceneCapture;
+	RefineSettings.TileOverlap = 0;
+	RefineSettings.bSaveTiles = false;
+	RefineSettings.NumCaptureShards = 1;
+	RefineSettings.bPersistentViewState = false;
+	RefineSettings.bPrestreamTiles = false;
+	RefineSettings.AdditionalBuffers.Empty();
+	RefineSettings.Floors.Empty();
+	if (RefineSettings.TileResolution <= 0)
+	{
+		OnCaptureComplete.Broadcast(false, TEXT("Invalid tiling settings."));
+		return;
+	}
+	PreviewCanvasSize = FIntPoint(RefineSettings.OutputWidth, RefineSettings.OutputHeight);
+
+	// Framing mistakes show up here, typically well under a second after the click.
+	OnProgress.Broadcast(FText::FromString(TEXT("Capturing coarse preview...")), 0.0f, 0, 1);
+	Settings = MinimapPreview::ScaleOutput(RefineSettings, MinimapPreview::CoarseSize);
+	FString Error;
+	{
+		FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::Render);
+		if (!CaptureCoarsePreview(PreviewCanvasSize, Error))
+		{
+			CleanupCaptureResources();
+			OnCaptureComplete.Broadcast(false, Error);
+			return;
+		}
+	}
+	OnPreviewUpdated.Broadcast(PreviewCanvas, PreviewCanvasSize, FIntRect(FIntPoint::ZeroValue, PreviewCanvasSize));
+
+	Settings = RefineSettings;
+	CalculateGrid();
+	FMinimapTileSourceContext Context;
+	Context.Settings = Settings;
+	Context.Layout = TileLayout;
+	Context.WorldUnitsPerPixel = GetWorldUnitsPerPixel();
+	TileSource = MakeShared<FMinimapSceneCaptureTileSource>(*this);
+	if (!TileSource->Begin(Context, Error))
+	{
+		CleanupCaptureResources();
+		OnCaptureComplete.Broadcast(false, Error);
+		return;
+	}
+	if (Settings.bSkipEmptyTiles)
+	{
+		GatherVisibleActors(ActiveCaptureActor.IsValid() ? ActiveCaptureActor->GetCaptureComponent2D() : nullptr, Context.VisibleActors);
+		BuildPrimitiveBoundsIndex(Context.VisibleActors);
+	}
+
+	const double WorldUnitsPerPixel = Context.WorldUnitsPerPixel;
+	PreviewFocus = FVector2D(
+		FMath::Clamp((FocusLocation.X - Settings.CaptureBounds.Min.X) / WorldUnitsPerPixel, 0.0, static_cast<double>(PreviewCanvasSize.X)),
+		FMath::Clamp((FocusLocation.Y - Settings.CaptureBounds.Min.Y) / WorldUnitsPerPixel, 0.0, static_cast<double>(PreviewCanvasSize.Y)));
+	PreviewTileOrder.Reset(TileLayout.GetNumTiles());
+	for (int32 TileIndex = 0; TileIndex < TileLayout.GetNumTiles(); ++TileIndex)
+	{
+		if (!ShouldSkipTile(TileIndex))
+		{
+			PreviewTileOrder.Add(TileIndex);
+		}
+	}
+	SortPreviewTiles();
+	NumRefinedPreviewTiles = 0;
+	RefineNextPreviewTile();
 }
 
-UMinimapDefinitionDataAsset* UMinimapGeneratorManager::CreateOrUpdateDefinitionAsset(const FString& SavedImagePath, UTexture2D* BaseMapTexture) const
+bool UMinimapGeneratorManager::CaptureCoarsePreview(const FIntPoint& CanvasSize, FString& OutError)
+{
+	FMinimapTileSourceContext Context;
+	Context.Settings = Settings;
+	Context.Layout = FMinimapTileLayout::Plan(FIntPoint(Settings.OutputWidth, Settings.OutputHeight), 0, MinimapPreview::CoarseSize);
+	Context.WorldUnitsPerPixel = GetWorldUnitsPerPixel();
+
+	// Read back right away instead of waiting on streaming: this pass is for checking the framing, not the detail.
+	FMinimapSceneCaptureTileSource Source(*this);
+	TArray<FColor> TilePixels;
+	double ReadDelaySeconds = 0.0;
+	const bool bCaptured = Source.Begin(Context, OutError) && Source.RequestTile(0, ReadDelaySeconds, OutError) &&
+		Source.ReadTile(0, TilePixels, OutError);
+	Source.End();
+	const FIntPoint TileSize = Context.GetTileSize(0);
+	if (!bCaptured || TilePixels.Num() != TileSize.X * TileSize.Y)
+	{
+		OutError = bCaptured ? TEXT("The coarse preview capture returned no pixels.") : OutError;
+		return false;
+	}
+
+	// Turn portrait captures upright, then stretch the coarse image over the whole preview canvas.
+	const FIntPoint CoarseSize = Context.Layout.OutputSize;
+	TArray<FColor> CoarseCanvas;
+	CoarseCanvas.SetNumUninitialized(CoarseSize.X * CoarseSize.Y);
+	MinimapImageKernels::FTilePlacement Placement;
+	Placement.bRotateClockwise = Context.IsPortrait();
+	MinimapImageKernels::CompositeTile(CoarseCanvas, CoarseSize, TilePixels, TileSize, Placement);
+
+	PreviewCanvas.SetNumUninitialized(CanvasSize.X * CanvasSize.Y);
+	MinimapImageKernels::ResizeNearest(CoarseCanvas, CoarseSize, PreviewCanvas, CanvasSize);
+	return true;
+}
+
+void UMinimapGeneratorManager::SetPreviewFocus(const FVector2D& FocusUV)
+{
+	PreviewFocus = FVector2D(FMath::Clamp(FocusUV.X, 0.0, 1.0) * PreviewCanvasSize.X, FMath::Clamp(FocusUV.Y, 0.0, 1.0) * PreviewCanvasSize.Y);
+	SortPreviewTiles();
+}
+
+void UMinimapGeneratorManager::SortPreviewTiles()
+{
+	const FMinimapTileLayout& Layout = TileLayout;
+	const FVector2D Focus = PreviewFocus;
+	PreviewTileOrder.Sort([&Layout, Focus](const int32 A, const int32 B)
+	{
+		auto DistanceSquared = [&Layout, Focus](const int32 TileIndex)
+		{
+			const FIntPoint TileCoord = Layout.GetTileCoord(TileIndex);
+			const FIntRect TileRect = Layout.GetTileRect(TileCoord.X, TileCoord.Y);
+			return FVector2D::DistSquared(FVector2D(TileRect.Min + TileRect.Max) * 0.5, Focus);
+		};
+		return DistanceSquared(A) > DistanceSquared(B);
+	});
+}
+
+void UMinimapGeneratorManager::RefineNextPreviewTile()
+{
+	if (bCancelRequested || !TileSource.IsValid()) return;
+
+	if (PreviewTileOrder.Num() == 0)
+	{
+		FinishProgressivePreview();
+		return;
+	}
+
+	CurrentTileIndex = PreviewTileOrder.Pop(EAllowShrinking::No);
+	TileCaptureStartSeconds = FPlatformTime::Seconds();
+	double ReadDelaySeconds = 0.0;
+	FString Error;
+	bool bRequested;
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapTileRender);
+		bRequested = TileSource->RequestTile(CurrentTileIndex, ReadDelaySeconds, Error);
+	}
+	if (!bRequested)
+	{
+		CleanupCaptureResources();
+		OnCaptureComplete.Broadcast(false, Error);
+		return;
+	}
+	CaptureReport.AddStageSeconds(MinimapCaptureStage::Render, FPlatformTime::Seconds() - TileCaptureStartSeconds);
+
+	const int32 NumTiles = NumRefinedPreviewTiles + PreviewTileOrder.Num() + 1;
+	OnProgress.Broadcast(
+		FText::Format(FText::FromString(TEXT("Refining preview tile {0}/{1}...")), FText::AsNumber(NumRefinedPreviewTiles + 1),
+		              FText::AsNumber(NumTiles)),
+		static_cast<float>(NumRefinedPreviewTiles) / NumTiles,
+		NumRefinedPreviewTiles,
+		NumTiles);
+
+	if (ReadDelaySeconds > 0.0)
+	{
+		FTimerHandle TempHandle;
+		GEditor->GetTimerManager()->SetTimer(
+			TempHandle, this, &UMinimapGeneratorManager::OnPreviewTileRendered, static_cast<float>(ReadDelaySeconds), false);
+	}
+	else
+	{
+		GEditor->GetTimerManager()->SetTimerForNextTick(this, &UMinimapGeneratorManager::OnPreviewTileRendered);
+	}
+}
+
+void UMinimapGeneratorManager::OnPreviewTileRendered()
+{
+	if (bCancelRequested || !TileSource.IsValid()) return;
+
+	TArray<FColor> TilePixels;
+	FString Error;
+	bool bRead;
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapReadback);
+		FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::Readback);
+		bRead = TileSource->ReadTile(CurrentTileIndex, TilePixels, Error);
+	}
+	if (!bRead)
+	{
+		CleanupCaptureResources();
+		OnCaptureComplete.Broadcast(false, Error);
+		return;
+	}
+
+	const FIntPoint TileCoord = TileLayout.GetTileCoord(CurrentTileIndex);
+	const FIntRect TileRect = TileLayout.GetTileRect(TileCoord.X, TileCoord.Y);
+	const FIntPoint TileSize = GetTileRenderTargetSize(TileRect);
+	if (TilePixels.Num() == TileSize.X * TileSize.Y)
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapComposite);
+		MinimapImageKernels::FTilePlacement Placement;
+		Placement.Offset = TileRect.Min;
+		Placement.bRotateClockwise = Settings.OutputHeight > Settings.OutputWidth;
+		MinimapImageKernels::CompositeTile(PreviewCanvas, PreviewCanvasSize, TilePixels, TileSize, Placement);
+		OnPreviewUpdated.Broadcast(PreviewCanvas, PreviewCanvasSize, TileRect);
+	}
+	else
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Preview tile %d rendered with empty pixel data."), CurrentTileIndex);
+	}
+
+	NumRefinedPreviewTiles++;
+	RefineNextPreviewTile();
+}
+
+void UMinimapGeneratorManager::FinishProgressivePreview()
+{
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Progressive preview refined %d tiles of %s."), NumRefinedPreviewTiles, *TileLayout.ToString());
+	CleanupCaptureResources();
+	OnProgress.Broadcast(FText::FromString(TEXT("Preview complete.")), 1.0f, NumRefinedPreviewTiles, NumRefinedPreviewTiles);
+	OnCaptureComplete.Broadcast(true, FString());
+}
+
+FString UMinimapGeneratorManager::MakeTextureAssetPath(const FString& ImagePath) const
+{
+	FString PackagePath = Settings.AssetPath;
+	if (!PackagePath.StartsWith(TEXT("/Game")))
+	{
+		PackagePath = TEXT("/Game/Minimaps/");
+	}
+	if (!PackagePath.EndsWith(TEXT("/")))
+	{
+		PackagePath += TEXT("/");
+	}
+	return PackagePath + TEXT("T_") + FPaths::GetBaseFilename(ImagePath);
+}
+
+FString UMinimapGeneratorManager::MakeDefinitionAssetPath(const FString& ImagePath) const
 {
 	FString PackagePath = Settings.DefinitionAssetPath;
 	if (!PackagePath.StartsWith(TEXT("/Game")))
@@ -395,9 +1407,97 @@ UMinimapDefinitionDataAsset* UMinimapGeneratorManager::CreateOrUpdateDefinitionA
 	{
 		PackagePath += TEXT("/");
 	}
+	return PackagePath + TEXT("DA_") + FPaths::GetBaseFilename(ImagePath);
+}
+
+UTexture2D* UMinimapGeneratorManager::ImportTextureAssetFromSavedImage(const FString& SavedImagePath) const
+{
+	if (SavedImagePath.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	FMinimapDecodedImage Image;
+	if (FString Error; !MinimapTextureSource::DecodeImageFile(SavedImagePath, Image, Error))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%s"), *Error);
+		return nullptr;
+	}
+	return ImportDecodedTexture(Image);
+}
 
-	const FString AssetName = TEXT("DA_") + FPaths::GetBaseFilename(SavedImagePath);
-	const FString FullAssetPath = PackagePath + AssetName;
+UTexture2D* UMinimapGeneratorManager::ImportDecodedTexture(FMinimapDecodedImage& Image) const
+{
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: Starting texture asset import..."), __FUNCTION__);
+	const double ImportStartTime = FPlatformTime::Seconds();
+
+	const FString FullAssetPath = MakeTextureAssetPath(Image.Path);
+	UTexture2D* NewTexture = FindOrCreateTextureAsset(FullAssetPath);
+	UPackage* Package = NewTexture->GetPackage();
+	// A texture last exported as UDIM pages goes back to a single streamed texture.
+	const bool bWasPaged = NewTexture->Source.GetNumBlocks() > 1;
+	if (bWasPaged)
+	{
+		NewTexture->VirtualTextureStreaming = false;
+	}
+
+	// Re-exporting an identical map skips the rebuild; any change rebuilds the whole texture.
+	// The file itself becomes the source payload, so the package does not store the decoded pixels. Reading such a
+	// source back would mean decoding it here, so the same file is recognized by its hash and a compressed source that
+	// does not match it is replaced without comparing pixels.
+	const ETextureSourceCompressionFormat SourceCompression = Image.BitDepth == 8 ? MinimapTextureSource::GetCompressionFormat(Image.Format) : TSCF_None;
+	TArray<FIntRect> ChangedRects;
+	EMinimapTextureSourceUpdate SourceUpdate = EMinimapTextureSourceUpdate::Unchanged;
+	if (!MinimapTextureSource::IsImportedFile(*NewTexture, Image.FileHash, Image.Size))
+	{
+		SourceUpdate = MinimapTextureSource::Update(*NewTexture, Image.GetPixels(), Image.Size, FIntRect(FIntPoint::ZeroValue, Image.Size),
+			ChangedRects, Image.FileData, SourceCompression);
+		MinimapTextureSource::SetImportedFile(*NewTexture, Image.Path, Image.FileHash);
+	}
+	const bool bSettingsChanged = bWasPaged || !NewTexture->SRGB || NewTexture->CompressionSettings != TC_Default;
+	const double ImportDuration = FPlatformTime::Seconds() - ImportStartTime;
+	if (SourceUpdate == EMinimapTextureSourceUpdate::Unchanged && !bSettingsChanged)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Minimap texture asset %s is unchanged; not rebuilt (%.2fs decode, %.2fs import)"),
+			*FullAssetPath, Image.DecodeSeconds, ImportDuration);
+		return NewTexture;
+	}
+
+	// PostEditChange hands the mip build and platform compression to the texture compiler, which runs them on workers
+	// and streams the result in when it is done; the editor shows a placeholder until then.
+	NewTexture->SRGB = true;
+	NewTexture->CompressionSettings = TC_Default;
+	NewTexture->PostEditChange();
+	NewTexture->MarkPackageDirty();
+	Package->MarkPackageDirty();
+
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Imported minimap texture asset: %s, %.1f%% of the image changed (%.2fs decode, %.2fs import)"),
+		*FullAssetPath, MinimapTextureSource::GetChangedFraction(ChangedRects, Image.Size) * 100.0, Image.DecodeSeconds, ImportDuration);
+
+	return NewTexture;
+}
+
+UTexture2D* UMinimapGeneratorManager::FindOrCreateTextureAsset(const FString& FullAssetPath) const
+{
+	const FString AssetName = FPackageName::GetShortName(FullAssetPath);
+	UPackage* Package = CreatePackage(*FullAssetPath);
+	Package->FullyLoad();
+
+	UTexture2D* Texture = FindObject<UTexture2D>(Package, *AssetName);
+	if (!Texture)
+	{
+		Texture = NewObject<UTexture2D>(Package, *AssetName, RF_Public | RF_Standalone);
+		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+		AssetRegistryModule.AssetCreated(Texture);
+	}
+	return Texture;
+}
+
+UMinimapDefinitionDataAsset* UMinimapGeneratorManager::CreateOrUpdateDefinitionAsset(const FString& SavedImagePath, UTexture2D* BaseMapTexture,
+                                                                                      const TArray<FMinimapFloor>& Floors) const
+{
+	const FString FullAssetPath = MakeDefinitionAssetPath(SavedImagePath);
+	const FString AssetName = FPackageName::GetShortName(FullAssetPath);
 	UPackage* Package = CreatePackage(*FullAssetPath);
 	Package->FullyLoad();
 
@@ -414,6 +1514,18 @@ UMinimapDefinitionDataAsset* UMinimapGeneratorManager::CreateOrUpdateDefinitionA
 	DefinitionAsset->OutputSize = FIntPoint(Settings.OutputWidth, Settings.OutputHeight);
 	DefinitionAsset->MapRotationDegrees = Settings.CameraRotation.Yaw;
 	DefinitionAsset->OverlayLayers = Settings.OverlayLayers;
+	DefinitionAsset->Floors = Floors;
+	DefinitionAsset->TextureMode = Settings.TextureMode;
+	if (Settings.TextureMode == EMinimapTextureMode::VirtualTextureUDIM)
+	{
+		DefinitionAsset->UDIMPageSize = Settings.UDIMPageSize;
+		DefinitionAsset->UDIMPageCount = MinimapTextureSource::GetPageCount(DefinitionAsset->OutputSize, Settings.UDIMPageSize);
+	}
+	else
+	{
+		DefinitionAsset->UDIMPageSize = 0;
+		DefinitionAsset->UDIMPageCount = FIntPoint::ZeroValue;
+	}
 	DefinitionAsset->MarkPackageDirty();
 	Package->MarkPackageDirty();
 
@@ -427,6 +1539,7 @@ void UMinimapGeneratorManager::CleanupCaptureResources()
 	{
 		GEditor->GetTimerManager()->ClearTimer(ReadbackPollTimer);
 		GEditor->GetTimerManager()->ClearTimer(StreamingCheckTimer);
+		GEditor->GetTimerManager()->ClearTimer(ShardPollTimer);
 	}
 
 	if (ScreenshotCapturedDelegateHandle.IsValid())
@@ -435,49 +1548,104 @@ void UMinimapGeneratorManager::CleanupCaptureResources()
 		ScreenshotCapturedDelegateHandle.Reset();
 	}
 
-	if (ActiveCaptureActor.IsValid())
+	TerminateShardWorkers();
+	BufferTileStores.Empty();
+	FloorTileStores.Empty();
+	PatchTexture.Reset();
+	if (TileSource.IsValid())
 	{
-		ActiveCaptureActor->Destroy();
+		TileSource->End();
+		TileSource.Reset();
 	}
-	ActiveCaptureActor.Reset();
-
-	if (ActiveRenderTarget.IsValid())
+	if (MinimapStreamer.IsValid())
 	{
-		ActiveRenderTarget->ConditionalBeginDestroy();
+		MinimapStreamer->ReleaseRegion();
 	}
-	ActiveRenderTarget.Reset();
+
+	ReleaseCaptureActor();
+	ReleaseRenderTargets();
+	PrimitiveBoundsIndex.Reset();
+	PreviewTileOrder.Reset();
+	PreviewCanvas.Empty();
 	StagingPixelBuffer.Empty();
+	StagingPixelBufferBytes.Reset();
 }
 
-UTextureRenderTarget2D* UMinimapGeneratorManager::CreateRenderTarget() const
+UTextureRenderTarget2D* UMinimapGeneratorManager::CreateRenderTarget(const FIntPoint& Size) const
 {
-	const int32 TargetWidth = Settings.bUseTiling ? Settings.TileResolution : Settings.OutputWidth;
-	const int32 TargetHeight = Settings.bUseTiling ? Settings.TileResolution : Settings.OutputHeight;
+	const int32 TargetWidth = Size.X;
+	const int32 TargetHeight = Size.Y;
 
 	UTextureRenderTarget2D* RenderTarget = NewObject<UTextureRenderTarget2D>();
+	RenderTarget->ClearColor = GetRenderTargetClearColor();
 
-	if (Settings.BackgroundMode == EMinimapBackgroundMode::Transparent)
+	// Use PF_B8G8R8A8 instead of PF_FloatRGBA. Float targets have limited readback support
+	// on macOS Metal, and the output is FColor (8-bit BGRA) anyway — no precision is lost.
+	RenderTarget->InitCustomFormat(TargetWidth, TargetHeight, PF_B8G8R8A8, true);
+
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Created Render Target (%dx%d)."), TargetWidth, TargetHeight);
+	return RenderTarget;
+}
+
+FLinearColor UMinimapGeneratorManager::GetRenderTargetClearColor() const
+{
+	return Settings.BackgroundMode == EMinimapBackgroundMode::Transparent ? FLinearColor::Transparent : Settings.BackgroundColor;
+}
+
+ASceneCapture2D* UMinimapGeneratorManager::SpawnAndConfigureCaptureActor(UTextureRenderTarget2D* RenderTarget) const
+{
+	UWorld* World = GEditor->GetEditorWorldContext().World();
+	if (!World || !RenderTarget) return nullptr;
+
+	ASceneCapture2D* CaptureActor = World->SpawnActor<ASceneCapture2D>(FVector::ZeroVector, Settings.CameraRotation);
+	if (!CaptureActor)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%hs: Failed to spawn ASceneCapture2D actor."), __FUNCTION__);
+		return nullptr;
+	}
+	ConfigureCaptureActor(*CaptureActor, RenderTarget);
+	return CaptureActor;
+}
+
+ASceneCapture2D* UMinimapGeneratorManager::AcquireCaptureActor(UTextureRenderTarget2D* RenderTarget)
+{
+	ASceneCapture2D* CaptureActor = RetainedCaptureActor.Get();
+	RetainedCaptureActor.Reset();
+
+	// A level opened since the last capture has taken the retained actor's world with it.
+	if (CaptureActor && RenderTarget && CaptureActor->GetWorld() == GEditor->GetEditorWorldContext().World())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: Reusing retained SceneCapture2D."), __FUNCTION__);
+		ConfigureCaptureActor(*CaptureActor, RenderTarget);
+		return CaptureActor;
+	}
+
+	if (CaptureActor)
 	{
-		RenderTarget->ClearColor = FLinearColor::Transparent;
+		CaptureActor->Destroy();
 	}
-	else // SolidColor
+	return SpawnAndConfigureCaptureActor(RenderTarget);
+}
+
+void UMinimapGeneratorManager::ReleaseCaptureActor()
+{
+	if (ASceneCapture2D* CaptureActor = ActiveCaptureActor.Get())
 	{
-		RenderTarget->ClearColor = Settings.BackgroundColor;
+		if (bRetainCaptureResources && !bIsShuttingDown)
+		{
+			CaptureActor->GetCaptureComponent2D()->TextureTarget = nullptr;
+			RetainedCaptureActor = CaptureActor;
+		}
+		else
+		{
+			CaptureActor->Destroy();
+		}
 	}
-
-	// Use PF_B8G8R8A8 instead of PF_FloatRGBA. Float targets have limited readback support
-	// on macOS Metal, and the output is FColor (8-bit BGRA) anyway — no precision is lost.
-	RenderTarget->InitCustomFormat(TargetWidth, TargetHeight, PF_B8G8R8A8, true);
-
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Created Render Target (%dx%d)."), TargetWidth, TargetHeight);
-	return RenderTarget;
+	ActiveCaptureActor.Reset();
 }
 
-ASceneCapture2D* UMinimapGeneratorManager::SpawnAndConfigureCaptureActor(UTextureRenderTarget2D* RenderTarget) const
+void UMinimapGeneratorManager::ConfigureCaptureActor(ASceneCapture2D& CaptureActor, UTextureRenderTarget2D* RenderTarget) const
 {
-	UWorld* World = GEditor->GetEditorWorldContext().World();
-	if (!World || !RenderTarget) return nullptr;
-
 	const FVector BoundsSize = Settings.CaptureBounds.GetSize();
 	const FVector BoundsCenter = Settings.CaptureBounds.GetCenter();
 	const FVector CameraLocation = FVector(BoundsCenter.X, BoundsCenter.Y, Settings.CameraHeight);
@@ -496,22 +1664,17 @@ ASceneCapture2D* UMinimapGeneratorManager::SpawnAndConfigureCaptureActor(UTextur
 		CameraOrthoWidth = FMath::Max(BoundsSize.Y, BoundsSize.X / OutputAspectRatio);
 	}
 
-	ASceneCapture2D* CaptureActor = World->SpawnActor<ASceneCapture2D>(CameraLocation, CameraRotation);
-	if (!CaptureActor)
-	{
-		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%hs: Failed to spawn ASceneCapture2D actor."), __FUNCTION__);
-		return nullptr;
-	}
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: Spawned SceneCapture2D at (%s), OrthoWidth=%.2f"),
+	CaptureActor.SetActorLocationAndRotation(CameraLocation, CameraRotation);
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: SceneCapture2D at (%s), OrthoWidth=%.2f"),
 		__FUNCTION__, *CameraLocation.ToString(), CameraOrthoWidth);
 
-	USceneCaptureComponent2D* CaptureComponent = CaptureActor->GetCaptureComponent2D();
+	USceneCaptureComponent2D* CaptureComponent = CaptureActor.GetCaptureComponent2D();
 	// FILTERING
 	TArray<AActor*> FinalShowList;
 	BuildFinalShowOnlyList(FinalShowList);
 
-	// CaptureComponent->ShowFlags = FEngineShowFlags(ESFIM_Editor);
-	CaptureComponent->ShowFlags.SetDynamicShadows(Settings.bCaptureDynamicShadows);
+	// Start from the component defaults: a reused actor still carries the show flags of the previous capture's profile.
+	CaptureComponent->ShowFlags = MinimapCaptureProfiles::MakeShowFlags(Settings, GetDefault<USceneCaptureComponent2D>()->ShowFlags);
 	const bool bHasFiltering = Settings.ShowOnlyActors.Num() > 0 || Settings.HiddenActors.Num() > 0 || Settings.ActorClassFilter || !Settings.ActorTagFilter.IsNone();
 	CaptureComponent->PrimitiveRenderMode = bHasFiltering ? ESceneCapturePrimitiveRenderMode::PRM_UseShowOnlyList : Settings.PrimitiveRenderMode;
 	CaptureComponent->ShowOnlyActors = (CaptureComponent->PrimitiveRenderMode == ESceneCapturePrimitiveRenderMode::PRM_UseShowOnlyList) ? FinalShowList : TArray<AActor*>();
@@ -520,25 +1683,20 @@ ASceneCapture2D* UMinimapGeneratorManager::SpawnAndConfigureCaptureActor(UTextur
 
 	CaptureComponent->bCaptureEveryFrame = false;
 	CaptureComponent->bCaptureOnMovement = false;
+	CaptureComponent->bAlwaysPersistRenderingState = Settings.bUseTiling && Settings.bPersistentViewState;
 	CaptureComponent->TextureTarget = RenderTarget;
 	CaptureComponent->ProjectionType = Settings.bIsOrthographic ? ECameraProjectionMode::Orthographic : ECameraProjectionMode::Perspective;
 	CaptureComponent->OrthoWidth = CameraOrthoWidth;
 	CaptureComponent->FOVAngle = Settings.CameraFOV;
 	CaptureComponent->CompositeMode = SCCM_Overwrite;
+	// A reused actor still carries the overrides of the previous capture.
+	CaptureComponent->PostProcessSettings = FPostProcessSettings();
+
+	MinimapCaptureProfiles::ApplyPostProcessOverrides(Settings, CaptureComponent->PostProcessSettings);
 
 	if (Settings.bOverrideWithHighQualitySettings)
 	{
 		CaptureComponent->CaptureSource = Settings.CaptureSource;
-
-		FPostProcessSettings& PPSettings = CaptureComponent->PostProcessSettings;
-		PPSettings.bOverride_AmbientOcclusionIntensity = true;
-		PPSettings.AmbientOcclusionIntensity = Settings.AmbientOcclusionIntensity;
-		PPSettings.bOverride_AmbientOcclusionQuality = true;
-		PPSettings.AmbientOcclusionQuality = Settings.AmbientOcclusionQuality;
-		PPSettings.bOverride_ScreenSpaceReflectionIntensity = true;
-		PPSettings.ScreenSpaceReflectionIntensity = Settings.ScreenSpaceReflectionIntensity;
-		PPSettings.bOverride_ScreenSpaceReflectionQuality = true;
-		PPSettings.ScreenSpaceReflectionQuality = Settings.ScreenSpaceReflectionQuality;
 	}
 	else
 	{
@@ -547,9 +1705,9 @@ ASceneCapture2D* UMinimapGeneratorManager::SpawnAndConfigureCaptureActor(UTextur
 		// CaptureComponent->CaptureSource = SCS_SceneColorHDRNoAlpha;
 	}
 
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: SceneCapture2D fully configured. CaptureSource=%d, ShowOnlyActors=%d"),
-		__FUNCTION__, static_cast<int32>(CaptureComponent->CaptureSource), CaptureComponent->ShowOnlyActors.Num());
-	return CaptureActor;
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: SceneCapture2D fully configured. Profile=%s, CaptureSource=%d, ShowOnlyActors=%d"),
+		__FUNCTION__, *UEnum::GetValueAsString(Settings.CaptureProfile), static_cast<int32>(CaptureComponent->CaptureSource),
+		CaptureComponent->ShowOnlyActors.Num());
 }
 
 void UMinimapGeneratorManager::ReadPixelsAndFinalize()
@@ -573,8 +1731,12 @@ void UMinimapGeneratorManager::ReadPixelsAndFinalize()
 		__FUNCTION__, RenderTargetResource->GetSizeX(), RenderTargetResource->GetSizeY(),
 		static_cast<int32>(RenderTarget->GetFormat()));
 
-	StagingPixelBuffer.Reset();
-	StagingPixelBuffer.AddUninitialized(Settings.OutputWidth * Settings.OutputHeight);
+	{
+		LLM_SCOPE_BYTAG(MinimapGenerator_StagingPixelBuffer);
+		StagingPixelBuffer.Reset();
+		StagingPixelBuffer.AddUninitialized(Settings.OutputWidth * Settings.OutputHeight);
+		StagingPixelBufferBytes = FMinimapTrackedBytes(EMinimapMemoryTag::StagingPixelBuffer, StagingPixelBuffer.GetAllocatedSize());
+	}
 
 	ENQUEUE_RENDER_COMMAND(ReadPixelsCommand)(
 		[RenderTargetResource, PixelBuffer = &this->StagingPixelBuffer](
@@ -595,7 +1757,7 @@ void UMinimapGeneratorManager::ReadPixelsAndFinalize()
 
 	GEditor->GetTimerManager()->SetTimer(ReadbackPollTimer, this, &UMinimapGeneratorManager::CheckReadbackStatus, 0.1f, true);
 
-	OnProgress.Broadcast(FText::FromString(TEXT("GPU is rendering... Editor remains responsive.")), 0.5f, 0, 0);
+	OnProgress.Broadcast(WithMemoryHighWater(FText::FromString(TEXT("GPU is rendering... Editor remains responsive."))), 0.5f, 0, 0);
 }
 
 void UMinimapGeneratorManager::CheckReadbackStatus()
@@ -631,30 +1793,34 @@ void UMinimapGeneratorManager::CheckReadbackStatus()
 			__FUNCTION__, ReadbackPollCount);
 		GEditor->GetTimerManager()->ClearTimer(ReadbackPollTimer);
 
-		if (ActiveCaptureActor.IsValid())
-		{
-			ActiveCaptureActor->Destroy();
-		}
-		ActiveCaptureActor.Reset();
-
-		if (ActiveRenderTarget.IsValid())
-		{
-			ActiveRenderTarget->ConditionalBeginDestroy();
-		}
-		ActiveRenderTarget.Reset();
+		ReleaseCaptureActor();
+		ReleaseRenderTargets();
+
+		// The single capture is reported as one tile; its readback spans the fence polling.
+		FMinimapTileStats TileStats;
+		TileStats.TileIndex = 0;
+		TileStats.Size = FIntPoint(Settings.OutputWidth, Settings.OutputHeight);
+		TileStats.RenderSeconds = TileRenderSeconds;
+		TileStats.GpuRenderSeconds = TileGpuTimer->GetElapsedSeconds();
+		TileStats.LatencySeconds = FPlatformTime::Seconds() - TileCaptureStartSeconds;
+		TileStats.ReadbackSeconds = TileStats.LatencySeconds - TileRenderSeconds;
+		CaptureReport.Tiles.Add(TileStats);
+		CaptureReport.AddStageSeconds(MinimapCaptureStage::Readback, TileStats.ReadbackSeconds);
+		CaptureReport.SampleMemory();
 
 		if (StagingPixelBuffer.Num() > 0)
 		{
 			UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: GPU readback complete. Pixel buffer has %d pixels. Starting async save task."),
 				__FUNCTION__, StagingPixelBuffer.Num());
-			StartImageSaveTask(MoveTemp(StagingPixelBuffer), Settings.OutputWidth, Settings.OutputHeight);
+			StartImageSaveTask(MoveTemp(StagingPixelBuffer), MoveTemp(StagingPixelBufferBytes), Settings.OutputWidth, Settings.OutputHeight,
+			                   MakeOutputBasePath());
 
 			// MoveTemp transfers data ownership but does not release allocated capacity.
 			// Explicitly free the ~64MB staging buffer.
 			StagingPixelBuffer.Empty();
 
 			UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%hs: Cleanup completed. All capture resources released."), __FUNCTION__);
-			OnProgress.Broadcast(FText::FromString(TEXT("Saving image...")), 0.95f, 0, 0);
+			OnProgress.Broadcast(WithMemoryHighWater(FText::FromString(TEXT("Saving image..."))), 0.95f, 0, 0);
 		}
 		else
 		{
@@ -664,7 +1830,7 @@ void UMinimapGeneratorManager::CheckReadbackStatus()
 	}
 }
 
-void UMinimapGeneratorManager::StartImageSaveTask(TArray<FColor> PixelData, int32 ImageWidth, int32 ImageHeight)
+FString UMinimapGeneratorManager::MakeOutputBasePath() const
 {
 	FString FinalFileName = Settings.FileName;
 	if (Settings.bUseAutoFilename)
@@ -673,17 +1839,23 @@ void UMinimapGeneratorManager::StartImageSaveTask(TArray<FColor> PixelData, int3
 		const FString Timestamp = Now.ToString(TEXT("_%Y%m%d_%H%M%S"));
 		FinalFileName += Timestamp;
 	}
-	FinalFileName += TEXT(".png");
+	return FPaths::Combine(Settings.OutputPath, FinalFileName);
+}
 
-	const FString FullPath = FPaths::Combine(Settings.OutputPath, FinalFileName);
+void UMinimapGeneratorManager::StartImageSaveTask(TArray<FColor> PixelData, FMinimapTrackedBytes PixelDataBytes, int32 ImageWidth,
+                                                  int32 ImageHeight, const FString& OutputBasePath, const bool bKeepEncodedImage)
+{
+	const FString FullPath = OutputBasePath + TEXT(".png");
 	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Starting async image save task: %s (%dx%d)."), *FullPath, ImageWidth, ImageHeight);
 
-	(new FAutoDeleteAsyncTask<FSaveImageTask>(MoveTemp(PixelData), ImageWidth, ImageHeight, FullPath, this))->
-		StartBackgroundTask();
+	(new FAutoDeleteAsyncTask<FSaveImageTask>(MoveTemp(PixelData), MoveTemp(PixelDataBytes), ImageWidth, ImageHeight, FullPath, this,
+		bKeepEncodedImage))->StartBackgroundTask();
+	OnRenderComplete.Broadcast();
 }
 
 void UMinimapGeneratorManager::BuildFinalShowOnlyList(TArray<AActor*>& OutShowOnlyList) const
 {
+	MINIMAP_STAGE_SCOPE(STAT_MinimapFilterBuild);
 	OutShowOnlyList.Empty();
 	UWorld* World = GEditor->GetEditorWorldContext().World();
 	if (!World) return;
@@ -727,189 +1899,775 @@ void UMinimapGeneratorManager::BuildFinalShowOnlyList(TArray<AActor*>& OutShowOn
 	UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
 	for (AActor* Actor : AllActors)
 	{
-		if (!Actor) continue;
+		if (!Actor) continue;
+
+		// Hide actors matching the class filter.
+		if (Settings.ActorClassFilter && Actor->IsA(Settings.ActorClassFilter))
+		{
+			ActorsToHide.Add(Actor);
+		}
+
+		// Hide actors matching the tag filter.
+		if (!Settings.ActorTagFilter.IsNone() && Actor->Tags.Contains(Settings.ActorTagFilter))
+		{
+			ActorsToHide.Add(Actor);
+		}
+	}
+
+	// 4) Final pass: keep only candidates that are not in the hide set.
+	for (AActor* Candidate : CandidateActors)
+	{
+		if (Candidate && !ActorsToHide.Contains(Candidate))
+		{
+			OutShowOnlyList.Add(Candidate);
+		}
+	}
+
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Built final ShowOnly list: %d actors (candidates: %d, hidden: %d)."),
+		OutShowOnlyList.Num(), CandidateActors.Num(), ActorsToHide.Num());
+}
+
+// ===================================================================
+// FLOW 2: TILED CAPTURE
+// ===================================================================
+
+void UMinimapGeneratorManager::StartTiledCaptureProcess()
+{
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Starting tiled capture process."));
+	CurrentTileIndex = 0;
+	PreparedTileIndex = INDEX_NONE;
+	NumSkippedTiles = 0;
+	NumUnavailableTiles = 0;
+	ActiveCaptureActor.Reset();
+	ActiveRenderTarget.Reset();
+
+	CalculateGrid();
+
+	if (!TileLayout.IsValid())
+	{
+		OnCaptureComplete.Broadcast(false, TEXT("Invalid grid size."));
+		return;
+	}
+
+	TileStore = MakeShared<FMinimapTileStore>(Settings.bCompressTilesInMemory);
+	TileStore->Reset(TileLayout.GetNumTiles());
+	BufferTileStores.Empty();
+	BufferSaveTasks.Empty();
+	for (const EMinimapCaptureBuffer Buffer : Settings.AdditionalBuffers)
+	{
+		if (!BufferTileStores.Contains(Buffer))
+		{
+			TSharedPtr<FMinimapTileStore>& Store = BufferTileStores.Add(Buffer, MakeShared<FMinimapTileStore>(Settings.bCompressTilesInMemory));
+			Store->Reset(TileLayout.GetNumTiles());
+		}
+	}
+	FloorTileStores.Empty();
+	FloorImagePaths.Empty();
+	for (int32 FloorIndex = 0; FloorIndex < Settings.Floors.Num(); ++FloorIndex)
+	{
+		TSharedPtr<FMinimapTileStore>& Store = FloorTileStores.Add_GetRef(MakeShared<FMinimapTileStore>(Settings.bCompressTilesInMemory));
+		Store->Reset(TileLayout.GetNumTiles());
+	}
+
+	OnProgress.Broadcast(FText::Format(FText::FromString(TEXT("Tile layout: {0}")), FText::FromString(TileLayout.ToString())),
+	                     0.0f, 0, TileLayout.GetNumTiles());
+
+	// Saved tiles plus the settings that produced them are all the capture commandlet needs to re-stitch them.
+	if (Settings.bSaveTiles)
+	{
+		const FString SettingsPath = FPaths::Combine(Settings.OutputPath, Settings.FileName + TEXT("_settings.json"));
+		if (WriteSettingsFile(Settings, SettingsPath).IsEmpty())
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Failed to write capture settings to %s"), *SettingsPath);
+		}
+	}
+
+	// The workers render the tiles; this editor comes back here to merge them once they have all exited.
+	const bool bShardCapture = Settings.NumCaptureShards > 1 && Settings.TileSourceType == EMinimapTileSourceType::SceneCapture && !bMergingShards;
+	if (bShardCapture && (BufferTileStores.Num() > 0 || FloorTileStores.Num() > 0))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Worker processes only capture the color tiles; rendering every buffer and floor in this editor instead."));
+	}
+	else if (bShardCapture)
+	{
+		FString Error;
+		if (!StartShardWorkers(Error))
+		{
+			OnCaptureComplete.Broadcast(false, Error);
+		}
+		return;
+	}
+
+	TileSource = CreateTileSource();
+	CaptureReport.TileSourceName = TileSource->GetName();
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Tile source: %s."), *CaptureReport.TileSourceName);
+	if (TileSource->ReadsWorld())
+	{
+		LoadCaptureRegion();
+	}
+	{
+		// Filter build covers the show-only list, the tile source setup (capture actor) and the primitive bounds index.
+		FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::FilterBuild);
+
+		// Sources that do not render the level (saved tiles, synthetic) produce every tile, so there is nothing to skip.
+		const bool bSkipEmptyTiles = Settings.bSkipEmptyTiles && TileSource->ReadsWorld();
+		FMinimapTileSourceContext Context;
+		Context.Settings = Settings;
+		Context.Layout = TileLayout;
+		Context.WorldUnitsPerPixel = GetWorldUnitsPerPixel();
+		if (TileSource->NeedsVisibleActors())
+		{
+			GatherVisibleActors(nullptr, Context.VisibleActors);
+		}
+
+		FString Error;
+		if (!TileSource->Begin(Context, Error))
+		{
+			OnCaptureComplete.Broadcast(false, Error);
+			return;
+		}
+
+		if (bSkipEmptyTiles)
+		{
+			// Reuse the capture component's show-only list when the source spawned one rather than filtering again.
+			if (!TileSource->NeedsVisibleActors())
+			{
+				GatherVisibleActors(ActiveCaptureActor.IsValid() ? ActiveCaptureActor->GetCaptureComponent2D() : nullptr, Context.VisibleActors);
+			}
+			BuildPrimitiveBoundsIndex(Context.VisibleActors);
+		}
+	}
+	CaptureReport.SampleMemory();
+
+	CaptureNextTile();
+}
+
+void UMinimapGeneratorManager::LoadCaptureRegion()
+{
+	UWorld* World = GEditor->GetEditorWorldContext().World();
+	if (!Settings.bLoadWorldPartitionRegion || !World || !World->IsPartitionedWorld())
+	{
+		return;
+	}
+
+	FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::WorldStreaming);
+	// Past a few meters per pixel, full-detail actors are mostly lost to the downsampling; their HLODs read the same.
+	const double WorldUnitsPerPixel = GetWorldUnitsPerPixel();
+	const bool bHLODOnly = Settings.HLODWorldUnitsPerPixel > 0.0f && WorldUnitsPerPixel >= Settings.HLODWorldUnitsPerPixel;
+	if (!MinimapStreamer.IsValid())
+	{
+		MinimapStreamer = MakeShared<FMinimapStreamingSourceProvider>();
+	}
+	if (!MinimapStreamer->LoadRegion(*World, Settings.CaptureBounds, bHLODOnly))
+	{
+		return;
+	}
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%s the World Partition region at %.0f world units per pixel."),
+		bHLODOnly ? TEXT("Showing HLODs for") : TEXT("Loaded the cells of"), WorldUnitsPerPixel);
+
+	// The empty-tile and residency indices are built from the loaded actors, and with HLODs only there are none, so
+	// every HLOD-covered tile would count as empty and nothing would be prestreamed.
+	if (bHLODOnly && (Settings.bSkipEmptyTiles || Settings.bPrestreamTiles))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Empty-tile skipping and tile prestreaming are off for an HLOD capture."));
+		Settings.bSkipEmptyTiles = false;
+		Settings.bPrestreamTiles = false;
+	}
+}
+
+double UMinimapGeneratorManager::GetWorldUnitsPerPixel() const
+{
+	// We use the maximum dimension of the World Bounds and the Output Resolution to get a single, 
+	// non-stretched WUPP value. This ensures 1 pixel is always the same world distance.
+	const FVector WorldBoundsSize = Settings.CaptureBounds.GetSize();
+	const double MapWorldMaxDim = FMath::Max(WorldBoundsSize.X, WorldBoundsSize.Y);
+	const int32 MapOutputMaxDim = FMath::Max(Settings.OutputWidth, Settings.OutputHeight);
+	return MapOutputMaxDim > 0 ? MapWorldMaxDim / MapOutputMaxDim : 0.0;
+}
+
+TSharedRef<IMinimapTileSource> UMinimapGeneratorManager::CreateTileSource()
+{
+	if (bMergingShards)
+	{
+		// Tiles a worker did not deliver are rendered here, so a crashed worker costs time but not the capture.
+		return MakeShared<FMinimapTileSourceChain>(TArray<TSharedRef<IMinimapTileSource>>{
+			MakeShared<FMinimapShardTilesTileSource>(Settings.OutputPath, Settings.NumCaptureShards),
+			MakeShared<FMinimapSceneCaptureTileSource>(*this)
+		});
+	}
+
+	switch (Settings.TileSourceType)
+	{
+	case EMinimapTileSourceType::SavedTiles:
+		if (Settings.bRenderMissingTiles)
+		{
+			return MakeShared<FMinimapTileSourceChain>(TArray<TSharedRef<IMinimapTileSource>>{
+				MakeShared<FMinimapSavedTilesTileSource>(), MakeShared<FMinimapSceneCaptureTileSource>(*this)
+			});
+		}
+		return MakeShared<FMinimapSavedTilesTileSource>();
+	case EMinimapTileSourceType::Synthetic:
+		return MakeShared<FMinimapSyntheticTileSource>();
+	case EMinimapTileSourceType::CpuRaster:
+		return MakeShared<FMinimapCpuRasterTileSource>();
+	case EMinimapTileSourceType::SceneCapture:
+	default:
+		return MakeShared<FMinimapSceneCaptureTileSource>(*this);
+	}
+}
+
+bool UMinimapGeneratorManager::StartShardWorkers(FString& OutError)
+{
+	// Workers load the level from disk, so they would not see unsaved edits or an untitled level.
+	const UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	const UPackage* MapPackage = World ? World->GetPackage() : nullptr;
+	if (!MapPackage || !FPackageName::DoesPackageExist(MapPackage->GetName()) || MapPackage->IsDirty())
+	{
+		OutError = TEXT("Save the level before capturing with worker processes: they load it from disk.");
+		return false;
+	}
+
+	FMinimapShardManifest Manifest;
+	Manifest.Settings = Settings;
+	Manifest.MapPackage = MapPackage->GetName();
+	Manifest.TileDirectory = FPaths::ConvertRelativePathToFull(Settings.OutputPath);
+	Manifest.SetLayout(TileLayout);
+	Manifest.AssignShards(TileLayout, Settings.NumCaptureShards);
+	Settings.NumCaptureShards = Manifest.GetNumShards();
+
+	IFileManager::Get().MakeDirectory(*Manifest.TileDirectory, true);
+	const FString ManifestPath = FPaths::Combine(Manifest.TileDirectory, MinimapShards::GetManifestFileName(Settings.FileName));
+	if (!MinimapShards::WriteManifest(Manifest, ManifestPath))
+	{
+		OutError = FString::Printf(TEXT("Failed to write the shard manifest %s"), *ManifestPath);
+		return false;
+	}
+
+	const FString Executable = FUnrealEdMisc::Get().GetExecutableForCommandlets();
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	for (int32 ShardIndex = 0; ShardIndex < Manifest.GetNumShards(); ++ShardIndex)
+	{
+		// An index left by an earlier capture would let the merge pick up stale tiles.
+		IFileManager::Get().Delete(*FPaths::Combine(Manifest.TileDirectory, MinimapShards::GetIndexFileName(Settings.FileName, ShardIndex)),
+			false, true, true);
+
+		const FString LogPath = FPaths::Combine(Manifest.TileDirectory, FString::Printf(TEXT("%s_Shard_%d.log"), *Settings.FileName, ShardIndex));
+		const FString Params = FString::Printf(
+			TEXT("\"%s\" -run=MinimapCaptureShard -manifest=\"%s\" -shard=%d -AllowCommandletRendering -unattended -nosplash -nopause -abslog=\"%s\""),
+			*ProjectPath, *ManifestPath, ShardIndex, *LogPath);
+		FProcHandle Worker = FPlatformProcess::CreateProc(*Executable, *Params, true, true, true, nullptr, 0, nullptr, nullptr);
+		if (!Worker.IsValid())
+		{
+			OutError = FString::Printf(TEXT("Failed to launch worker process %d: %s %s"), ShardIndex, *Executable, *Params);
+			TerminateShardWorkers();
+			return false;
+		}
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Launched capture worker %d for tiles [%d, %d), log: %s"), ShardIndex,
+			Manifest.ShardFirstTiles[ShardIndex], Manifest.ShardFirstTiles[ShardIndex + 1], *LogPath);
+		ShardWorkers.Add(MoveTemp(Worker));
+	}
+
+	ShardStartSeconds = FPlatformTime::Seconds();
+	OnProgress.Broadcast(FText::Format(FText::FromString(TEXT("Rendering tiles in {0} worker processes...")), FText::AsNumber(ShardWorkers.Num())),
+	                     0.0f, 0, TileLayout.GetNumTiles());
+	GEditor->GetTimerManager()->SetTimer(ShardPollTimer, this, &UMinimapGeneratorManager::PollShardWorkers, 0.5f, true);
+	return true;
+}
+
+void UMinimapGeneratorManager::PollShardWorkers()
+{
+	if (bCancelRequested) return;
+
+	int32 NumFinishedTiles = 0;
+	int32 NumRunningWorkers = 0;
+	for (int32 ShardIndex = 0; ShardIndex < ShardWorkers.Num(); ++ShardIndex)
+	{
+		TArray<FMinimapShardTileRecord> Records;
+		MinimapShards::ReadIndex(FPaths::Combine(Settings.OutputPath, MinimapShards::GetIndexFileName(Settings.FileName, ShardIndex)),
+			ShardIndex, Records);
+		NumFinishedTiles += Records.Num();
+		NumRunningWorkers += FPlatformProcess::IsProcRunning(ShardWorkers[ShardIndex]) ? 1 : 0;
+	}
+
+	const int32 NumTiles = TileLayout.GetNumTiles();
+	OnProgress.Broadcast(
+		WithMemoryHighWater(FText::Format(FText::FromString(TEXT("Rendering tiles in {0} worker processes: {1}/{2}...")),
+		                                  FText::AsNumber(NumRunningWorkers), FText::AsNumber(NumFinishedTiles), FText::AsNumber(NumTiles))),
+		0.9f * NumFinishedTiles / FMath::Max(NumTiles, 1),
+		NumFinishedTiles,
+		NumTiles);
+	if (NumRunningWorkers > 0)
+	{
+		return;
+	}
+
+	GEditor->GetTimerManager()->ClearTimer(ShardPollTimer);
+	for (int32 ShardIndex = 0; ShardIndex < ShardWorkers.Num(); ++ShardIndex)
+	{
+		int32 ReturnCode = 0;
+		if (FPlatformProcess::GetProcReturnCode(ShardWorkers[ShardIndex], &ReturnCode) && ReturnCode != 0)
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Capture worker %d exited with code %d; its missing tiles are rendered here."),
+				ShardIndex, ReturnCode);
+		}
+		FPlatformProcess::CloseProc(ShardWorkers[ShardIndex]);
+	}
+	ShardWorkers.Empty();
+	CaptureReport.AddStageSeconds(MinimapCaptureStage::Render, FPlatformTime::Seconds() - ShardStartSeconds);
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Capture workers rendered %d of %d tiles in %.1fs. Merging."), NumFinishedTiles, NumTiles,
+		FPlatformTime::Seconds() - ShardStartSeconds);
+
+	bMergingShards = true;
+	StartTiledCaptureProcess();
+}
+
+void UMinimapGeneratorManager::TerminateShardWorkers()
+{
+	for (FProcHandle& Worker : ShardWorkers)
+	{
+		if (FPlatformProcess::IsProcRunning(Worker))
+		{
+			FPlatformProcess::TerminateProc(Worker, true);
+		}
+		FPlatformProcess::CloseProc(Worker);
+	}
+	ShardWorkers.Empty();
+}
+
+bool UMinimapGeneratorManager::CaptureTilesBlocking(const FMinimapCaptureSettings& InSettings, const int32 FirstTile, const int32 EndTile,
+                                                    TFunctionRef<bool(int32, const TArray<FColor>&, const FIntPoint&)> OnTileCaptured,
+                                                    FString& OutError)
+{
+	bIsShuttingDown = false;
+	bCancelRequested = false;
+	Settings = InSettings;
+	Settings.TileSourceType = EMinimapTileSourceType::SceneCapture;
+	CaptureReport.Reset();
+	TileGpuTimer = MakeShared<FMinimapGpuTimer, ESPMode::ThreadSafe>();
+	CalculateGrid();
+	if (!TileLayout.IsValid() || FirstTile < 0 || EndTile > TileLayout.GetNumTiles())
+	{
+		OutError = FString::Printf(TEXT("Tiles [%d, %d) are not in the %s grid."), FirstTile, EndTile, *TileLayout.ToString());
+		return false;
+	}
+
+	FMinimapTileSourceContext Context;
+	Context.Settings = Settings;
+	Context.Layout = TileLayout;
+	Context.WorldUnitsPerPixel = GetWorldUnitsPerPixel();
+	LoadCaptureRegion();
+	FMinimapSceneCaptureTileSource Source(*this);
+	if (!Source.Begin(Context, OutError))
+	{
+		CleanupCaptureResources();
+		return false;
+	}
+	if (Settings.bSkipEmptyTiles)
+	{
+		GatherVisibleActors(ActiveCaptureActor.IsValid() ? ActiveCaptureActor->GetCaptureComponent2D() : nullptr, Context.VisibleActors);
+		BuildPrimitiveBoundsIndex(Context.VisibleActors);
+	}
+
+	bool bSuccess = true;
+	TArray<FColor> TilePixels;
+	for (int32 TileIndex = FirstTile; TileIndex < EndTile && bSuccess; ++TileIndex)
+	{
+		if (ShouldSkipTile(TileIndex))
+		{
+			continue;
+		}
+
+		Source.PrepareTile(TileIndex);
+		for (int32 NextTileIndex = TileIndex + 1; NextTileIndex < EndTile; ++NextTileIndex)
+		{
+			if (!ShouldSkipTile(NextTileIndex))
+			{
+				Source.PrepareTile(NextTileIndex);
+				break;
+			}
+		}
+		const double WaitStartSeconds = FPlatformTime::Seconds();
+		while (!Source.IsTileReady(TileIndex) && FPlatformTime::Seconds() - WaitStartSeconds < MinimapCapture::TileResidencyTimeoutSeconds)
+		{
+			// Nothing ticks the streaming manager here either.
+			IStreamingManager::Get().UpdateResourceStreaming(0.0f, true);
+			FPlatformProcess::Sleep(0.01f);
+		}
+
+		double ReadDelaySeconds = 0.0;
+		bSuccess = Source.RequestTile(TileIndex, ReadDelaySeconds, OutError);
+		if (bSuccess && ReadDelaySeconds > 0.0)
+		{
+			// Nothing ticks the streaming manager between tiles here; block on it for as long as the editor would wait.
+			IStreamingManager::Get().StreamAllResources(static_cast<float>(ReadDelaySeconds));
+		}
+		while (bSuccess && Source.NeedsMoreFrames(TileIndex, ReadDelaySeconds))
+		{
+			if (ReadDelaySeconds > 0.0)
+			{
+				IStreamingManager::Get().StreamAllResources(static_cast<float>(ReadDelaySeconds));
+			}
+		}
+
+		TilePixels.Reset();
+		bSuccess = bSuccess && Source.ReadTile(TileIndex, TilePixels, OutError);
+		if (bSuccess && TilePixels.Num() > 0 && !OnTileCaptured(TileIndex, TilePixels, Context.GetTileSize(TileIndex)))
+		{
+			OutError = FString::Printf(TEXT("Stopped after tile %d."), TileIndex);
+			bSuccess = false;
+		}
+	}
+
+	Source.End();
+	CleanupCaptureResources();
+	return bSuccess;
+}
+
+void UMinimapGeneratorManager::GatherVisibleActors(const USceneCaptureComponent2D* CaptureComponent, TArray<AActor*>& OutVisibleActors) const
+{
+	OutVisibleActors.Reset();
+	if (CaptureComponent)
+	{
+		// Exactly what the capture will render: its filtered show-only list, or every actor in the world.
+		if (CaptureComponent->PrimitiveRenderMode == ESceneCapturePrimitiveRenderMode::PRM_UseShowOnlyList)
+		{
+			for (const TObjectPtr<AActor>& Actor : CaptureComponent->ShowOnlyActors)
+			{
+				OutVisibleActors.Add(Actor.Get());
+			}
+		}
+		else if (UWorld* World = GEditor->GetEditorWorldContext().World())
+		{
+			UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), OutVisibleActors);
+		}
+		return;
+	}
+
+	// Without a capture component, make the same choice SpawnAndConfigureCaptureActor makes for one.
+	const bool bHasFiltering = Settings.ShowOnlyActors.Num() > 0 || Settings.HiddenActors.Num() > 0 || Settings.ActorClassFilter || !Settings.ActorTagFilter.IsNone();
+	if (bHasFiltering || Settings.PrimitiveRenderMode == ESceneCapturePrimitiveRenderMode::PRM_UseShowOnlyList)
+	{
+		BuildFinalShowOnlyList(OutVisibleActors);
+	}
+	else if (UWorld* World = GEditor->GetEditorWorldContext().World())
+	{
+		UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), OutVisibleActors);
+	}
+}
+
+void UMinimapGeneratorManager::BuildPrimitiveBoundsIndex(const TArray<AActor*>& VisibleActors)
+{
+	PrimitiveBoundsIndex.Reset();
+	if (!Settings.bSkipEmptyTiles)
+	{
+		return;
+	}
+
+	// A perspective camera sees past its tile's ground footprint, so only orthographic tiles can be proven empty.
+	if (!Settings.bIsOrthographic)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Empty-tile skipping is only supported for orthographic captures. Rendering every tile."));
+		return;
+	}
 
-		// Hide actors matching the class filter.
-		if (Settings.ActorClassFilter && Actor->IsA(Settings.ActorClassFilter))
-		{
-			ActorsToHide.Add(Actor);
-		}
+	MINIMAP_STAGE_SCOPE(STAT_MinimapFilterBuild);
+	const double BuildStartTime = FPlatformTime::Seconds();
+	PrimitiveBoundsIndex = MakeShared<FMinimapPrimitiveBoundsIndex>();
+	PrimitiveBoundsIndex->Build(VisibleActors, TileLayout, FVector2D(Settings.CaptureBounds.Min), GetWorldUnitsPerPixel());
 
-		// Hide actors matching the tag filter.
-		if (!Settings.ActorTagFilter.IsNone() && Actor->Tags.Contains(Settings.ActorTagFilter))
-		{
-			ActorsToHide.Add(Actor);
-		}
+	if (const TArray<FString>& EnclosingNames = PrimitiveBoundsIndex->GetEnclosingPrimitiveNames(); !EnclosingNames.IsEmpty())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Log,
+			TEXT("%d primitive(s) cover the whole capture area and do not keep tiles from being skipped: %s"), EnclosingNames.Num(),
+			*FString::Join(EnclosingNames, TEXT(", ")));
 	}
 
-	// 4) Final pass: keep only candidates that are not in the hide set.
-	for (AActor* Candidate : CandidateActors)
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Primitive bounds index built from %d actors in %.2fs: %d of %d tiles are empty."),
+		VisibleActors.Num(), FPlatformTime::Seconds() - BuildStartTime, PrimitiveBoundsIndex->GetNumEmptyTiles(), TileLayout.GetNumTiles());
+}
+
+bool UMinimapGeneratorManager::ShouldSkipTile(const int32 TileIndex) const
+{
+	if (PatchTexture.IsValid())
 	{
-		if (Candidate && !ActorsToHide.Contains(Candidate))
+		// The feather band must be covered by recaptured tiles, clear of the overlap they blend with the empty canvas.
+		const FIntPoint TileCoord = TileLayout.GetTileCoord(TileIndex);
+		FIntRect NeededRect = PatchRect;
+		NeededRect.InflateRect(Settings.PatchFeatherWidth + TileLayout.Overlap);
+		if (!TileLayout.GetTileRect(TileCoord.X, TileCoord.Y).Intersect(NeededRect))
 		{
-			OutShowOnlyList.Add(Candidate);
+			return true;
 		}
 	}
+	return PrimitiveBoundsIndex.IsValid() && PrimitiveBoundsIndex->IsTileEmpty(TileIndex);
+}
 
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Built final ShowOnly list: %d actors (candidates: %d, hidden: %d)."),
-		OutShowOnlyList.Num(), CandidateActors.Num(), ActorsToHide.Num());
+bool UMinimapGeneratorManager::IsPixelAlignedTiling(const FMinimapCaptureSettings& InSettings)
+{
+	// Perspective tiles never line up exactly at their borders, so they always keep the configured overlap.
+	return InSettings.bUseTiling && InSettings.bPixelAlignedTiling && InSettings.bIsOrthographic;
 }
 
-// ===================================================================
-// FLOW 2: TILED CAPTURE
-// ===================================================================
+int32 UMinimapGeneratorManager::GetEffectiveTileOverlap(const FMinimapCaptureSettings& InSettings)
+{
+	return IsPixelAlignedTiling(InSettings) ? 0 : InSettings.TileOverlap;
+}
 
-void UMinimapGeneratorManager::StartTiledCaptureProcess()
+FMinimapTileLayout UMinimapGeneratorManager::MakeTileLayout(const FMinimapCaptureSettings& InSettings)
 {
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Starting tiled capture process."));
-	CurrentTileIndex = 0;
-	CapturedTileData.Empty();
-	ActiveCaptureActor.Reset();
-	ActiveRenderTarget.Reset();
+	const FIntPoint OutputSize(InSettings.OutputWidth, InSettings.OutputHeight);
+	const int32 Overlap = GetEffectiveTileOverlap(InSettings);
+	return InSettings.bPlanTileLayout
+		       ? FMinimapTileLayout::Plan(OutputSize, Overlap, InSettings.TileResolution)
+		       : FMinimapTileLayout::MakeUniform(OutputSize, InSettings.TileResolution, Overlap);
+}
 
-	CalculateGrid();
+void UMinimapGeneratorManager::CalculateGrid()
+{
+	MINIMAP_STAGE_SCOPE(STAT_MinimapGridPlanning);
+	FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::GridPlanning);
+	TileLayout = MakeTileLayout(Settings);
+	CaptureReport.TileLayoutSummary = TileLayout.ToString();
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Calculated Grid: %s%s"), *TileLayout.ToString(),
+		IsPixelAlignedTiling(Settings) ? TEXT(" [pixel-aligned]") : TEXT(""));
+}
+
+FIntPoint UMinimapGeneratorManager::GetTileRenderTargetSize(const FIntRect& TileRect) const
+{
+	const bool bIsPortrait = Settings.OutputHeight > Settings.OutputWidth;
+	return bIsPortrait ? FIntPoint(TileRect.Height(), TileRect.Width()) : TileRect.Size();
+}
 
-	if (NumTilesX * NumTilesY == 0)
+UTextureRenderTarget2D* UMinimapGeneratorManager::AcquireTileRenderTarget(const FIntPoint& Size)
+{
+	if (const TObjectPtr<UTextureRenderTarget2D>* Existing = TileRenderTargets.Find(Size); Existing && *Existing)
 	{
-		OnCaptureComplete.Broadcast(false, TEXT("Invalid grid size."));
-		return;
+		// Retained targets may come from a capture with another background.
+		UTextureRenderTarget2D* RenderTarget = *Existing;
+		if (const FLinearColor ClearColor = GetRenderTargetClearColor(); !RenderTarget->ClearColor.Equals(ClearColor))
+		{
+			RenderTarget->ClearColor = ClearColor;
+			RenderTarget->UpdateResourceImmediate(true);
+		}
+		return RenderTarget;
 	}
 
-	ActiveRenderTarget = CreateRenderTarget();
-	ActiveCaptureActor = SpawnAndConfigureCaptureActor(ActiveRenderTarget.Get());
+	UTextureRenderTarget2D* RenderTarget = CreateRenderTarget(Size);
+	TileRenderTargets.Add(Size, RenderTarget);
+	return RenderTarget;
+}
 
-	if (!ActiveCaptureActor.IsValid() || !ActiveRenderTarget.IsValid())
+UTextureRenderTarget2D* UMinimapGeneratorManager::AcquireFloatRenderTarget(const FIntPoint& Size)
+{
+	if (const TObjectPtr<UTextureRenderTarget2D>* Existing = FloatTileRenderTargets.Find(Size); Existing && *Existing)
 	{
-		OnCaptureComplete.Broadcast(false, TEXT("Failed to create capture actor or render target for tiling."));
-		return;
+		return *Existing;
 	}
 
-	CaptureNextTile();
+	UTextureRenderTarget2D* RenderTarget = NewObject<UTextureRenderTarget2D>();
+	RenderTarget->ClearColor = FLinearColor::Black;
+	RenderTarget->InitCustomFormat(Size.X, Size.Y, PF_A32B32G32R32F, true);
+	FloatTileRenderTargets.Add(Size, RenderTarget);
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Created float Render Target (%dx%d)."), Size.X, Size.Y);
+	return RenderTarget;
 }
 
-void UMinimapGeneratorManager::CalculateGrid()
+void UMinimapGeneratorManager::ReleaseRenderTargets()
 {
-	const int32 EffectiveTileRes = Settings.TileResolution - Settings.TileOverlap;
-	if (EffectiveTileRes <= 0)
+	// The active target is always one of the pooled ones.
+	ActiveRenderTarget.Reset();
+	if (bRetainCaptureResources && !bIsShuttingDown)
 	{
-		NumTilesX = 0;
-		NumTilesY = 0;
 		return;
 	}
 
-	NumTilesX = (Settings.OutputWidth <= Settings.TileResolution)
-		            ? 1
-		            : (1 + FMath::CeilToInt(
-			            static_cast<float>(Settings.OutputWidth - Settings.TileResolution) / EffectiveTileRes));
-	NumTilesY = (Settings.OutputHeight <= Settings.TileResolution)
-		            ? 1
-		            : (1 + FMath::CeilToInt(
-			            static_cast<float>(Settings.OutputHeight - Settings.TileResolution) / EffectiveTileRes));
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Calculated Grid: %d x %d tiles"), NumTilesX, NumTilesY);
+	for (const TPair<FIntPoint, TObjectPtr<UTextureRenderTarget2D>>& Pair : TileRenderTargets)
+	{
+		if (Pair.Value)
+		{
+			Pair.Value->ConditionalBeginDestroy();
+		}
+	}
+	TileRenderTargets.Empty();
+	for (const TPair<FIntPoint, TObjectPtr<UTextureRenderTarget2D>>& Pair : FloatTileRenderTargets)
+	{
+		if (Pair.Value)
+		{
+			Pair.Value->ConditionalBeginDestroy();
+		}
+	}
+	FloatTileRenderTargets.Empty();
 }
 
 void UMinimapGeneratorManager::CaptureNextTile()
 {
 	if (bCancelRequested) return;
 
-	if (CurrentTileIndex >= NumTilesX * NumTilesY)
+	// Tiles with no visible primitive, or that the source has no pixels for, are not rendered:
+	// the stitch canvas is already cleared to the background color.
+	while (CurrentTileIndex < TileLayout.GetNumTiles() && (ShouldSkipTile(CurrentTileIndex) || !TileSource->CanProvideTile(CurrentTileIndex)))
+	{
+		FMinimapTileStats SkippedTile;
+		SkippedTile.TileIndex = CurrentTileIndex;
+		SkippedTile.TileCoord = TileLayout.GetTileCoord(CurrentTileIndex);
+		SkippedTile.Size = TileLayout.GetTileRect(SkippedTile.TileCoord.X, SkippedTile.TileCoord.Y).Size();
+		SkippedTile.bSkipped = true;
+		CaptureReport.Tiles.Add(SkippedTile);
+		if (ShouldSkipTile(CurrentTileIndex))
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Verbose, TEXT("Skipping empty tile index %d."), CurrentTileIndex);
+			NumSkippedTiles++;
+		}
+		else
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Verbose, TEXT("Tile source %s has no tile index %d."), *TileSource->GetName(), CurrentTileIndex);
+			NumUnavailableTiles++;
+		}
+		CurrentTileIndex++;
+	}
+
+	if (CurrentTileIndex >= TileLayout.GetNumTiles())
 	{
 		StartStitching();
 		return;
 	}
-	if (!ActiveCaptureActor.IsValid() || !ActiveRenderTarget.IsValid())
+
+	// The tile after this one starts streaming now, so its mips load while this one waits and renders.
+	if (PreparedTileIndex != CurrentTileIndex)
 	{
-		OnCaptureComplete.
-			Broadcast(false, TEXT("Capture actor or render target became invalid during tiling process."));
-		return;
+		PreparedTileIndex = CurrentTileIndex;
+		TileCaptureStartSeconds = FPlatformTime::Seconds();
+		TileSource->PrepareTile(CurrentTileIndex);
+		if (const int32 NextTileIndex = FindNextTileToCapture(CurrentTileIndex + 1); NextTileIndex != INDEX_NONE)
+		{
+			TileSource->PrepareTile(NextTileIndex);
+		}
+	}
+	if (!TileSource->IsTileReady(CurrentTileIndex))
+	{
+		if (FPlatformTime::Seconds() - TileCaptureStartSeconds < MinimapCapture::TileResidencyTimeoutSeconds)
+		{
+			GEditor->GetTimerManager()->SetTimerForNextTick(this, &UMinimapGeneratorManager::CaptureNextTile);
+			return;
+		}
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Tile %d is still streaming after %.0fs; capturing it anyway."),
+			CurrentTileIndex, MinimapCapture::TileResidencyTimeoutSeconds);
 	}
 
-	const int32 TileX = CurrentTileIndex % NumTilesX;
-	const int32 TileY = CurrentTileIndex / NumTilesX;
-	UE_LOG(OBPanoramicMinimapGenerator, Verbose, TEXT("Capturing tile index %d (%d, %d)."), CurrentTileIndex, TileX, TileY);
-
-	// 1. Calculate the consistent World Units Per Pixel (WUPP)
-	// We use the maximum dimension of the World Bounds and the Output Resolution to get a single, 
-	// non-stretched WUPP value. This ensures 1 pixel is always the same world distance.
-	const FVector WorldBoundsSize = Settings.CaptureBounds.GetSize();
-	const float MapWorldMaxDim = FMath::Max(WorldBoundsSize.X, WorldBoundsSize.Y);
-	const int32 MapOutputMaxDim = FMath::Max(Settings.OutputWidth, Settings.OutputHeight);
-
-	// WUPP: The world distance of ONE PIXEL, consistent for both X and Y.
-	const float WorldUnitsPerPixel = MapWorldMaxDim / MapOutputMaxDim;
-
-	// 2. Calculate the World Size of the TILE's capture area (TileOrthoSize)
-	// Since the Render Target is square, the world-capture area must also be square (OrthoWidth x OrthoWidth).
-	const float TileOrthoSize = Settings.TileResolution * WorldUnitsPerPixel;
-
-	// 3. Calculate the world step size (distance between tile start points)
-	const float EffectiveTileRes = Settings.TileResolution - Settings.TileOverlap;
-	const float StepWorldX = EffectiveTileRes * WorldUnitsPerPixel;
-	const float StepWorldY = EffectiveTileRes * WorldUnitsPerPixel;
-
-	// 4. Calculate the Tile's Center Location in world coordinates
-	const FVector BoundsMin = Settings.CaptureBounds.Min;
-	const FVector TileCenterLocation = BoundsMin + FVector(
-		TileX * StepWorldX + TileOrthoSize * 0.5f,
-		TileY * StepWorldY + TileOrthoSize * 0.5f,
-		Settings.CameraHeight);
-
-	// 5. Configure the capture actor.
-	ActiveCaptureActor->SetActorLocation(TileCenterLocation);
-	USceneCaptureComponent2D* CaptureComponent = ActiveCaptureActor->GetCaptureComponent2D();
-
-	// Set the OrthoWidth to the calculated square size of the tile's capture area
-	CaptureComponent->OrthoWidth = TileOrthoSize;
-
+	const FIntPoint TileCoord = TileLayout.GetTileCoord(CurrentTileIndex);
+	UE_LOG(OBPanoramicMinimapGenerator, Verbose, TEXT("Requesting tile index %d (%d, %d), rect %s."), CurrentTileIndex,
+		TileCoord.X, TileCoord.Y, *TileLayout.GetTileRect(TileCoord.X, TileCoord.Y).ToString());
 
-	CaptureComponent->CaptureScene();
+	// The time waited for residency above counts as the tile's streaming wait.
+	const double RequestStartSeconds = FPlatformTime::Seconds();
+	double ReadDelaySeconds = 0.0;
+	FString Error;
+	bool bRequested;
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapTileRender);
+		bRequested = TileSource->RequestTile(CurrentTileIndex, ReadDelaySeconds, Error);
+	}
+	if (!bRequested)
+	{
+		OnCaptureComplete.Broadcast(false, Error);
+		return;
+	}
+	TileRenderSeconds = FPlatformTime::Seconds() - RequestStartSeconds;
+	CaptureReport.AddStageSeconds(MinimapCaptureStage::Render, TileRenderSeconds);
 
-	const float CurrentProgress = static_cast<float>(CurrentTileIndex) / (NumTilesX * NumTilesY);
+	const int32 NumTiles = TileLayout.GetNumTiles();
+	const float CurrentProgress = static_cast<float>(CurrentTileIndex) / NumTiles;
 
 	OnProgress.Broadcast(
-		FText::Format(FText::FromString("Capturing tile {0}/{1}..."), FText::AsNumber(CurrentTileIndex + 1),
-		              FText::AsNumber(NumTilesX * NumTilesY)),
+		WithMemoryHighWater(FText::Format(FText::FromString("Capturing tile {0}/{1}..."), FText::AsNumber(CurrentTileIndex + 1),
+		                                  FText::AsNumber(NumTiles))),
 		CurrentProgress * 0.9f,
 		CurrentTileIndex,
-		NumTilesX * NumTilesY
+		NumTiles
 	);
 
-	// GEditor->GetEditorWorldContext().World()->GetTimerManager().SetTimerForNextTick(
-	// 	this, &UMinimapGeneratorManager::OnTileRenderedAndContinue);
+	ScheduleTileRead(ReadDelaySeconds);
+}
+
+int32 UMinimapGeneratorManager::FindNextTileToCapture(int32 TileIndex) const
+{
+	for (; TileIndex < TileLayout.GetNumTiles(); ++TileIndex)
+	{
+		if (!ShouldSkipTile(TileIndex) && TileSource->CanProvideTile(TileIndex))
+		{
+			return TileIndex;
+		}
+	}
+	return INDEX_NONE;
+}
 
+void UMinimapGeneratorManager::ScheduleTileRead(const double ReadDelaySeconds)
+{
 	if (GEditor)
 	{
-		FTimerHandle TempHandle;
-		GEditor->GetTimerManager()->SetTimer(
-			TempHandle, this, &UMinimapGeneratorManager::OnTileRenderedAndContinue, 0.2f, false);
+		// A zero-rate timer is never set, and reading right away would recurse through every tile in one frame.
+		if (ReadDelaySeconds > 0.0)
+		{
+			FTimerHandle TempHandle;
+			GEditor->GetTimerManager()->SetTimer(
+				TempHandle, this, &UMinimapGeneratorManager::OnTileRenderedAndContinue, static_cast<float>(ReadDelaySeconds), false);
+		}
+		else
+		{
+			GEditor->GetTimerManager()->SetTimerForNextTick(this, &UMinimapGeneratorManager::OnTileRenderedAndContinue);
+		}
 	}
 }
 
 void UMinimapGeneratorManager::OnTileRenderedAndContinue()
 {
-	if (bCancelRequested) return;
+	if (bCancelRequested || !TileSource.IsValid()) return;
 
-	UTextureRenderTarget2D* RenderTarget = ActiveRenderTarget.Get();
-	if (!RenderTarget)
+	// With a persistent view state the tile keeps rendering, one frame per tick, until two frames agree.
+	double FrameDelaySeconds = 0.0;
+	bool bNeedsMoreFrames;
+	{
+		MINIMAP_STAGE_SCOPE(STAT_MinimapTileRender);
+		bNeedsMoreFrames = TileSource->NeedsMoreFrames(CurrentTileIndex, FrameDelaySeconds);
+	}
+	if (bNeedsMoreFrames)
 	{
-		OnCaptureComplete.Broadcast(false, TEXT("Render Target lost during tiling."));
+		ScheduleTileRead(FrameDelaySeconds);
 		return;
 	}
 
 	TArray<FColor> TilePixels;
-	if (auto* RTResource = static_cast<FTextureRenderTargetResource*>(RenderTarget->GetResource()))
+	FString Error;
+	bool bRead;
+	const double ReadbackStartTime = FPlatformTime::Seconds();
 	{
-		FlushRenderingCommands();
-		RTResource->ReadPixels(TilePixels);
+		MINIMAP_STAGE_SCOPE(STAT_MinimapReadback);
+		LLM_SCOPE_BYTAG(MinimapGenerator_CapturedTileData);
+		bRead = TileSource->ReadTile(CurrentTileIndex, TilePixels, Error);
+	}
+	if (!bRead)
+	{
+		OnCaptureComplete.Broadcast(false, Error);
+		return;
 	}
 
+	FMinimapTileStats TileStats;
+	TileStats.TileIndex = CurrentTileIndex;
+	TileStats.TileCoord = TileLayout.GetTileCoord(CurrentTileIndex);
+	TileStats.Size = GetTileRenderTargetSize(TileLayout.GetTileRect(TileStats.TileCoord.X, TileStats.TileCoord.Y));
+	TileStats.RenderSeconds = TileRenderSeconds;
+	TileStats.GpuRenderSeconds = TileSource->GetLastGpuSeconds();
+	TileStats.FramesRendered = TileSource->GetLastFrameCount();
+	TileStats.StreamingWaitSeconds = ReadbackStartTime - (TileCaptureStartSeconds + TileRenderSeconds);
+	TileStats.ReadbackSeconds = FPlatformTime::Seconds() - ReadbackStartTime;
+	CaptureReport.AddStageSeconds(MinimapCaptureStage::Readback, TileStats.ReadbackSeconds);
+
 	if (TilePixels.Num() > 0)
 	{
-		const int32 TileX = CurrentTileIndex % NumTilesX;
-		const int32 TileY = CurrentTileIndex / NumTilesX;
+		const FIntPoint TileCoord = TileStats.TileCoord;
 
-		// Save individual debug tiles if enabled.
-		if (Settings.bSaveTiles)
+		// Save individual debug tiles if enabled. Tiles read from saved tiles are already on disk.
+		if (Settings.bSaveTiles && TileSource->IsNewTile(CurrentTileIndex))
 		{
 			// Use base file name without extension for per-tile output.
 			const FString BaseFileName = Settings.FileName;
@@ -918,17 +2676,50 @@ void UMinimapGeneratorManager::OnTileRenderedAndContinue()
 				// Keep debug tile names clean even when auto filename is enabled.
 			}
 
-			SaveDebugTileImage(Settings.OutputPath, BaseFileName, TilePixels, TileX, TileY, Settings.TileResolution);
+			SaveDebugTileImage(Settings.OutputPath, BaseFileName, TilePixels, TileCoord.X, TileCoord.Y,
+			                   TileStats.Size.X, TileStats.Size.Y, DebugTileBytesWritten);
 		}
 
-		CapturedTileData.Add(FIntPoint(TileX, TileY), MoveTemp(TilePixels));
-		UE_LOG(OBPanoramicMinimapGenerator, Verbose, TEXT("Tile (%d, %d) captured and stored."), TileX, TileY);
+		TileStore->AddTile(CurrentTileIndex, TileStats.Size, MoveTemp(TilePixels));
+		UE_LOG(OBPanoramicMinimapGenerator, Verbose, TEXT("Tile (%d, %d) captured and stored."), TileCoord.X, TileCoord.Y);
+
+		// The camera is still over this tile and its content is streamed in, so the other buffers cost one render each.
+		if (BufferTileStores.Num() > 0)
+		{
+			MINIMAP_STAGE_SCOPE(STAT_MinimapTileRender);
+			FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::Render);
+			for (const TPair<EMinimapCaptureBuffer, TSharedPtr<FMinimapTileStore>>& Pair : BufferTileStores)
+			{
+				TArray<FColor> BufferPixels;
+				if (TileSource->ReadTileBuffer(CurrentTileIndex, Pair.Key, BufferPixels))
+				{
+					Pair.Value->AddTile(CurrentTileIndex, TileStats.Size, MoveTemp(BufferPixels));
+				}
+			}
+		}
+		if (FloorTileStores.Num() > 0)
+		{
+			MINIMAP_STAGE_SCOPE(STAT_MinimapTileRender);
+			FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::Render);
+			for (int32 FloorIndex = 0; FloorIndex < FloorTileStores.Num(); ++FloorIndex)
+			{
+				TArray<FColor> FloorPixels;
+				if (TileSource->ReadTileFloor(CurrentTileIndex, FloorIndex, FloorPixels))
+				{
+					FloorTileStores[FloorIndex]->AddTile(CurrentTileIndex, TileStats.Size, MoveTemp(FloorPixels));
+				}
+			}
+		}
 	}
 	else
 	{
 		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Tile %d rendered with empty pixel data."), CurrentTileIndex);
 	}
 
+	TileStats.LatencySeconds = FPlatformTime::Seconds() - TileCaptureStartSeconds;
+	CaptureReport.Tiles.Add(TileStats);
+	CaptureReport.SampleMemory();
+
 	CurrentTileIndex++;
 	CaptureNextTile();
 }
@@ -936,127 +2727,377 @@ void UMinimapGeneratorManager::OnTileRenderedAndContinue()
 void UMinimapGeneratorManager::StartStitching()
 {
 	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("All tiles captured. Starting stitching process..."));
-	OnProgress.Broadcast(FText::FromString(TEXT("Stitching tiles...")), 0.9f, 0, 0);
+	OnProgress.Broadcast(WithMemoryHighWater(FText::FromString(TEXT("Stitching tiles..."))), 0.9f, 0, 0);
 
-	if (ActiveCaptureActor.IsValid())
+	if (TileSource.IsValid())
 	{
-		ActiveCaptureActor->Destroy();
+		TileSource->End();
+		TileSource.Reset();
 	}
-	ActiveCaptureActor.Reset();
-	if (ActiveRenderTarget.IsValid())
+	PrimitiveBoundsIndex.Reset();
+
+	if (NumSkippedTiles > 0)
 	{
-		ActiveRenderTarget->ConditionalBeginDestroy();
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Skipped %d empty tile(s) out of %d."), NumSkippedTiles, TileLayout.GetNumTiles());
 	}
-	ActiveRenderTarget.Reset();
+	if (NumUnavailableTiles > 0)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("The tile source had no pixels for %d tile(s) out of %d; they are left to the background color."),
+			NumUnavailableTiles, TileLayout.GetNumTiles());
+	}
+
+	// Let the workers finish compressing the last tiles before reading them back.
+	TileStore->WaitForPendingTiles();
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Tile store: %d tiles (%d unique), %.1f MB stored for %.1f MB of raw pixels."),
+		TileStore->GetNumStoredTiles(), TileStore->GetNumUniqueTiles(),
+		TileStore->GetStoredBytes() / (1024.0 * 1024.0), TileStore->GetRawBytes() / (1024.0 * 1024.0));
 
-	if (CapturedTileData.Num() == 0)
+	CaptureReport.TileStoreStoredBytes = TileStore->GetStoredBytes();
+	CaptureReport.TileStoreRawBytes = TileStore->GetRawBytes();
+
+	if (TileStore->GetNumStoredTiles() == 0 && NumSkippedTiles == 0)
 	{
 		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("No tile data was captured. Aborting stitching."));
 		OnCaptureComplete.Broadcast(false, TEXT("No tile data was captured."));
 		return;
 	}
 
-	TArray<FColor> FinalImageData;
-	FinalImageData.AddUninitialized(Settings.OutputWidth * Settings.OutputHeight);
-	// Initialize final image with the configured background color for correct blending.
-	const FColor BackgroundColor = (Settings.BackgroundMode == EMinimapBackgroundMode::Transparent)
-		                               ? FColor::Transparent
-		                               : Settings.BackgroundColor.ToFColor(true);
-	for (int32 i = 0; i < FinalImageData.Num(); ++i)
+	if (Settings.TextureMode == EMinimapTextureMode::VirtualTextureUDIM)
 	{
-		FinalImageData[i] = BackgroundColor;
+		StitchAndSavePages(MakeOutputBasePath());
+		return;
 	}
 
+	MINIMAP_STAGE_SCOPE(STAT_MinimapComposite);
+	const double CompositeStartTime = FPlatformTime::Seconds();
 
-	const int32 EffectiveTileRes = Settings.TileResolution - Settings.TileOverlap;
-	const bool bIsPortrait = Settings.OutputHeight > Settings.OutputWidth;
+	FMinimapTileStitcher Stitcher(Settings, TileLayout);
 
-	// Sort tiles from left-to-right and top-to-bottom for deterministic blending.
-	TArray<FIntPoint> SortedTileCoords;
-	CapturedTileData.GetKeys(SortedTileCoords);
-	SortedTileCoords.Sort([](const FIntPoint& A, const FIntPoint& B)
+	// Tile indices are row-major, so walking them in order blends left-to-right and top-to-bottom deterministically.
+	// Each tile is decompressed into the same scratch buffer right before it is composited.
+	LLM_SCOPE_BYTAG(MinimapGenerator_CapturedTileData);
+	TArray<FColor> TilePixels;
+	for (int32 TileIndex = 0; TileIndex < TileLayout.GetNumTiles(); ++TileIndex)
 	{
-		if (A.Y != B.Y) return A.Y < B.Y;
-		return A.X < B.X;
-	});
+		FIntPoint StoredSize;
+		if (TileStore->GetTile(TileIndex, TilePixels, StoredSize))
+		{
+			Stitcher.AddTile(TileIndex, TilePixels, StoredSize);
+		}
+	}
+
+	// The canvas and the whole tile store are alive together here: this is usually the capture's memory high-water mark.
+	CaptureReport.SampleMemory();
+	CaptureReport.AddStageSeconds(MinimapCaptureStage::Composite, FPlatformTime::Seconds() - CompositeStartTime);
+
+	TileStore.Reset();
+	const FString OutputBasePath = MakeOutputBasePath();
+	SaveAdditionalBuffers(OutputBasePath);
+
+	OnProgress.Broadcast(WithMemoryHighWater(FText::FromString(TEXT("Saving final image..."))), 0.95f, 0, 0);
+	FMinimapTrackedBytes FinalImageDataBytes;
+	TArray<FColor> FinalImageData = Stitcher.ReleaseCanvas(FinalImageDataBytes);
+	if (PatchTexture.IsValid())
+	{
+		FString Error;
+		if (!ApplyPatch(FinalImageData, Error))
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("%s"), *Error);
+			OnCaptureComplete.Broadcast(false, Error);
+			return;
+		}
+	}
+	StartImageSaveTask(MoveTemp(FinalImageData), MoveTemp(FinalImageDataBytes), Settings.OutputWidth, Settings.OutputHeight, OutputBasePath,
+		bPatchAwaitsEncodedImage);
+}
+
+bool UMinimapGeneratorManager::ApplyPatch(TArray<FColor>& Canvas, FString& OutError)
+{
+	UTexture2D* Texture = PatchTexture.Get();
+	FImage SourceImage;
+	if (!Texture || !Texture->Source.GetMipImage(SourceImage, 0, 0, 0))
+	{
+		OutError = TEXT("The patched texture's source could not be read.");
+		return false;
+	}
+
+	const FIntPoint CanvasSize(Settings.OutputWidth, Settings.OutputHeight);
+	if (SourceImage.SizeX != CanvasSize.X || SourceImage.SizeY != CanvasSize.Y || Canvas.Num() != CanvasSize.X * CanvasSize.Y)
+	{
+		OutError = FString::Printf(TEXT("%s changed size during the patch capture."), *Texture->GetName());
+		return false;
+	}
+
+	FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::Composite);
+	FImage BaseImage;
+	SourceImage.CopyTo(BaseImage, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+	SourceImage = FImage();
+	const TConstArrayView<FColor> BasePixels(reinterpret_cast<const FColor*>(BaseImage.RawData.GetData()), Canvas.Num());
+	MinimapImageKernels::BlendPatch(BasePixels, Canvas, CanvasSize, PatchRect, Settings.PatchFeatherWidth);
+
+	// The base is decoded already, so the patch is compared with it before the texture is touched. Only the patch and
+	// its feather band were recaptured; the rest of the canvas is the old image.
+	FIntRect CapturedRect = PatchRect;
+	CapturedRect.InflateRect(Settings.PatchFeatherWidth);
+	TArray<FIntRect> ChangedRects;
+	MinimapImageKernels::FindChangedBlocks(BasePixels, Canvas, CanvasSize, CapturedRect, MinimapTextureSource::ChangedBlockSize, ChangedRects);
+	if (ChangedRects.IsEmpty())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("The patch left %s unchanged."), *Texture->GetPathName());
+		return true;
+	}
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("The patch changes %d region(s), %.1f%% of %s."), ChangedRects.Num(),
+		MinimapTextureSource::GetChangedFraction(ChangedRects, CanvasSize) * 100.0, *Texture->GetPathName());
+
+	// A source stored compressed stays compressed. Its PNG is the one the save task encodes for the output file anyway.
+	if (Texture->Source.GetSourceCompression() != TSCF_None)
+	{
+		bPatchAwaitsEncodedImage = true;
+		return true;
+	}
+	WritePatchSource(Canvas, CanvasSize, {});
+	return true;
+}
 
-	for (const FIntPoint& TileCoord : SortedTileCoords)
+void UMinimapGeneratorManager::WritePatchSource(TConstArrayView<FColor> Pixels, const FIntPoint& Size, TArrayView64<uint8> EncodedImage)
+{
+	UTexture2D* Texture = PatchTexture.Get();
+	if (!Texture)
 	{
-		const TArray<FColor>& TilePixels = CapturedTileData[TileCoord];
-		const int32 CanvasStartX = TileCoord.X * EffectiveTileRes;
-		const int32 CanvasStartY = TileCoord.Y * EffectiveTileRes;
+		return;
+	}
+
+	Texture->Modify();
+	// The patched source no longer matches the file it was imported from.
+	MinimapTextureSource::SetImportedFile(*Texture, FString(), FMD5Hash());
+	MinimapTextureSource::SetSource(*Texture, Pixels, Size, EncodedImage, EncodedImage.Num() > 0 ? TSCF_PNG : TSCF_None);
+	Texture->PostEditChange();
+	Texture->MarkPackageDirty();
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Patched %s in place."), *Texture->GetPathName());
+}
 
-		for (int32 y = 0; y < Settings.TileResolution; ++y)
+void UMinimapGeneratorManager::StitchAndSavePages(const FString& OutputBasePath)
+{
+	// An existing texture is loaded on the async loading thread first, rather than through FullyLoad below.
+	if (Settings.bImportAsTextureAsset || Settings.bExportDefinitionAsset)
+	{
+		const FString PackageName = MakeTextureAssetPath(OutputBasePath + TEXT(".png"));
+		if (!bPagedTextureLoadRequested && !FindPackage(nullptr, *PackageName) && FPackageName::DoesPackageExist(PackageName))
 		{
-			for (int32 x = 0; x < Settings.TileResolution; ++x)
-			{
-				const int32 SrcIndex = y * Settings.TileResolution + x;
-				const FColor& SrcPixelColor = TilePixels[SrcIndex];
+			bPagedTextureLoadRequested = true;
+			OnProgress.Broadcast(WithMemoryHighWater(FText::FromString(TEXT("Loading the virtual texture..."))), 0.9f, 0, 0);
+			LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateWeakLambda(this,
+				[this, OutputBasePath](const FName& LoadedPackageName, UPackage*, const EAsyncLoadingResult::Type Result)
+				{
+					if (Result != EAsyncLoadingResult::Succeeded)
+					{
+						UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Background load of %s failed; it is loaded when the pages are written."),
+							*LoadedPackageName.ToString());
+					}
+					if (bIsShuttingDown || IsEngineExitRequested() || !TileStore.IsValid())
+					{
+						return;
+					}
+					StitchAndSavePages(OutputBasePath);
+				}));
+			return;
+		}
+	}
+	bPagedTextureLoadRequested = false;
+
+	MINIMAP_STAGE_SCOPE(STAT_MinimapComposite);
+	const FIntPoint PageCount = MinimapTextureSource::GetPageCount(FIntPoint(Settings.OutputWidth, Settings.OutputHeight), Settings.UDIMPageSize);
+	const int32 NumPages = PageCount.X * PageCount.Y;
+	PageOutputBasePath = OutputBasePath;
+	FString FirstPagePath;
+
+	// Each stitched page is copied straight into its block of the texture source, so the page files are only the
+	// capture's output and are never decoded again. The source itself holds every page raw (see ValidateTextureMode).
+	UTexture2D* Texture = nullptr;
+	if (Settings.bImportAsTextureAsset || Settings.bExportDefinitionAsset)
+	{
+		FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::TextureImport);
+		Texture = FindOrCreateTextureAsset(MakeTextureAssetPath(OutputBasePath + TEXT(".png")));
+		Texture->Modify();
+		MinimapTextureSource::InitPages(*Texture, PageCount, Settings.UDIMPageSize);
+		PagedTexture = Texture;
+	}
+
+	// Each page is encoded and written on a worker while the next one is stitched. Capping the pages in flight keeps
+	// memory at a few pages instead of the whole map.
+	const int32 MaxPagesInFlight = FMath::Max(2, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	TArray<UE::Tasks::TTask<FMinimapSaveStats>> PageSaveTasks;
+	PageSaveTasks.Reserve(NumPages);
+
+	LLM_SCOPE_BYTAG(MinimapGenerator_CapturedTileData);
+	TArray<FColor> TilePixels;
+	for (int32 PageIndex = 0; PageIndex < NumPages; ++PageIndex)
+	{
+		const FIntPoint PageCoord(PageIndex % PageCount.X, PageIndex / PageCount.X);
+		const FIntRect PageRect(PageCoord * Settings.UDIMPageSize, (PageCoord + 1) * Settings.UDIMPageSize);
+		OnProgress.Broadcast(WithMemoryHighWater(FText::FromString(FString::Printf(TEXT("Stitching page %d/%d..."), PageIndex + 1, NumPages))),
+			0.9f + 0.05f * PageIndex / NumPages, PageIndex, NumPages);
 
-				int32 DstX_on_Canvas, DstY_on_Canvas;
-				if (bIsPortrait)
+		FMinimapTrackedBytes PageBytes;
+		TArray<FColor> Page;
+		{
+			FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::Composite);
+			FMinimapTileStitcher Stitcher(Settings, TileLayout, PageRect);
+			for (int32 TileIndex = 0; TileIndex < TileLayout.GetNumTiles(); ++TileIndex)
+			{
+				FIntPoint StoredSize;
+				if (Stitcher.OverlapsCanvas(TileIndex) && TileStore->GetTile(TileIndex, TilePixels, StoredSize))
 				{
-					DstX_on_Canvas = CanvasStartX + (Settings.TileResolution - 1 - y);
-					DstY_on_Canvas = CanvasStartY + x;
+					Stitcher.AddTile(TileIndex, TilePixels, StoredSize);
 				}
-				else
+			}
+			Page = Stitcher.ReleaseCanvas(PageBytes);
+		}
+
+		if (Texture)
+		{
+			FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::TextureImport);
+			if (!MinimapTextureSource::WritePage(*Texture, PageCoord, Page, PageRect.Size()))
+			{
+				UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("UDIM page %d could not be written to %s; it is left black."),
+					MinimapTextureSource::GetUDIMIndex(PageCoord), *Texture->GetPathName());
+			}
+		}
+
+		if (PageSaveTasks.Num() >= MaxPagesInFlight)
+		{
+			PageSaveTasks[PageSaveTasks.Num() - MaxPagesInFlight].Wait();
+		}
+		FString Path = FString::Printf(TEXT("%s_%d.png"), *OutputBasePath, MinimapTextureSource::GetUDIMIndex(PageCoord));
+		if (PageIndex == 0)
+		{
+			FirstPagePath = Path;
+		}
+		PageSaveTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[Page = MoveTemp(Page), PageBytes = MoveTemp(PageBytes), Size = PageRect.Size(), Path = MoveTemp(Path)]
+			{
+				FMinimapSaveStats SaveStats;
+				double StageStartTime = FPlatformTime::Seconds();
+				TArray64<uint8> Png;
+				const bool bEncoded = MinimapImageKernels::EncodePng(Page, Size, Png);
+				SaveStats.EncodeSeconds = FPlatformTime::Seconds() - StageStartTime;
+				SaveStats.PeakUsedPhysicalBytes = FPlatformMemory::GetStats().UsedPhysical;
+
+				StageStartTime = FPlatformTime::Seconds();
+				if (bEncoded && FFileHelper::SaveArrayToFile(Png, *Path))
 				{
-					DstX_on_Canvas = CanvasStartX + x;
-					DstY_on_Canvas = CanvasStartY + y;
+					SaveStats.BytesWritten = Png.Num();
 				}
+				SaveStats.WriteSeconds = FPlatformTime::Seconds() - StageStartTime;
+				return SaveStats;
+			}));
+	}
+	CaptureReport.SampleMemory();
 
-				if (DstX_on_Canvas >= 0 && DstX_on_Canvas < Settings.OutputWidth &&
-					DstY_on_Canvas >= 0 && DstY_on_Canvas < Settings.OutputHeight)
-				{
-					const int32 DstIndex = DstY_on_Canvas * Settings.OutputWidth + DstX_on_Canvas;
+	if (Texture)
+	{
+		// Only the finished texture is built, once, by the texture compiler.
+		FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::TextureImport);
+		Texture->SRGB = true;
+		Texture->CompressionSettings = TC_Default;
+		Texture->PostEditChange();
+		Texture->MarkPackageDirty();
+		UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Imported minimap virtual texture asset: %s (%dx%d UDIM pages of %d px)"),
+			*Texture->GetPathName(), PageCount.X, PageCount.Y, Settings.UDIMPageSize);
+	}
 
-					// === START OF BLENDING LOGIC ===
-					float BlendAlphaX = 1.0f;
-					float BlendAlphaY = 1.0f;
+	TileStore.Reset();
+	SaveAdditionalBuffers(OutputBasePath);
 
-					// Calculate blend factor for X axis overlap.
-					if (TileCoord.X > 0 && x < Settings.TileOverlap)
-					{
-						BlendAlphaX = static_cast<float>(x) / FMath::Max(1, Settings.TileOverlap - 1);
-					}
+	// Reported like the single image once every page is written, with the first page as the capture's image.
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[ManagerPtr = TWeakObjectPtr<UMinimapGeneratorManager>(this), PageSaveTasks = MoveTemp(PageSaveTasks), FirstPagePath = MoveTemp(FirstPagePath)]() mutable
+		{
+			bool bSuccess = true;
+			FMinimapSaveStats TotalStats;
+			for (UE::Tasks::TTask<FMinimapSaveStats>& PageSave : PageSaveTasks)
+			{
+				const FMinimapSaveStats& SaveStats = PageSave.GetResult();
+				bSuccess &= SaveStats.BytesWritten > 0;
+				TotalStats.EncodeSeconds += SaveStats.EncodeSeconds;
+				TotalStats.WriteSeconds += SaveStats.WriteSeconds;
+				TotalStats.BytesWritten += SaveStats.BytesWritten;
+				TotalStats.PeakUsedPhysicalBytes = FMath::Max(TotalStats.PeakUsedPhysicalBytes, SaveStats.PeakUsedPhysicalBytes);
+			}
 
-					// Calculate blend factor for Y axis overlap.
-					if (TileCoord.Y > 0 && y < Settings.TileOverlap)
-					{
-						BlendAlphaY = static_cast<float>(y) / FMath::Max(1, Settings.TileOverlap - 1);
-					}
+			AsyncTask(ENamedThreads::GameThread, [ManagerPtr, bSuccess, Path = MoveTemp(FirstPagePath), TotalStats]
+			{
+				if (IsEngineExitRequested())
+				{
+					return;
+				}
 
-					// Use the minimum factor to smooth diagonal overlap corners.
-					if (const float FinalBlendAlpha = FMath::Min(BlendAlphaX, BlendAlphaY); FinalBlendAlpha < 1.0f)
-					{
-						// === START OF FIXED BLENDING LOGIC ===
-						// 1) Read existing destination color.
-						const FColor& DstPixelColor = FinalImageData[DstIndex];
+				if (UMinimapGeneratorManager* Manager = ManagerPtr.Get())
+				{
+					Manager->OnSaveTaskCompleted(bSuccess, Path, TotalStats);
+				}
+			});
+		});
+	OnRenderComplete.Broadcast();
+}
 
-						// 2) Convert both colors to linear space.
-						const FLinearColor DstLinear = DstPixelColor; // Automatic conversion
-						const FLinearColor SrcLinear = SrcPixelColor; // Automatic conversion 
+void UMinimapGeneratorManager::SaveAdditionalBuffers(const FString& OutputBasePath)
+{
+	// Empty tiles stay zero in every buffer and floor rather than taking the minimap's background color.
+	FMinimapCaptureSettings BufferSettings = Settings;
+	BufferSettings.BackgroundMode = EMinimapBackgroundMode::Transparent;
+	const FIntPoint CanvasSize(Settings.OutputWidth, Settings.OutputHeight);
 
-						// 3) Blend in linear space (HSV interpolation for smoother colors).
-						const FLinearColor BlendedLinear = FLinearColor::LerpUsingHSV(
-							DstLinear, SrcLinear, FinalBlendAlpha);
+	TArray<FColor> TilePixels;
+	auto StitchAndSave = [this, &BufferSettings, &TilePixels, CanvasSize](FMinimapTileStore& Store, const EMinimapCaptureBuffer Buffer, FString Path)
+	{
+		Store.WaitForPendingTiles();
 
-						// 4) Convert back to FColor and write to the destination image.
-						FinalImageData[DstIndex] = BlendedLinear.ToFColor(true);
-					}
-					else
-					{
-						FinalImageData[DstIndex] = SrcPixelColor;
-					}
-					// === END OF BLENDING LOGIC ===
+		FMinimapTrackedBytes CanvasBytes;
+		TArray<FColor> Canvas;
+		{
+			FMinimapScopedStageTimer StageTimer(CaptureReport, MinimapCaptureStage::Composite);
+			// Blending the two bytes of a 16-bit value separately would corrupt it, so those buffers are not feathered.
+			FMinimapTileStitcher Stitcher(BufferSettings, TileLayout, MinimapCaptureBuffers::Is16Bit(Buffer) ? 0 : INDEX_NONE);
+			for (int32 TileIndex = 0; TileIndex < TileLayout.GetNumTiles(); ++TileIndex)
+			{
+				FIntPoint StoredSize;
+				if (Store.GetTile(TileIndex, TilePixels, StoredSize))
+				{
+					Stitcher.AddTile(TileIndex, TilePixels, StoredSize);
 				}
 			}
+			Canvas = Stitcher.ReleaseCanvas(CanvasBytes);
 		}
+
+		UE::Tasks::TTask<bool> SaveTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[Buffer, Canvas = MoveTemp(Canvas), CanvasBytes = MoveTemp(CanvasBytes), CanvasSize, Path]
+			{
+				TArray64<uint8> Png;
+				return MinimapCaptureBuffers::EncodePng(Buffer, Canvas, CanvasSize, Png) && FFileHelper::SaveArrayToFile(Png, *Path);
+			});
+		BufferSaveTasks.Emplace(MoveTemp(Path), MoveTemp(SaveTask));
+	};
+
+	for (TPair<EMinimapCaptureBuffer, TSharedPtr<FMinimapTileStore>>& Pair : BufferTileStores)
+	{
+		StitchAndSave(*Pair.Value, Pair.Key, FString::Printf(TEXT("%s_%s.png"), *OutputBasePath, MinimapCaptureBuffers::GetFileSuffix(Pair.Key)));
+		Pair.Value.Reset();
 	}
+	BufferTileStores.Empty();
 
-	CapturedTileData.Empty();
-	OnProgress.Broadcast(FText::FromString(TEXT("Saving final image...")), 0.95f, 0, 0);
-	StartImageSaveTask(MoveTemp(FinalImageData), Settings.OutputWidth, Settings.OutputHeight);
+	// Floors are color images like the base map.
+	FloorImagePaths.Empty();
+	for (int32 FloorIndex = 0; FloorIndex < FloorTileStores.Num(); ++FloorIndex)
+	{
+		const FName FloorName = Settings.Floors[FloorIndex].Name;
+		const FString Suffix = FloorName.IsNone() ? FString::FromInt(FloorIndex) : FPaths::MakeValidFileName(FloorName.ToString(), TEXT('_'));
+		FString Path = FString::Printf(TEXT("%s_Floor_%s.png"), *OutputBasePath, *Suffix);
+		FloorImagePaths.Add(Path);
+		StitchAndSave(*FloorTileStores[FloorIndex], EMinimapCaptureBuffer::BaseColor, MoveTemp(Path));
+		FloorTileStores[FloorIndex].Reset();
+	}
+	FloorTileStores.Empty();
 }
 
 void UMinimapGeneratorManager::OnAllTasksCompleted()
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Minimap Generator"), STATGROUP_MinimapGenerator, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grid Planning"), STAT_MinimapGridPlanning, STATGROUP_MinimapGenerator, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Filter Build"), STAT_MinimapFilterBuild, STATGROUP_MinimapGenerator, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tile Render"), STAT_MinimapTileRender, STATGROUP_MinimapGenerator, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Readback"), STAT_MinimapReadback, STATGROUP_MinimapGenerator, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tile Compression"), STAT_MinimapTileCompression, STATGROUP_MinimapGenerator, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Composite"), STAT_MinimapComposite, STATGROUP_MinimapGenerator, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PNG Encode"), STAT_MinimapEncode, STATGROUP_MinimapGenerator, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Disk Write"), STAT_MinimapDiskWrite, STATGROUP_MinimapGenerator, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Texture Import"), STAT_MinimapTextureImport, STATGROUP_MinimapGenerator, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DataAsset Export"), STAT_MinimapDataAssetExport, STATGROUP_MinimapGenerator, );
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Tile Store"), STAT_MinimapTileStoreMemory, STATGROUP_MinimapGenerator, );
+
+// LLM tags for the large capture buffers, reported under "MinimapGenerator" when running with -llm.
+// The same buffers are counted by MinimapMemory so their high-water mark is available without LLM.
+LLM_DECLARE_TAG(MinimapGenerator);
+LLM_DECLARE_TAG(MinimapGenerator_CapturedTileData);
+LLM_DECLARE_TAG(MinimapGenerator_StagingPixelBuffer);
+LLM_DECLARE_TAG(MinimapGenerator_StitchCanvas);
+LLM_DECLARE_TAG(MinimapGenerator_ImageWrapperBuffers);
+LLM_DECLARE_TAG(MinimapGenerator_UncompressedBGRA);
+
+// Cycle counters already emit trace CPU events when stats are compiled in; otherwise fall back to a plain trace scope
+// so the stages still show up in Unreal Insights.
+#if STATS
+#define MINIMAP_STAGE_SCOPE(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define MINIMAP_STAGE_SCOPE(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
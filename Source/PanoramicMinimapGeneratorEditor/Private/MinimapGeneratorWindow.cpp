@@ -2,6 +2,8 @@
 
 
 #include "MinimapGeneratorWindow.h"
+#include "MinimapCaptureQueueSubsystem.h"
+#include "MinimapGeneratorStats.h"
 #include "PanoramicMinimapGeneratorEditor.h"
 
 #include "DesktopPlatformModule.h"
@@ -13,6 +15,7 @@
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Notifications/SProgressBar.h"
 #include "Editor.h"
+#include "LevelEditorViewport.h"
 #include "Selection.h"
 #include "ImageUtils.h"
 #include "Async/Async.h"
@@ -28,6 +31,7 @@
 #include "Widgets/Layout/SSplitter.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
+#include "Widgets/SOverlay.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Misc/MessageDialog.h"
 #include "HAL/PlatformProcess.h"
@@ -35,6 +39,28 @@
 
 #define LOCTEXT_NAMESPACE "SMinimapGeneratorWindow"
 
+/** Parses "Ground=0..400, Upper=400..800" into floor ranges, skipping entries that do not match. */
+static TArray<FMinimapFloorRange> ParseFloorRanges(const FString& Text)
+{
+	TArray<FMinimapFloorRange> Floors;
+	TArray<FString> Entries;
+	Text.ParseIntoArray(Entries, TEXT(","));
+	for (const FString& Entry : Entries)
+	{
+		FString Name, Range, MinZ, MaxZ;
+		if (!Entry.Split(TEXT("="), &Name, &Range) || !Range.Split(TEXT(".."), &MinZ, &MaxZ))
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Ignoring floor \"%s\"; expected Name=MinZ..MaxZ."), *Entry.TrimStartAndEnd());
+			continue;
+		}
+		FMinimapFloorRange& Floor = Floors.AddDefaulted_GetRef();
+		Floor.Name = FName(*Name.TrimStartAndEnd());
+		Floor.MinZ = FCString::Atof(*MinZ.TrimStartAndEnd());
+		Floor.MaxZ = FCString::Atof(*MaxZ.TrimStartAndEnd());
+	}
+	return Floors;
+}
+
 void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 {
 	// --- INITIAL DATA SETUP ---
@@ -42,6 +68,7 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 	Manager = TStrongObjectPtr<UMinimapGeneratorManager>(NewObject<UMinimapGeneratorManager>());
 	Manager->OnProgress.AddSP(this, &SMinimapGeneratorWindow::OnCaptureProgress);
 	Manager->OnCaptureComplete.AddSP(this, &SMinimapGeneratorWindow::HandleCaptureCompleted);
+	Manager->OnPreviewUpdated.AddSP(this, &SMinimapGeneratorWindow::HandlePreviewUpdated);
 	OverlayLayers.AddDefaulted();
 
 	const FString DefaultPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir());
@@ -58,7 +85,7 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 		CurrentCaptureSource = CaptureSourceOptions[4]; // Default to SCS_FinalColorHDR
 	}
 
-	for (int32 i = 5; i <= 14; ++i) // 2^5=32, 2^14=16384
+	for (int32 i = 5; i <= 16; ++i) // 2^5=32, 2^16=65536; beyond 16384 only the Virtual Texture (UDIM) output can be imported
 	{
 		ResolutionOptions.Add(MakeShared<int32>(1 << i));
 	}
@@ -67,6 +94,36 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 	CurrentOutputWidth = ResolutionOptions[7];
 	CurrentOutputHeight = ResolutionOptions[7];
 
+	for (const EMinimapHeatmapMetric Metric : {EMinimapHeatmapMetric::Latency, EMinimapHeatmapMetric::GpuRender,
+	                                           EMinimapHeatmapMetric::Readback, EMinimapHeatmapMetric::StreamingWait})
+	{
+		HeatmapMetricOptions.Add(MakeShared<EMinimapHeatmapMetric>(Metric));
+	}
+
+	for (const EMinimapTileSourceType Type : {EMinimapTileSourceType::SceneCapture, EMinimapTileSourceType::SavedTiles,
+	                                          EMinimapTileSourceType::Synthetic, EMinimapTileSourceType::CpuRaster})
+	{
+		TileSourceOptions.Add(MakeShared<EMinimapTileSourceType>(Type));
+	}
+
+	for (const EMinimapCaptureProfile Profile : MinimapCaptureProfiles::GetAll())
+	{
+		CaptureProfileOptions.Add(MakeShared<EMinimapCaptureProfile>(Profile));
+	}
+
+	const TSharedRef<SWrapBox> AdditionalBuffersBox = SNew(SWrapBox).UseAllottedSize(true);
+	for (const EMinimapCaptureBuffer Buffer : MinimapCaptureBuffers::GetAll())
+	{
+		AdditionalBuffersBox->AddSlot().Padding(2)
+		[
+			SAssignNew(AdditionalBufferCheckboxes.Add(Buffer), SCheckBox)
+			.IsChecked(ECheckBoxState::Unchecked)
+			[
+				SNew(STextBlock).Text(UEnum::GetDisplayValueAsText(Buffer))
+			]
+		];
+	}
+
 	// === NEW LAYOUT STRUCTURE START ===
 	ChildSlot
 	[
@@ -149,6 +206,28 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 								.Text(LOCTEXT("GetBoundsButton", "Get Bounds from Selected Actor"))
 								.OnClicked(this, &SMinimapGeneratorWindow::OnGetBoundsFromSelectionClicked)
 							]
+							+ SGridPanel::Slot(1, 3).Padding(2)
+							[
+								SAssignNew(LoadWorldPartitionRegionCheckbox, SCheckBox)
+								.IsChecked(ECheckBoxState::Unchecked)
+								.ToolTipText(LOCTEXT("LoadWorldPartitionRegionTooltip",
+								                     "World Partition levels only. Loads the cells overlapping the bounds before capturing and unloads them afterwards."))
+								[
+									SNew(STextBlock).Text(LOCTEXT("LoadWorldPartitionRegionLabel", "Load World Partition Region"))
+								]
+							]
+							+ SGridPanel::Slot(0, 4).HAlign(HAlign_Right).VAlign(VAlign_Center).Padding(LabelPadding)
+							[
+								SNew(STextBlock)
+								.Text(LOCTEXT("HLODWorldUnitsPerPixelLabel", "HLODs Above (cm/px)"))
+								.ToolTipText(LOCTEXT("HLODWorldUnitsPerPixelTooltip",
+								                     "When one output pixel covers at least this many centimeters, no cell is loaded and the region is captured from its HLODs, which must be built. 0 always loads the full cells."))
+							]
+							+ SGridPanel::Slot(1, 4).Padding(2)
+							[
+								SAssignNew(HLODWorldUnitsPerPixel, SSpinBox<float>).MinValue(0.0f).MaxValue(100000.0f).Value(1000.0f)
+								.IsEnabled_Lambda([this] { return LoadWorldPartitionRegionCheckbox.IsValid() && LoadWorldPartitionRegionCheckbox->IsChecked(); })
+							]
 						]
 					]
 
@@ -206,6 +285,191 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 										SAssignNew(TileOverlap, SSpinBox<int32>).MinValue(0).MaxValue(1024).Value(1024)
 									]
 								]
+								+ SVerticalBox::Slot().AutoHeight()
+								[
+									SNew(SHorizontalBox)
+									+ SHorizontalBox::Slot().FillWidth(0.4f).VAlign(VAlign_Center)
+									[
+										SNew(STextBlock)
+										.Text(LOCTEXT("CaptureShardsLabel", "Worker Processes"))
+										.ToolTipText(LOCTEXT("CaptureShardsTooltip",
+										                     "Scene Capture only. Renders the tiles in this many headless editor processes on this machine and merges them here. The level must be saved. 1 renders every tile in this editor."))
+									]
+									+ SHorizontalBox::Slot().FillWidth(0.6f)
+									[
+										SAssignNew(CaptureShards, SSpinBox<int32>).MinValue(1).MaxValue(16).Value(1)
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SAssignNew(PersistentViewStateCheckbox, SCheckBox)
+									.IsChecked(ECheckBoxState::Unchecked)
+									.ToolTipText(LOCTEXT("PersistentViewStateTooltip",
+									                     "Keeps temporal history between frames and renders each tile until two frames in a row differ by less than the threshold, instead of reading one frame after a fixed delay."))
+									[
+										SNew(STextBlock).Text(LOCTEXT("PersistentViewStateLabel", "Render Tiles Until Converged"))
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight()
+								[
+									SNew(SHorizontalBox)
+									.IsEnabled_Lambda([this] { return PersistentViewStateCheckbox.IsValid() && PersistentViewStateCheckbox->IsChecked(); })
+									+ SHorizontalBox::Slot().FillWidth(0.4f).VAlign(VAlign_Center)
+									[
+										SNew(STextBlock)
+										.Text(LOCTEXT("ConvergenceThresholdLabel", "Threshold / Max Frames"))
+										.ToolTipText(LOCTEXT("ConvergenceThresholdTooltip",
+										                     "Mean difference per 8-bit channel between two frames below which a tile is read, and the frame count after which it is read anyway."))
+									]
+									+ SHorizontalBox::Slot().FillWidth(0.3f).Padding(0, 0, 5, 0)
+									[
+										SAssignNew(ConvergenceThreshold, SSpinBox<float>).MinValue(0.0f).MaxValue(16.0f).Value(0.5f)
+									]
+									+ SHorizontalBox::Slot().FillWidth(0.3f)
+									[
+										SAssignNew(MaxFramesPerTile, SSpinBox<int32>).MinValue(2).MaxValue(64).Value(8)
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SAssignNew(PixelAlignedTilingCheckbox, SCheckBox)
+									.IsChecked(ECheckBoxState::Unchecked)
+									.ToolTipText(LOCTEXT("PixelAlignedTilingTooltip",
+									                     "Orthographic only. Snaps tiles to exact texel boundaries and stitches them with zero overlap. Tile Overlap is ignored, and temporal AA, TSR and motion blur are turned off."))
+									[
+										SNew(STextBlock).Text(LOCTEXT("PixelAlignedTilingLabel", "Pixel-Aligned Tiling (zero overlap)"))
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SAssignNew(PlanTileLayoutCheckbox, SCheckBox)
+									.IsChecked(ECheckBoxState::Checked)
+									.ToolTipText(LOCTEXT("PlanTileLayoutTooltip",
+									                     "Uses Tile Resolution as the maximum render target size and picks balanced, possibly non-square tiles with shrunk edge tiles to minimize rendered pixels."))
+									[
+										SNew(STextBlock).Text(LOCTEXT("PlanTileLayoutLabel", "Plan Tile Layout (minimize rendered pixels)"))
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SAssignNew(SkipEmptyTilesCheckbox, SCheckBox)
+									.IsChecked(ECheckBoxState::Unchecked)
+									.ToolTipText(LOCTEXT("SkipEmptyTilesTooltip",
+									                     "Orthographic only. Tiles whose footprint contains no visible primitive are filled with the background color instead of being rendered."))
+									[
+										SNew(STextBlock).Text(LOCTEXT("SkipEmptyTilesLabel", "Skip Empty Tiles"))
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SAssignNew(PrestreamTilesCheckbox, SCheckBox)
+									.IsChecked(ECheckBoxState::Unchecked)
+									.ToolTipText(LOCTEXT("PrestreamTilesTooltip",
+									                     "Orthographic only. Forces every mip of the textures and meshes in each tile's footprint to load before it is rendered, one tile ahead, and waits for exactly those instead of a fixed delay."))
+									[
+										SNew(STextBlock).Text(LOCTEXT("PrestreamTilesLabel", "Prestream Tile Textures"))
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SNew(SHorizontalBox)
+									+ SHorizontalBox::Slot().FillWidth(0.4f).VAlign(VAlign_Center)
+									[
+										SNew(STextBlock)
+										.Text(LOCTEXT("AdditionalBuffersLabel", "Additional Buffers"))
+										.ToolTipText(LOCTEXT("AdditionalBuffersTooltip",
+										                     "Scene Capture only. Also renders these buffers at every tile position, right after the color tile, and saves each one as <FileName>_<Buffer>.png: 16-bit grayscale height and depth, RG8 normals, RGBA base color."))
+									]
+									+ SHorizontalBox::Slot().FillWidth(0.6f)
+									[
+										AdditionalBuffersBox
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SNew(SHorizontalBox)
+									+ SHorizontalBox::Slot().FillWidth(0.4f).VAlign(VAlign_Center)
+									[
+										SNew(STextBlock)
+										.Text(LOCTEXT("FloorsLabel", "Floors"))
+										.ToolTipText(LOCTEXT("FloorsTooltip",
+										                     "Scene Capture only. Renders every tile once more per floor, drawing only what overlaps the floor's heights and clipping what is above, and saves each floor as <FileName>_Floor_<Name>.png. Clipping needs Support Global Clip Plane in the project settings."))
+									]
+									+ SHorizontalBox::Slot().FillWidth(0.6f)
+									[
+										SAssignNew(FloorsTextBox, SEditableTextBox)
+										.HintText(LOCTEXT("FloorsHint", "Ground=0..400, Upper=400..800"))
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SAssignNew(CompressTilesCheckbox, SCheckBox)
+									.IsChecked(ECheckBoxState::Checked)
+									.ToolTipText(LOCTEXT("CompressTilesTooltip",
+									                     "Compresses captured tiles in memory and stores identical tiles once until stitching. Reduces peak memory on large grids."))
+									[
+										SNew(STextBlock).Text(LOCTEXT("CompressTilesLabel", "Compress Tiles In Memory"))
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SNew(SHorizontalBox)
+									+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 5, 0)
+									[
+										SNew(STextBlock)
+										.Text(LOCTEXT("TileSourceLabel", "Tile Source"))
+										.ToolTipText(LOCTEXT("TileSourceTooltip",
+										                     "Scene Capture renders the level on the GPU. Saved Tiles re-stitches tiles saved by an earlier capture. Synthetic generates a seamless test pattern. CPU Rasterizer draws the bounds of the visible primitives without a GPU."))
+									]
+									+ SHorizontalBox::Slot().AutoWidth()
+									[
+										SNew(SComboBox<TSharedPtr<EMinimapTileSourceType>>)
+										.OptionsSource(&TileSourceOptions)
+										.InitiallySelectedItem(TileSourceOptions[0])
+										.OnSelectionChanged(this, &SMinimapGeneratorWindow::OnTileSourceChanged)
+										.OnGenerateWidget_Lambda([](const TSharedPtr<EMinimapTileSourceType>& InOption)
+										{
+											return SNew(STextBlock).Text(UEnum::GetDisplayValueAsText(*InOption));
+										})
+										[
+											SNew(STextBlock).Text_Lambda([this] { return UEnum::GetDisplayValueAsText(TileSourceType); })
+										]
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SNew(SHorizontalBox)
+									.Visibility(this, &SMinimapGeneratorWindow::GetSavedTilesVisibility)
+									+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 5, 0)
+									[
+										SNew(STextBlock).Text(LOCTEXT("TileSourceDirectoryLabel", "Tiles Folder"))
+									]
+									+ SHorizontalBox::Slot().FillWidth(1.0f)
+									[
+										SAssignNew(TileSourceDirectory, SEditableTextBox)
+										.HintText(LOCTEXT("TileSourceDirectoryHint", "Output path"))
+										.ToolTipText(LOCTEXT("TileSourceDirectoryTooltip",
+										                     "Folder holding the <File Name>_Tile_X_Y.png tiles saved by an earlier capture with the same layout. Empty uses the output path."))
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SAssignNew(RenderMissingTilesCheckbox, SCheckBox)
+									.Visibility(this, &SMinimapGeneratorWindow::GetSavedTilesVisibility)
+									.IsChecked(ECheckBoxState::Checked)
+									.ToolTipText(LOCTEXT("RenderMissingTilesTooltip",
+									                     "Renders tiles missing from the folder with the scene capture. Delete stale tiles and capture again to re-render only those."))
+									[
+										SNew(STextBlock).Text(LOCTEXT("RenderMissingTilesLabel", "Render Missing Tiles"))
+									]
+								]
+								+ SVerticalBox::Slot().AutoHeight().Padding(0, 5, 0, 0)
+								[
+									SNew(STextBlock)
+									.Text(this, &SMinimapGeneratorWindow::GetTileLayoutSummaryText)
+									.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+									.AutoWrapText(true)
+								]
 							]
 						]
 					]
@@ -356,9 +620,44 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 						[
 							SNew(SVerticalBox)
 							+ SVerticalBox::Slot().AutoHeight().Padding(15, 5)
+							[
+								SNew(SHorizontalBox)
+								+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 5, 0)
+								[
+									SNew(STextBlock)
+									.Text(LOCTEXT("CaptureProfileLabel", "Capture Profile"))
+									.ToolTipText(LOCTEXT("CaptureProfileTooltip",
+									                     "Render features the capture pays for. Schematic, Fast, Balanced and Cinematic each set every show flag and matching post-process overrides, replacing the options below. Custom keeps the engine defaults."))
+								]
+								+ SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 5, 0)
+								[
+									SNew(SComboBox<TSharedPtr<EMinimapCaptureProfile>>)
+									.OptionsSource(&CaptureProfileOptions)
+									.InitiallySelectedItem(CaptureProfileOptions.Last())
+									.OnSelectionChanged(this, &SMinimapGeneratorWindow::OnCaptureProfileChanged)
+									.OnGenerateWidget_Lambda([this](const TSharedPtr<EMinimapCaptureProfile>& InOption)
+									{
+										return SNew(STextBlock).Text(GetCaptureProfileText(*InOption));
+									})
+									[
+										SNew(STextBlock).Text_Lambda([this] { return GetCaptureProfileText(CaptureProfile); })
+									]
+								]
+								+ SHorizontalBox::Slot().AutoWidth()
+								[
+									SNew(SButton)
+									.Text(LOCTEXT("MeasureProfilesButton", "Measure"))
+									.ToolTipText(LOCTEXT("MeasureProfilesTooltip",
+									                     "Renders one tile at the center of the capture region with every profile and shows the GPU time per tile next to each. Blocks the editor for a few seconds."))
+									.IsEnabled_Lambda([this]() { return StartButton.IsValid() && StartButton->IsEnabled(); })
+									.OnClicked(this, &SMinimapGeneratorWindow::OnMeasureCaptureProfilesClicked)
+								]
+							]
+							+ SVerticalBox::Slot().AutoHeight().Padding(15, 5)
 							[
 								SAssignNew(CaptureDynamicShadowsCheckbox, SCheckBox)
 								.IsChecked(ECheckBoxState::Checked)
+								.IsEnabled_Lambda([this] { return CaptureProfile == EMinimapCaptureProfile::Custom; })
 								[
 									SNew(STextBlock).Text(LOCTEXT("DynamicShadowsLabel", "Capture Dynamic Shadows"))
 								]
@@ -656,7 +955,17 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 								[
 									SNew(SScaleBox).Stretch(EStretch::ScaleToFit)
 									[
-										SAssignNew(FinalImageView, SImage)
+										SNew(SOverlay)
+										+ SOverlay::Slot()
+										[
+											SAssignNew(FinalImageView, SImage)
+										]
+										+ SOverlay::Slot()
+										[
+											SAssignNew(FitHeatmap, SMinimapTileHeatmap)
+											.Metric(this, &SMinimapGeneratorWindow::GetHeatmapMetric)
+											.Visibility(this, &SMinimapGeneratorWindow::GetHeatmapVisibility)
+										]
 									]
 								]
 								+ SWidgetSwitcher::Slot()
@@ -675,7 +984,17 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 											.WidthOverride(this, &SMinimapGeneratorWindow::GetPreviewZoomedWidth)
 											.HeightOverride(this, &SMinimapGeneratorWindow::GetPreviewZoomedHeight)
 											[
-												SAssignNew(ZoomedImageView, SImage)
+												SNew(SOverlay)
+												+ SOverlay::Slot()
+												[
+													SAssignNew(ZoomedImageView, SImage)
+												]
+												+ SOverlay::Slot()
+												[
+													SAssignNew(ZoomedHeatmap, SMinimapTileHeatmap)
+													.Metric(this, &SMinimapGeneratorWindow::GetHeatmapMetric)
+													.Visibility(this, &SMinimapGeneratorWindow::GetHeatmapVisibility)
+												]
 											]
 										]
 									]
@@ -695,6 +1014,30 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 						.Text(FText::GetEmpty())
 					]
 					+ SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 5, 0).VAlign(VAlign_Center)
+					[
+						SAssignNew(ShowHeatmapCheckbox, SCheckBox)
+						.IsChecked(ECheckBoxState::Unchecked)
+						.ToolTipText(LOCTEXT("ShowHeatmapTooltip", "Overlay the per-tile render cost of the last capture on the preview. Hover a tile for its exact timings."))
+						[
+							SNew(STextBlock).Text(LOCTEXT("ShowHeatmapLabel", "Heatmap"))
+						]
+					]
+					+ SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 10, 0).VAlign(VAlign_Center)
+					[
+						SNew(SComboBox<TSharedPtr<EMinimapHeatmapMetric>>)
+						.OptionsSource(&HeatmapMetricOptions)
+						.InitiallySelectedItem(HeatmapMetricOptions[0])
+						.OnSelectionChanged(this, &SMinimapGeneratorWindow::OnHeatmapMetricChanged)
+						.IsEnabled_Lambda([this] { return ShowHeatmapCheckbox.IsValid() && ShowHeatmapCheckbox->IsChecked(); })
+						.OnGenerateWidget_Lambda([](const TSharedPtr<EMinimapHeatmapMetric>& InOption)
+						{
+							return SNew(STextBlock).Text(SMinimapTileHeatmap::GetMetricDisplayName(*InOption));
+						})
+						[
+							SNew(STextBlock).Text_Lambda([this] { return SMinimapTileHeatmap::GetMetricDisplayName(HeatmapMetric); })
+						]
+					]
+					+ SHorizontalBox::Slot().AutoWidth().Padding(0, 0, 5, 0).VAlign(VAlign_Center)
 					[
 						SNew(SButton)
 						.Text(LOCTEXT("ZoomOutBtn", "-"))
@@ -920,6 +1263,56 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 							.Size(FVector2D(100.f, 20.f))
 							.Visibility(this, &SMinimapGeneratorWindow::GetBackgroundColorPickerVisibility)
 						]
+						+ SGridPanel::Slot(0, 12).HAlign(HAlign_Right).Padding(LabelPadding)
+						[
+							SNew(STextBlock)
+							.Text(LOCTEXT("PatchTargetLabel", "Patch Target"))
+							.ToolTipText(LOCTEXT("PatchTargetTooltip",
+							                     "Minimap updated by the Patch button: only the tiles covering the capture region are rendered, at this DataAsset's bounds, size and rotation, and feathered into its base map texture in place."))
+						]
+						+ SGridPanel::Slot(1, 12)
+						[
+							SNew(SObjectPropertyEntryBox)
+							.AllowedClass(UMinimapDefinitionDataAsset::StaticClass())
+							.ObjectPath_Lambda([this]() { return PatchTarget.ToSoftObjectPath().ToString(); })
+							.OnObjectChanged_Lambda([this](const FAssetData& AssetData)
+							{
+								PatchTarget = TSoftObjectPtr<UMinimapDefinitionDataAsset>(AssetData.GetSoftObjectPath());
+							})
+							.AllowClear(true)
+							.DisplayThumbnail(false)
+						]
+						+ SGridPanel::Slot(1, 13).Padding(0, 5, 0, 0)
+						[
+							SNew(SHorizontalBox)
+							+ SHorizontalBox::Slot().FillWidth(0.6f).VAlign(VAlign_Center)
+							[
+								SAssignNew(VirtualTextureCheckbox, SCheckBox)
+								.IsChecked(ECheckBoxState::Unchecked)
+								.ToolTipText(LOCTEXT("VirtualTextureTooltip",
+								                     "Tiled captures only. Stitches the tiles page by page into <File Name>_1001.png, _1002.png, ... and imports them as one streaming virtual texture, so maps larger than 16384 px can be imported and only the pages on screen are loaded. The project needs virtual texture support enabled."))
+								[
+									SNew(STextBlock).Text(LOCTEXT("VirtualTextureLabel", "Virtual Texture (UDIM) / Page Size"))
+								]
+							]
+							+ SHorizontalBox::Slot().FillWidth(0.4f)
+							[
+								SAssignNew(UDIMPageSizeSpinBox, SSpinBox<int32>).MinValue(512).MaxValue(8192).Delta(512).Value(4096)
+								.IsEnabled_Lambda([this] { return VirtualTextureCheckbox.IsValid() && VirtualTextureCheckbox->IsChecked(); })
+							]
+						]
+						+ SGridPanel::Slot(0, 14).HAlign(HAlign_Right).Padding(LabelPadding)
+						[
+							SNew(STextBlock)
+							.Text(LOCTEXT("UDIMSourceBudgetLabel", "UDIM Source Budget (MB)"))
+							.ToolTipText(LOCTEXT("UDIMSourceBudgetTooltip",
+							                     "Largest virtual texture source the import may create. The engine keeps UDIM pages uncompressed, so the source is held whole in editor memory and saved in the package at 4 bytes per pixel; larger captures stop with an error before rendering."))
+						]
+						+ SGridPanel::Slot(1, 14).Padding(0, 5, 0, 0)
+						[
+							SAssignNew(UDIMSourceBudgetSpinBox, SSpinBox<int32>).MinValue(256).MaxValue(65536).Delta(256).Value(2048)
+							.IsEnabled_Lambda([this] { return VirtualTextureCheckbox.IsValid() && VirtualTextureCheckbox->IsChecked(); })
+						]
 					]
 				]
 			]
@@ -931,6 +1324,21 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 		[
 			SNew(SVerticalBox)
 			+ SVerticalBox::Slot().AutoHeight().Padding(0, 5)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().FillWidth(0.4f).VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("MemoryBudgetLabel", "Memory Budget (MB)"))
+					.ToolTipText(LOCTEXT("MemoryBudgetTooltip",
+					                     "RAM the capture may use. Estimate recommends settings that fit it. 0 uses the physical memory currently available."))
+				]
+				+ SHorizontalBox::Slot().FillWidth(0.6f)
+				[
+					SAssignNew(MemoryBudgetSpinBox, SSpinBox<int32>).MinValue(0).MaxValue(1024 * 1024).Delta(512).Value(0)
+				]
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0, 5)
 			[
 				SNew(SHorizontalBox)
 				+ SHorizontalBox::Slot().FillWidth(1.0f).HAlign(HAlign_Center)
@@ -940,6 +1348,33 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 					.OnClicked(this, &SMinimapGeneratorWindow::OnStartCaptureClicked)
 				]
 				+ SHorizontalBox::Slot().AutoWidth().Padding(5, 0, 0, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("EstimateCaptureButton", "Estimate"))
+					.ToolTipText(LOCTEXT("EstimateCaptureTooltip",
+					                     "Dry run: renders a short calibration capture and predicts time, peak RAM/VRAM and disk usage for the current settings, with recommendations for the memory budget."))
+					.IsEnabled_Lambda([this]() { return StartButton.IsValid() && StartButton->IsEnabled(); })
+					.OnClicked(this, &SMinimapGeneratorWindow::OnEstimateCaptureClicked)
+				]
+				+ SHorizontalBox::Slot().AutoWidth().Padding(5, 0, 0, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("ProgressivePreviewButton", "Preview"))
+					.ToolTipText(LOCTEXT("ProgressivePreviewTooltip",
+					                     "Shows a coarse capture of the region at once to check the framing, then refines it tile by tile, starting under the viewport camera or the mouse. Nothing is saved."))
+					.IsEnabled_Lambda([this]() { return StartButton.IsValid() && StartButton->IsEnabled(); })
+					.OnClicked(this, &SMinimapGeneratorWindow::OnProgressivePreviewClicked)
+				]
+				+ SHorizontalBox::Slot().AutoWidth().Padding(5, 0, 0, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("PatchCaptureButton", "Patch"))
+					.ToolTipText(LOCTEXT("PatchCaptureTooltip",
+					                     "Recaptures only the capture region and blends it into the Patch Target's base map texture, e.g. after editing one area. Use the settings of the original capture."))
+					.IsEnabled_Lambda([this]() { return StartButton.IsValid() && StartButton->IsEnabled() && !PatchTarget.IsNull(); })
+					.OnClicked(this, &SMinimapGeneratorWindow::OnPatchCaptureClicked)
+				]
+				+ SHorizontalBox::Slot().AutoWidth().Padding(5, 0, 0, 0)
 				[
 					SAssignNew(CancelButton, SButton)
 					.Text(LOCTEXT("CancelCaptureButton", "Cancel"))
@@ -958,6 +1393,10 @@ void SMinimapGeneratorWindow::Construct(const FArguments& InArgs)
 		]
 	];
 
+	// Hovering the preview while it refines moves the refinement under the mouse.
+	FinalImageView->SetOnMouseMove(FPointerEventHandler::CreateSP(this, &SMinimapGeneratorWindow::OnPreviewMouseMove));
+	ZoomedImageView->SetOnMouseMove(FPointerEventHandler::CreateSP(this, &SMinimapGeneratorWindow::OnPreviewMouseMove));
+
 	// Load settings from config
 	LoadSettings();
 }
@@ -985,6 +1424,7 @@ void SMinimapGeneratorWindow::UnbindManagerDelegates()
 	{
 		Manager->OnProgress.RemoveAll(this);
 		Manager->OnCaptureComplete.RemoveAll(this);
+		Manager->OnPreviewUpdated.RemoveAll(this);
 	}
 }
 
@@ -999,10 +1439,91 @@ void SMinimapGeneratorWindow::ReleasePreviewResources()
 		ZoomedImageView->SetImage(nullptr);
 	}
 
+	if (FitHeatmap.IsValid())
+	{
+		FitHeatmap->ClearTiles();
+	}
+	if (ZoomedHeatmap.IsValid())
+	{
+		ZoomedHeatmap->ClearTiles();
+	}
+
 	FinalImageBrushSource.Reset();
+	ProgressivePreviewTexture.Reset();
 	LastSavedImagePath.Reset();
 }
 
+EVisibility SMinimapGeneratorWindow::GetHeatmapVisibility() const
+{
+	return ShowHeatmapCheckbox.IsValid() && ShowHeatmapCheckbox->IsChecked() && FitHeatmap.IsValid() && FitHeatmap->HasTiles()
+		       ? EVisibility::Visible
+		       : EVisibility::Collapsed;
+}
+
+void SMinimapGeneratorWindow::OnTileSourceChanged(TSharedPtr<EMinimapTileSourceType> NewSelection, ESelectInfo::Type SelectInfo)
+{
+	if (NewSelection.IsValid())
+	{
+		TileSourceType = *NewSelection;
+	}
+}
+
+void SMinimapGeneratorWindow::OnCaptureProfileChanged(TSharedPtr<EMinimapCaptureProfile> NewSelection, ESelectInfo::Type SelectInfo)
+{
+	if (NewSelection.IsValid())
+	{
+		CaptureProfile = *NewSelection;
+	}
+}
+
+FText SMinimapGeneratorWindow::GetCaptureProfileText(const EMinimapCaptureProfile Profile) const
+{
+	const FMinimapCaptureProfileCost* Cost = CaptureProfileCosts.FindByPredicate(
+		[Profile](const FMinimapCaptureProfileCost& Candidate) { return Candidate.Profile == Profile; });
+	if (!Cost)
+	{
+		return UEnum::GetDisplayValueAsText(Profile);
+	}
+	return FText::Format(LOCTEXT("CaptureProfileCostFmt", "{0} ({1} ms/tile)"), UEnum::GetDisplayValueAsText(Profile),
+	                     FText::AsNumber(Cost->GpuMillisecondsPerTile >= 0.0 ? Cost->GpuMillisecondsPerTile : Cost->WallMillisecondsPerTile,
+	                                     &FNumberFormattingOptions().SetMaximumFractionalDigits(1)));
+}
+
+FReply SMinimapGeneratorWindow::OnMeasureCaptureProfilesClicked()
+{
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Measure capture profiles button clicked."));
+	if (!Manager.IsValid())
+	{
+		return FReply::Handled();
+	}
+
+	CollectSettingsFromUI();
+	FString Error;
+	TArray<FMinimapCaptureProfileCost> Costs = Manager->MeasureCaptureProfiles(Settings, Error);
+	if (Costs.IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("MeasureProfilesFailedFmt", "Could not measure the capture profiles: {0}"),
+		                                                    FText::FromString(Error)));
+		return FReply::Handled();
+	}
+
+	CaptureProfileCosts = MoveTemp(Costs);
+	return FReply::Handled();
+}
+
+EVisibility SMinimapGeneratorWindow::GetSavedTilesVisibility() const
+{
+	return TileSourceType == EMinimapTileSourceType::SavedTiles ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+void SMinimapGeneratorWindow::OnHeatmapMetricChanged(TSharedPtr<EMinimapHeatmapMetric> NewSelection, ESelectInfo::Type SelectInfo)
+{
+	if (NewSelection.IsValid())
+	{
+		HeatmapMetric = *NewSelection;
+	}
+}
+
 void SMinimapGeneratorWindow::HandleCaptureCompleted(bool bSuccess, const FString& FinalImagePath)
 {
 	if (IsEngineExitRequested() || !FSlateApplication::IsInitialized())
@@ -1043,11 +1564,22 @@ void SMinimapGeneratorWindow::HandleCaptureCompleted(bool bSuccess, const FStrin
 		false
 	);
 
+	// The progressive preview writes nothing; what it rendered is already on screen.
+	if (bIsPreviewing)
+	{
+		bIsPreviewing = false;
+		return;
+	}
+
 	if (bSuccess && !FinalImagePath.IsEmpty() && IFileManager::Get().FileExists(*FinalImagePath))
 	{
 		LastSavedImagePath = FinalImagePath;
 		OpenFolderButton->SetVisibility(EVisibility::Visible);
 
+		// Per-tile timings of this capture feed the render-cost heatmap over the preview.
+		FitHeatmap->SetTiles(Manager->GetTileLayout(), Manager->GetCaptureReport().Tiles);
+		ZoomedHeatmap->SetTiles(Manager->GetTileLayout(), Manager->GetCaptureReport().Tiles);
+
 		// Get file size
 		const int64 FileSize = IFileManager::Get().FileSize(*FinalImagePath);
 		const FString FileSizeStr = FString::Printf(TEXT("%.2f MB"), FileSize / (1024.0f * 1024.0f));
@@ -1064,6 +1596,7 @@ void SMinimapGeneratorWindow::HandleCaptureCompleted(bool bSuccess, const FStrin
 				return TArray<uint8>();
 			}
 
+			LLM_SCOPE_BYTAG(MinimapGenerator_ImageWrapperBuffers);
 			TArray<uint8> PngData;
 			if (!FFileHelper::LoadFileToArray(PngData, *ImagePath))
 			{
@@ -1255,6 +1788,28 @@ EVisibility SMinimapGeneratorWindow::GetTilingSettingsVisibility() const
 }
 
 // START ZOOM FUNCTIONALITY
+FText SMinimapGeneratorWindow::GetTileLayoutSummaryText() const
+{
+	if (!TileResolution.IsValid() || !TileOverlap.IsValid() || !CurrentOutputWidth.IsValid() || !CurrentOutputHeight.IsValid() ||
+		!PixelAlignedTilingCheckbox.IsValid() || !PlanTileLayoutCheckbox.IsValid() || !IsOrthographicCheckbox.IsValid())
+	{
+		return FText::GetEmpty();
+	}
+
+	FMinimapCaptureSettings PreviewSettings;
+	PreviewSettings.bUseTiling = true;
+	PreviewSettings.OutputWidth = *CurrentOutputWidth;
+	PreviewSettings.OutputHeight = *CurrentOutputHeight;
+	PreviewSettings.TileResolution = TileResolution->GetValue();
+	PreviewSettings.TileOverlap = TileOverlap->GetValue();
+	PreviewSettings.bIsOrthographic = IsOrthographicCheckbox->IsChecked();
+	PreviewSettings.bPixelAlignedTiling = PixelAlignedTilingCheckbox->IsChecked();
+	PreviewSettings.bPlanTileLayout = PlanTileLayoutCheckbox->IsChecked();
+
+	const FMinimapTileLayout Layout = UMinimapGeneratorManager::MakeTileLayout(PreviewSettings);
+	return FText::Format(LOCTEXT("TileLayoutSummary", "Planned layout: {0}"), FText::FromString(Layout.ToString()));
+}
+
 FReply SMinimapGeneratorWindow::OnZoomInClicked()
 {
 	if (PreviewZoomFactor == 0.0f) PreviewZoomFactor = 1.0f;
@@ -1344,44 +1899,14 @@ FReply SMinimapGeneratorWindow::OnCancelCaptureClicked()
 	return FReply::Handled();
 }
 
-FReply SMinimapGeneratorWindow::OnStartCaptureClicked()
+void SMinimapGeneratorWindow::CollectSettingsFromUI()
 {
-	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Start Capture button clicked."));
-
-	// Validation
-	const FVector MinBounds(BoundsMinX->GetValue(), BoundsMinY->GetValue(), BoundsMinZ->GetValue());
-	const FVector MaxBounds(BoundsMaxX->GetValue(), BoundsMaxY->GetValue(), BoundsMaxZ->GetValue());
-	if (MinBounds.X >= MaxBounds.X || MinBounds.Y >= MaxBounds.Y)
-	{
-		FMessageDialog::Open(EAppMsgType::Ok,
-			LOCTEXT("InvalidBoundsMsg", "Capture region is invalid. Min bounds must be less than Max bounds on X and Y axes.\n\nTip: Use 'Get Bounds from Selected Actor' to auto-fill."));
-		return FReply::Handled();
-	}
-
-	FString PathStr = OutputPath->GetText().ToString();
-	if (PathStr.IsEmpty())
-	{
-		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("EmptyPathMsg", "Output path cannot be empty."));
-		return FReply::Handled();
-	}
-
-	if (!IFileManager::Get().DirectoryExists(*PathStr))
-	{
-		if (!IFileManager::Get().MakeDirectory(*PathStr, true))
-		{
-			FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("InvalidPathMsg", "Output path does not exist and could not be created."));
-			return FReply::Handled();
-		}
-	}
-
-	StartButton->SetEnabled(false);
-	CancelButton->SetVisibility(EVisibility::Visible);
-
-	// Collect values from all UI widgets.
 	Settings.CaptureBounds = FBox(
 		FVector(BoundsMinX->GetValue(), BoundsMinY->GetValue(), BoundsMinZ->GetValue()),
 		FVector(BoundsMaxX->GetValue(), BoundsMaxY->GetValue(), BoundsMaxZ->GetValue())
 	);
+	Settings.bLoadWorldPartitionRegion = LoadWorldPartitionRegionCheckbox->IsChecked();
+	Settings.HLODWorldUnitsPerPixel = HLODWorldUnitsPerPixel->GetValue();
 	Settings.OutputWidth = *CurrentOutputWidth;
 	Settings.OutputHeight = *CurrentOutputHeight;
 	Settings.OutputPath = OutputPath->GetText().ToString();
@@ -1404,9 +1929,34 @@ FReply SMinimapGeneratorWindow::OnStartCaptureClicked()
 		Settings.bImportAsTextureAsset = true;
 		Settings.AssetPath = AssetPathTextBox->GetText().ToString();
 	}
+	Settings.TextureMode = VirtualTextureCheckbox->IsChecked() ? EMinimapTextureMode::VirtualTextureUDIM : EMinimapTextureMode::SingleTexture;
+	Settings.UDIMPageSize = UDIMPageSizeSpinBox->GetValue();
+	Settings.UDIMSourceBudgetMB = UDIMSourceBudgetSpinBox->GetValue();
 	Settings.bUseTiling = UseTilingCheckbox->IsChecked();
 	Settings.TileResolution = TileResolution->GetValue();
 	Settings.TileOverlap = TileOverlap->GetValue();
+	Settings.NumCaptureShards = CaptureShards->GetValue();
+	Settings.bPersistentViewState = PersistentViewStateCheckbox->IsChecked();
+	Settings.ConvergenceThreshold = ConvergenceThreshold->GetValue();
+	Settings.MaxFramesPerTile = MaxFramesPerTile->GetValue();
+	Settings.bPixelAlignedTiling = PixelAlignedTilingCheckbox->IsChecked();
+	Settings.bPlanTileLayout = PlanTileLayoutCheckbox->IsChecked();
+	Settings.bSkipEmptyTiles = SkipEmptyTilesCheckbox->IsChecked();
+	Settings.bPrestreamTiles = PrestreamTilesCheckbox->IsChecked();
+	Settings.AdditionalBuffers.Reset();
+	for (const TPair<EMinimapCaptureBuffer, TSharedPtr<SCheckBox>>& Pair : AdditionalBufferCheckboxes)
+	{
+		if (Pair.Value->IsChecked())
+		{
+			Settings.AdditionalBuffers.Add(Pair.Key);
+		}
+	}
+	Settings.Floors = ParseFloorRanges(FloorsTextBox->GetText().ToString());
+	Settings.TileSourceType = TileSourceType;
+	Settings.TileSourceDirectory = TileSourceDirectory->GetText().ToString();
+	Settings.bRenderMissingTiles = RenderMissingTilesCheckbox->IsChecked();
+	Settings.bCompressTilesInMemory = CompressTilesCheckbox->IsChecked();
+	Settings.MemoryBudgetMB = MemoryBudgetSpinBox->GetValue();
 	Settings.CameraHeight = CameraHeight->GetValue();
 	// Note FRotator constructor argument order: (Pitch, Yaw, Roll).
 	Settings.CameraRotation = FRotator(
@@ -1416,6 +1966,7 @@ FReply SMinimapGeneratorWindow::OnStartCaptureClicked()
 	);
 	Settings.bIsOrthographic = IsOrthographicCheckbox->IsChecked();
 	Settings.CameraFOV = CameraFOV->GetValue();
+	Settings.CaptureProfile = CaptureProfile;
 	Settings.bCaptureDynamicShadows = CaptureDynamicShadowsCheckbox->IsChecked();
 	Settings.bOverrideWithHighQualitySettings = OverrideQualityCheckbox->IsChecked();
 	if (Settings.bOverrideWithHighQualitySettings)
@@ -1435,6 +1986,196 @@ FReply SMinimapGeneratorWindow::OnStartCaptureClicked()
 	}
 	Settings.ActorTagFilter = FName(*ActorTagFilterTextBox->GetText().ToString());
 	Settings.OverlayLayers = OverlayLayers;
+}
+
+FReply SMinimapGeneratorWindow::OnProgressivePreviewClicked()
+{
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Preview button clicked."));
+	const FVector MinBounds(BoundsMinX->GetValue(), BoundsMinY->GetValue(), BoundsMinZ->GetValue());
+	const FVector MaxBounds(BoundsMaxX->GetValue(), BoundsMaxY->GetValue(), BoundsMaxZ->GetValue());
+	if (MinBounds.X >= MaxBounds.X || MinBounds.Y >= MaxBounds.Y)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok,
+			LOCTEXT("InvalidBoundsMsg", "Capture region is invalid. Min bounds must be less than Max bounds on X and Y axes.\n\nTip: Use 'Get Bounds from Selected Actor' to auto-fill."));
+		return FReply::Handled();
+	}
+
+	if (const UMinimapCaptureQueueSubsystem* Queue = GEditor->GetEditorSubsystem<UMinimapCaptureQueueSubsystem>(); Queue && Queue->IsRunning())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok,
+			LOCTEXT("CaptureQueueRunningMsg", "A batch of minimap captures is running. Wait for it to finish or cancel it before starting another capture."));
+		return FReply::Handled();
+	}
+
+	CollectSettingsFromUI();
+
+	// Refine from what the level viewport is looking at; the region center when there is no viewport.
+	const FVector FocusLocation = GCurrentLevelEditingViewportClient
+		                              ? GCurrentLevelEditingViewportClient->GetViewLocation()
+		                              : Settings.CaptureBounds.GetCenter();
+
+	StartButton->SetEnabled(false);
+	CancelButton->SetVisibility(EVisibility::Visible);
+	ProgressBar->SetVisibility(EVisibility::Visible);
+	StatusText->SetVisibility(EVisibility::Visible);
+	OnCaptureProgress(LOCTEXT("StartingPreview", "Starting preview..."), 0.f, 0, 0);
+
+	ReleasePreviewResources();
+	OpenFolderButton->SetVisibility(EVisibility::Collapsed);
+	bIsPreviewing = true;
+	Manager->StartProgressivePreview(Settings, FocusLocation);
+	return FReply::Handled();
+}
+
+void SMinimapGeneratorWindow::HandlePreviewUpdated(TConstArrayView<FColor> Canvas, const FIntPoint& CanvasSize, const FIntRect& DirtyRect)
+{
+	if (IsEngineExitRequested() || !FSlateApplication::IsInitialized() || Canvas.Num() != CanvasSize.X * CanvasSize.Y)
+	{
+		return;
+	}
+
+	UTexture2D* PreviewTexture = ProgressivePreviewTexture.Get();
+	if (!PreviewTexture || PreviewTexture->GetSizeX() != CanvasSize.X || PreviewTexture->GetSizeY() != CanvasSize.Y)
+	{
+		// First update of a preview: the coarse pass stretched over the whole canvas.
+		PreviewTexture = UTexture2D::CreateTransient(CanvasSize.X, CanvasSize.Y, PF_B8G8R8A8);
+		if (!PreviewTexture)
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to create transient texture for preview."));
+			return;
+		}
+
+		void* MipData = PreviewTexture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(MipData, Canvas.GetData(), Canvas.Num() * sizeof(FColor));
+		PreviewTexture->GetPlatformData()->Mips[0].BulkData.Unlock();
+		PreviewTexture->UpdateResource();
+		ProgressivePreviewTexture = PreviewTexture;
+
+		FinalImageBrushSource = FDeferredCleanupSlateBrush::CreateBrush(PreviewTexture, FVector2D(CanvasSize.X, CanvasSize.Y));
+		FinalImageView->SetImage(FinalImageBrushSource->GetSlateBrush());
+		ZoomedImageView->SetImage(FinalImageBrushSource->GetSlateBrush());
+		PreviewZoomFactor = 0.0f;
+		PreviewSwitcher->SetActiveWidgetIndex(0);
+		ImageContainer->SetVisibility(EVisibility::Visible);
+		ImageInfoText->SetText(FText::Format(LOCTEXT("PreviewInfo", "{0}x{1} • Preview, not saved"), CanvasSize.X, CanvasSize.Y));
+		return;
+	}
+
+	// Only the refined tile is uploaded; the copy is freed once the render thread is done with it.
+	const FIntRect Rect(DirtyRect.Min.ComponentMax(FIntPoint::ZeroValue), DirtyRect.Max.ComponentMin(CanvasSize));
+	if (Rect.Width() <= 0 || Rect.Height() <= 0)
+	{
+		return;
+	}
+	const int32 RowBytes = Rect.Width() * sizeof(FColor);
+	uint8* RegionData = static_cast<uint8*>(FMemory::Malloc(static_cast<SIZE_T>(RowBytes) * Rect.Height()));
+	for (int32 Y = 0; Y < Rect.Height(); ++Y)
+	{
+		FMemory::Memcpy(RegionData + static_cast<SIZE_T>(Y) * RowBytes, &Canvas[(Rect.Min.Y + Y) * CanvasSize.X + Rect.Min.X], RowBytes);
+	}
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(Rect.Min.X, Rect.Min.Y, 0, 0, Rect.Width(), Rect.Height());
+	PreviewTexture->UpdateTextureRegions(0, 1, Region, RowBytes, sizeof(FColor), RegionData,
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+		{
+			FMemory::Free(SrcData);
+			delete Regions;
+		});
+}
+
+FReply SMinimapGeneratorWindow::OnPreviewMouseMove(const FGeometry& Geometry, const FPointerEvent& MouseEvent)
+{
+	if (bIsPreviewing && Manager.IsValid() && Manager->IsRefiningPreview())
+	{
+		const FVector2D LocalSize = Geometry.GetLocalSize();
+		if (LocalSize.X > 0.0 && LocalSize.Y > 0.0)
+		{
+			Manager->SetPreviewFocus(Geometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()) / LocalSize);
+		}
+	}
+	return FReply::Unhandled();
+}
+
+FReply SMinimapGeneratorWindow::OnEstimateCaptureClicked()
+{
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Estimate button clicked."));
+	if (!Manager.IsValid())
+	{
+		return FReply::Handled();
+	}
+
+	CollectSettingsFromUI();
+	const FMinimapCaptureEstimate Estimate = Manager->EstimateCapture(Settings);
+	FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Estimate.ToString()));
+	return FReply::Handled();
+}
+
+FReply SMinimapGeneratorWindow::OnStartCaptureClicked()
+{
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Start Capture button clicked."));
+	if (PrepareCaptureStart())
+	{
+		Manager->StartCaptureProcess(Settings);
+	}
+	return FReply::Handled();
+}
+
+FReply SMinimapGeneratorWindow::OnPatchCaptureClicked()
+{
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Patch button clicked."));
+	UMinimapDefinitionDataAsset* Target = PatchTarget.LoadSynchronous();
+	if (!Target || !Target->BaseMapTexture)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok,
+			LOCTEXT("InvalidPatchTargetMsg", "The Patch Target needs a minimap DataAsset with a base map texture."));
+		return FReply::Handled();
+	}
+
+	if (PrepareCaptureStart())
+	{
+		Manager->StartPatchCapture(Settings, Target, Settings.CaptureBounds);
+	}
+	return FReply::Handled();
+}
+
+bool SMinimapGeneratorWindow::PrepareCaptureStart()
+{
+	// Validation
+	const FVector MinBounds(BoundsMinX->GetValue(), BoundsMinY->GetValue(), BoundsMinZ->GetValue());
+	const FVector MaxBounds(BoundsMaxX->GetValue(), BoundsMaxY->GetValue(), BoundsMaxZ->GetValue());
+	if (MinBounds.X >= MaxBounds.X || MinBounds.Y >= MaxBounds.Y)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok,
+			LOCTEXT("InvalidBoundsMsg", "Capture region is invalid. Min bounds must be less than Max bounds on X and Y axes.\n\nTip: Use 'Get Bounds from Selected Actor' to auto-fill."));
+		return false;
+	}
+
+	if (const UMinimapCaptureQueueSubsystem* Queue = GEditor->GetEditorSubsystem<UMinimapCaptureQueueSubsystem>(); Queue && Queue->IsRunning())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok,
+			LOCTEXT("CaptureQueueRunningMsg", "A batch of minimap captures is running. Wait for it to finish or cancel it before starting another capture."));
+		return false;
+	}
+
+	FString PathStr = OutputPath->GetText().ToString();
+	if (PathStr.IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("EmptyPathMsg", "Output path cannot be empty."));
+		return false;
+	}
+
+	if (!IFileManager::Get().DirectoryExists(*PathStr))
+	{
+		if (!IFileManager::Get().MakeDirectory(*PathStr, true))
+		{
+			FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("InvalidPathMsg", "Output path does not exist and could not be created."));
+			return false;
+		}
+	}
+
+	StartButton->SetEnabled(false);
+	CancelButton->SetVisibility(EVisibility::Visible);
+
+	CollectSettingsFromUI();
 	UE_LOG(OBPanoramicMinimapGenerator, Log,
 		TEXT("Capture settings: Output=%dx%d, Tiling=%s, TileRes=%d, TileOverlap=%d, ImportAsset=%s, OutputPath=%s, FileName=%s"),
 		Settings.OutputWidth, Settings.OutputHeight,
@@ -1448,9 +2189,7 @@ FReply SMinimapGeneratorWindow::OnStartCaptureClicked()
 	OnCaptureProgress(LOCTEXT("StartingProcess", "Starting..."), 0.f, 0, 0);
 
 	SaveSettings(); // Save user preferences when a capture successfully starts
-
-	Manager->StartCaptureProcess(Settings);
-	return FReply::Handled();
+	return true;
 }
 
 // START SETTINGS PERSISTENCE
@@ -1465,6 +2204,8 @@ void SMinimapGeneratorWindow::SaveSettings() const
 	GConfig->SetFloat(*Section, TEXT("BoundsMaxX"), BoundsMaxX->GetValue(), ConfigPath);
 	GConfig->SetFloat(*Section, TEXT("BoundsMaxY"), BoundsMaxY->GetValue(), ConfigPath);
 	GConfig->SetFloat(*Section, TEXT("BoundsMaxZ"), BoundsMaxZ->GetValue(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("LoadWorldPartitionRegion"), LoadWorldPartitionRegionCheckbox->IsChecked(), ConfigPath);
+	GConfig->SetFloat(*Section, TEXT("HLODWorldUnitsPerPixel"), HLODWorldUnitsPerPixel->GetValue(), ConfigPath);
 
 	GConfig->SetInt(*Section, TEXT("OutputWidth"), *CurrentOutputWidth, ConfigPath);
 	GConfig->SetInt(*Section, TEXT("OutputHeight"), *CurrentOutputHeight, ConfigPath);
@@ -1475,6 +2216,10 @@ void SMinimapGeneratorWindow::SaveSettings() const
 	GConfig->SetString(*Section, TEXT("AssetPath"), *AssetPathTextBox->GetText().ToString(), ConfigPath);
 	GConfig->SetBool(*Section, TEXT("ExportDefinitionAsset"), ExportDefinitionAssetCheckbox->IsChecked(), ConfigPath);
 	GConfig->SetString(*Section, TEXT("DefinitionAssetPath"), *DefinitionAssetPathTextBox->GetText().ToString(), ConfigPath);
+	GConfig->SetString(*Section, TEXT("PatchTarget"), *PatchTarget.ToSoftObjectPath().ToString(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("VirtualTextureUDIM"), VirtualTextureCheckbox->IsChecked(), ConfigPath);
+	GConfig->SetInt(*Section, TEXT("UDIMPageSize"), UDIMPageSizeSpinBox->GetValue(), ConfigPath);
+	GConfig->SetInt(*Section, TEXT("UDIMSourceBudgetMB"), UDIMSourceBudgetSpinBox->GetValue(), ConfigPath);
 
 	GConfig->SetInt(*Section, TEXT("BackgroundMode"), static_cast<int32>(CurrentBackgroundMode), ConfigPath);
 	GConfig->SetColor(*Section, TEXT("BackgroundColor"), SelectedBackgroundColor.ToFColor(true), ConfigPath);
@@ -1482,6 +2227,29 @@ void SMinimapGeneratorWindow::SaveSettings() const
 	GConfig->SetBool(*Section, TEXT("UseTiling"), UseTilingCheckbox->IsChecked(), ConfigPath);
 	GConfig->SetInt(*Section, TEXT("TileResolution"), TileResolution->GetValue(), ConfigPath);
 	GConfig->SetInt(*Section, TEXT("TileOverlap"), TileOverlap->GetValue(), ConfigPath);
+	GConfig->SetInt(*Section, TEXT("CaptureShards"), CaptureShards->GetValue(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("PersistentViewState"), PersistentViewStateCheckbox->IsChecked(), ConfigPath);
+	GConfig->SetFloat(*Section, TEXT("ConvergenceThreshold"), ConvergenceThreshold->GetValue(), ConfigPath);
+	GConfig->SetInt(*Section, TEXT("MaxFramesPerTile"), MaxFramesPerTile->GetValue(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("PixelAlignedTiling"), PixelAlignedTilingCheckbox->IsChecked(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("PlanTileLayout"), PlanTileLayoutCheckbox->IsChecked(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("SkipEmptyTiles"), SkipEmptyTilesCheckbox->IsChecked(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("PrestreamTiles"), PrestreamTilesCheckbox->IsChecked(), ConfigPath);
+	for (const TPair<EMinimapCaptureBuffer, TSharedPtr<SCheckBox>>& Pair : AdditionalBufferCheckboxes)
+	{
+		const FString Key = FString::Printf(TEXT("Buffer%s"), MinimapCaptureBuffers::GetFileSuffix(Pair.Key));
+		GConfig->SetBool(*Section, *Key, Pair.Value->IsChecked(), ConfigPath);
+	}
+	GConfig->SetString(*Section, TEXT("Floors"), *FloorsTextBox->GetText().ToString(), ConfigPath);
+	GConfig->SetInt(*Section, TEXT("TileSource"), static_cast<int32>(TileSourceType), ConfigPath);
+	GConfig->SetString(*Section, TEXT("TileSourceDirectory"), *TileSourceDirectory->GetText().ToString(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("RenderMissingTiles"), RenderMissingTilesCheckbox->IsChecked(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("CompressTilesInMemory"), CompressTilesCheckbox->IsChecked(), ConfigPath);
+	GConfig->SetInt(*Section, TEXT("MemoryBudgetMB"), MemoryBudgetSpinBox->GetValue(), ConfigPath);
+	GConfig->SetBool(*Section, TEXT("ShowRenderCostHeatmap"), ShowHeatmapCheckbox->IsChecked(), ConfigPath);
+	GConfig->SetInt(*Section, TEXT("HeatmapMetric"), static_cast<int32>(HeatmapMetric), ConfigPath);
+
+	GConfig->SetInt(*Section, TEXT("CaptureProfile"), static_cast<int32>(CaptureProfile), ConfigPath);
 
 	GConfig->SetFloat(*Section, TEXT("CameraHeight"), CameraHeight->GetValue(), ConfigPath);
 	GConfig->SetFloat(*Section, TEXT("RotationPitch"), RotationPitchSpinBox->GetValue(), ConfigPath);
@@ -1510,6 +2278,8 @@ void SMinimapGeneratorWindow::LoadSettings()
 	if (GConfig->GetFloat(*Section, TEXT("BoundsMaxX"), FloatVal, ConfigPath)) BoundsMaxX->SetValue(FloatVal);
 	if (GConfig->GetFloat(*Section, TEXT("BoundsMaxY"), FloatVal, ConfigPath)) BoundsMaxY->SetValue(FloatVal);
 	if (GConfig->GetFloat(*Section, TEXT("BoundsMaxZ"), FloatVal, ConfigPath)) BoundsMaxZ->SetValue(FloatVal);
+	if (GConfig->GetBool(*Section, TEXT("LoadWorldPartitionRegion"), bBoolVal, ConfigPath)) LoadWorldPartitionRegionCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	if (GConfig->GetFloat(*Section, TEXT("HLODWorldUnitsPerPixel"), FloatVal, ConfigPath)) HLODWorldUnitsPerPixel->SetValue(FloatVal);
 
 	if (GConfig->GetInt(*Section, TEXT("OutputWidth"), IntVal, ConfigPath))
 	{
@@ -1533,6 +2303,10 @@ void SMinimapGeneratorWindow::LoadSettings()
 	if (GConfig->GetString(*Section, TEXT("AssetPath"), StringVal, ConfigPath)) AssetPathTextBox->SetText(FText::FromString(StringVal));
 	if (GConfig->GetBool(*Section, TEXT("ExportDefinitionAsset"), bBoolVal, ConfigPath)) ExportDefinitionAssetCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
 	if (GConfig->GetString(*Section, TEXT("DefinitionAssetPath"), StringVal, ConfigPath)) DefinitionAssetPathTextBox->SetText(FText::FromString(StringVal));
+	if (GConfig->GetString(*Section, TEXT("PatchTarget"), StringVal, ConfigPath)) PatchTarget = TSoftObjectPtr<UMinimapDefinitionDataAsset>(FSoftObjectPath(StringVal));
+	if (GConfig->GetBool(*Section, TEXT("VirtualTextureUDIM"), bBoolVal, ConfigPath)) VirtualTextureCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	if (GConfig->GetInt(*Section, TEXT("UDIMPageSize"), IntVal, ConfigPath)) UDIMPageSizeSpinBox->SetValue(IntVal);
+	if (GConfig->GetInt(*Section, TEXT("UDIMSourceBudgetMB"), IntVal, ConfigPath)) UDIMSourceBudgetSpinBox->SetValue(IntVal);
 
 	if (GConfig->GetInt(*Section, TEXT("BackgroundMode"), IntVal, ConfigPath)) CurrentBackgroundMode = static_cast<EMinimapBackgroundMode>(IntVal);
 	if (GConfig->GetColor(*Section, TEXT("BackgroundColor"), ColorVal, ConfigPath)) SelectedBackgroundColor = FLinearColor(ColorVal);
@@ -1540,6 +2314,29 @@ void SMinimapGeneratorWindow::LoadSettings()
 	if (GConfig->GetBool(*Section, TEXT("UseTiling"), bBoolVal, ConfigPath)) UseTilingCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
 	if (GConfig->GetInt(*Section, TEXT("TileResolution"), IntVal, ConfigPath)) TileResolution->SetValue(IntVal);
 	if (GConfig->GetInt(*Section, TEXT("TileOverlap"), IntVal, ConfigPath)) TileOverlap->SetValue(IntVal);
+	if (GConfig->GetInt(*Section, TEXT("CaptureShards"), IntVal, ConfigPath)) CaptureShards->SetValue(IntVal);
+	if (GConfig->GetBool(*Section, TEXT("PersistentViewState"), bBoolVal, ConfigPath)) PersistentViewStateCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	if (GConfig->GetFloat(*Section, TEXT("ConvergenceThreshold"), FloatVal, ConfigPath)) ConvergenceThreshold->SetValue(FloatVal);
+	if (GConfig->GetInt(*Section, TEXT("MaxFramesPerTile"), IntVal, ConfigPath)) MaxFramesPerTile->SetValue(IntVal);
+	if (GConfig->GetInt(*Section, TEXT("MemoryBudgetMB"), IntVal, ConfigPath)) MemoryBudgetSpinBox->SetValue(IntVal);
+	if (GConfig->GetBool(*Section, TEXT("PixelAlignedTiling"), bBoolVal, ConfigPath)) PixelAlignedTilingCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	if (GConfig->GetBool(*Section, TEXT("PlanTileLayout"), bBoolVal, ConfigPath)) PlanTileLayoutCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	if (GConfig->GetBool(*Section, TEXT("SkipEmptyTiles"), bBoolVal, ConfigPath)) SkipEmptyTilesCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	if (GConfig->GetBool(*Section, TEXT("PrestreamTiles"), bBoolVal, ConfigPath)) PrestreamTilesCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	for (const TPair<EMinimapCaptureBuffer, TSharedPtr<SCheckBox>>& Pair : AdditionalBufferCheckboxes)
+	{
+		const FString Key = FString::Printf(TEXT("Buffer%s"), MinimapCaptureBuffers::GetFileSuffix(Pair.Key));
+		if (GConfig->GetBool(*Section, *Key, bBoolVal, ConfigPath)) Pair.Value->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	}
+	if (GConfig->GetString(*Section, TEXT("Floors"), StringVal, ConfigPath)) FloorsTextBox->SetText(FText::FromString(StringVal));
+	if (GConfig->GetInt(*Section, TEXT("TileSource"), IntVal, ConfigPath) && TileSourceOptions.IsValidIndex(IntVal)) TileSourceType = *TileSourceOptions[IntVal];
+	if (GConfig->GetString(*Section, TEXT("TileSourceDirectory"), StringVal, ConfigPath)) TileSourceDirectory->SetText(FText::FromString(StringVal));
+	if (GConfig->GetBool(*Section, TEXT("RenderMissingTiles"), bBoolVal, ConfigPath)) RenderMissingTilesCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	if (GConfig->GetBool(*Section, TEXT("CompressTilesInMemory"), bBoolVal, ConfigPath)) CompressTilesCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	if (GConfig->GetBool(*Section, TEXT("ShowRenderCostHeatmap"), bBoolVal, ConfigPath)) ShowHeatmapCheckbox->SetIsChecked(bBoolVal ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+	if (GConfig->GetInt(*Section, TEXT("HeatmapMetric"), IntVal, ConfigPath) && HeatmapMetricOptions.IsValidIndex(IntVal)) HeatmapMetric = *HeatmapMetricOptions[IntVal];
+
+	if (GConfig->GetInt(*Section, TEXT("CaptureProfile"), IntVal, ConfigPath) && StaticEnum<EMinimapCaptureProfile>()->IsValidEnumValue(IntVal)) CaptureProfile = static_cast<EMinimapCaptureProfile>(IntVal);
 
 	if (GConfig->GetFloat(*Section, TEXT("CameraHeight"), FloatVal, ConfigPath)) CameraHeight->SetValue(FloatVal);
 	if (GConfig->GetFloat(*Section, TEXT("RotationPitch"), FloatVal, ConfigPath)) RotationPitchSpinBox->SetValue(FloatVal);
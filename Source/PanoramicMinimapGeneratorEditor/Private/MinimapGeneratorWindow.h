@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "MinimapGeneratorManager.h" // Include for UMinimapGeneratorManager and FMinimapCaptureSettings.
+#include "MinimapTileHeatmap.h"
 #include "PropertyCustomizationHelpers.h"
 #include "Slate/DeferredCleanupSlateBrush.h"
 #include "Widgets/Colors/SColorBlock.h"
@@ -33,7 +34,20 @@ private:
 
 	/** Called when the "Start Capture" button is clicked. */
 	FReply OnStartCaptureClicked();
+	/** Recaptures the capture region into the patch target's base map. */
+	FReply OnPatchCaptureClicked();
+	/** Validates the inputs, collects and saves the settings and switches the UI to capturing; false if nothing should start. */
+	bool PrepareCaptureStart();
 	FReply OnCancelCaptureClicked();
+	/** Runs the manager's dry-run estimator on the current settings and shows the report. */
+	FReply OnEstimateCaptureClicked();
+	/** Starts the manager's progressive preview: a coarse capture shown at once, then refined tile by tile. */
+	FReply OnProgressivePreviewClicked();
+	void HandlePreviewUpdated(TConstArrayView<FColor> Canvas, const FIntPoint& CanvasSize, const FIntRect& DirtyRect);
+	/** Moves the preview refinement under the mouse. */
+	FReply OnPreviewMouseMove(const FGeometry& Geometry, const FPointerEvent& MouseEvent);
+	/** Copies every widget value into Settings. */
+	void CollectSettingsFromUI();
 	FReply OnBrowseButtonClicked();
 	FReply OnOpenFolderClicked();
 	FReply OnGetBoundsFromSelectionClicked();
@@ -72,6 +86,8 @@ private:
 	// Region Settings
 	TSharedPtr<SSpinBox<float>> BoundsMinX, BoundsMinY, BoundsMinZ;
 	TSharedPtr<SSpinBox<float>> BoundsMaxX, BoundsMaxY, BoundsMaxZ;
+	TSharedPtr<SCheckBox> LoadWorldPartitionRegionCheckbox;
+	TSharedPtr<SSpinBox<float>> HLODWorldUnitsPerPixel;
 
 	// Output Settings
 	TArray<TSharedPtr<int32>> ResolutionOptions;
@@ -91,6 +107,9 @@ private:
 	TSharedPtr<SEditableTextBox> DefinitionAssetPathTextBox;
 	EVisibility GetAssetPathVisibility() const;
 	EVisibility GetDefinitionAssetPathVisibility() const;
+	TSharedPtr<SCheckBox> VirtualTextureCheckbox;
+	TSharedPtr<SSpinBox<int32>> UDIMPageSizeSpinBox;
+	TSharedPtr<SSpinBox<int32>> UDIMSourceBudgetSpinBox;
 	
 	TSharedPtr<SEditableTextBox> OutputPath;
 	TSharedPtr<SEditableTextBox> FileName;
@@ -100,6 +119,24 @@ private:
 	TSharedPtr<SCheckBox> UseTilingCheckbox; // Tiling toggle checkbox.
 	TSharedPtr<SSpinBox<int32>> TileResolution;
 	TSharedPtr<SSpinBox<int32>> TileOverlap;
+	TSharedPtr<SSpinBox<int32>> CaptureShards;
+	TSharedPtr<SCheckBox> PixelAlignedTilingCheckbox;
+	TSharedPtr<SCheckBox> PlanTileLayoutCheckbox;
+	TSharedPtr<SCheckBox> SkipEmptyTilesCheckbox;
+	TSharedPtr<SCheckBox> PrestreamTilesCheckbox;
+	TMap<EMinimapCaptureBuffer, TSharedPtr<SCheckBox>> AdditionalBufferCheckboxes;
+	TSharedPtr<SEditableTextBox> FloorsTextBox;
+	TSharedPtr<SCheckBox> CompressTilesCheckbox;
+	TSharedPtr<SCheckBox> PersistentViewStateCheckbox;
+	TSharedPtr<SSpinBox<float>> ConvergenceThreshold;
+	TSharedPtr<SSpinBox<int32>> MaxFramesPerTile;
+	TArray<TSharedPtr<EMinimapTileSourceType>> TileSourceOptions;
+	EMinimapTileSourceType TileSourceType = EMinimapTileSourceType::SceneCapture;
+	TSharedPtr<SEditableTextBox> TileSourceDirectory;
+	TSharedPtr<SCheckBox> RenderMissingTilesCheckbox;
+	void OnTileSourceChanged(TSharedPtr<EMinimapTileSourceType> NewSelection, ESelectInfo::Type SelectInfo);
+	EVisibility GetSavedTilesVisibility() const; // Folder and fallback options only apply to the saved-tiles source.
+	FText GetTileLayoutSummaryText() const; // Live report of the layout the next tiled capture will use.
 	EVisibility GetTilingSettingsVisibility() const; // Tiling options visibility helper.
 
 	// Camera Settings
@@ -117,6 +154,12 @@ private:
 	EVisibility GetImageRotationVisibility() const;
 
 	// Quality Settings
+	TArray<TSharedPtr<EMinimapCaptureProfile>> CaptureProfileOptions;
+	EMinimapCaptureProfile CaptureProfile = EMinimapCaptureProfile::Custom;
+	TArray<FMinimapCaptureProfileCost> CaptureProfileCosts; // Last measurement, shown next to each profile.
+	void OnCaptureProfileChanged(TSharedPtr<EMinimapCaptureProfile> NewSelection, ESelectInfo::Type SelectInfo);
+	FText GetCaptureProfileText(EMinimapCaptureProfile Profile) const;
+	FReply OnMeasureCaptureProfilesClicked();
 	TSharedPtr<SCheckBox> CaptureDynamicShadowsCheckbox; 
 	TSharedPtr<SCheckBox> OverrideQualityCheckbox; 
 	// === QUALITY OVERRIDE WIDGETS ===
@@ -151,6 +194,8 @@ private:
 	FReply OnRemoveSelectedFromHiddenList();
 
 	TSharedPtr<SClassPropertyEntryBox> ActorClassFilterBox;
+	/** Minimap whose base map the Patch button updates. */
+	TSoftObjectPtr<UMinimapDefinitionDataAsset> PatchTarget;
 	TSharedPtr<SEditableTextBox> ActorTagFilterTextBox;
 
 	/** Returns currently selected actor class for UI display. */
@@ -183,18 +228,31 @@ private:
 	TSharedPtr<STextBlock> StatusText;
 	TSharedPtr<SButton> StartButton;
 	TSharedPtr<SButton> CancelButton;
+	TSharedPtr<SSpinBox<int32>> MemoryBudgetSpinBox;
 
 	TSharedPtr<SBox> ImageContainer; // Container used for simple show/hide behavior.
 	TSharedPtr<SWidgetSwitcher> PreviewSwitcher;
 	TSharedPtr<SImage> FinalImageView; // Fit to screen
 	TSharedPtr<SImage> ZoomedImageView; // Scrollable zoom
 	TSharedPtr<ISlateBrushSource> FinalImageBrushSource; // Keep brush source alive for lifetime management.
+	TWeakObjectPtr<UTexture2D> ProgressivePreviewTexture; // Updated in place while the progressive preview refines.
+	bool bIsPreviewing = false;
 	
 	// Post-capture UX
 	TSharedPtr<SButton> OpenFolderButton;
 	TSharedPtr<STextBlock> ImageInfoText;
 	FString LastSavedImagePath;
 
+	// Render-cost heatmap over the preview
+	TSharedPtr<SCheckBox> ShowHeatmapCheckbox;
+	TSharedPtr<SMinimapTileHeatmap> FitHeatmap; // Over FinalImageView
+	TSharedPtr<SMinimapTileHeatmap> ZoomedHeatmap; // Over ZoomedImageView
+	TArray<TSharedPtr<EMinimapHeatmapMetric>> HeatmapMetricOptions;
+	EMinimapHeatmapMetric HeatmapMetric = EMinimapHeatmapMetric::Latency;
+	EMinimapHeatmapMetric GetHeatmapMetric() const { return HeatmapMetric; }
+	EVisibility GetHeatmapVisibility() const;
+	void OnHeatmapMetricChanged(TSharedPtr<EMinimapHeatmapMetric> NewSelection, ESelectInfo::Type SelectInfo);
+
 	// Zoom functionality
 	float PreviewZoomFactor = 0.0f;
 	FReply OnZoomInClicked();
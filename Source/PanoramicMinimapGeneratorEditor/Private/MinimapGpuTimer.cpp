@@ -0,0 +1,58 @@
+#include "MinimapGpuTimer.h"
+
+#include "RenderingThread.h"
+#include "RHI.h"
+#include "RHICommandList.h"
+
+void FMinimapGpuTimer::Begin()
+{
+	ElapsedSeconds = -1.0;
+	ENQUEUE_RENDER_COMMAND(MinimapGpuTimerBegin)([Timer = AsShared()](FRHICommandListImmediate& RHICmdList)
+	{
+		if (!GSupportsTimestampRenderQueries)
+		{
+			return;
+		}
+
+		if (!Timer->StartQuery.IsValid())
+		{
+			Timer->StartQuery = RHICreateRenderQuery(RQT_AbsoluteTime);
+			Timer->EndQuery = RHICreateRenderQuery(RQT_AbsoluteTime);
+		}
+		RHICmdList.EndRenderQuery(Timer->StartQuery);
+	});
+}
+
+void FMinimapGpuTimer::End()
+{
+	ENQUEUE_RENDER_COMMAND(MinimapGpuTimerEnd)([Timer = AsShared()](FRHICommandListImmediate& RHICmdList)
+	{
+		if (Timer->EndQuery.IsValid())
+		{
+			RHICmdList.EndRenderQuery(Timer->EndQuery);
+		}
+	});
+}
+
+void FMinimapGpuTimer::Resolve()
+{
+	ENQUEUE_RENDER_COMMAND(MinimapGpuTimerResolve)([Timer = AsShared()](FRHICommandListImmediate& RHICmdList)
+	{
+		if (!Timer->StartQuery.IsValid() || !Timer->EndQuery.IsValid())
+		{
+			return;
+		}
+
+		// The queries have to reach the GPU before their results can be waited on.
+		RHICmdList.ImmediateFlush(EImmediateFlushType::FlushRHIThread);
+
+		// Absolute-time queries report microseconds.
+		uint64 StartMicroseconds = 0;
+		uint64 EndMicroseconds = 0;
+		if (RHIGetRenderQueryResult(Timer->StartQuery, StartMicroseconds, true) &&
+			RHIGetRenderQueryResult(Timer->EndQuery, EndMicroseconds, true) && EndMicroseconds >= StartMicroseconds)
+		{
+			Timer->ElapsedSeconds = (EndMicroseconds - StartMicroseconds) / 1000000.0;
+		}
+	});
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIResources.h"
+
+#include <atomic>
+
+/**
+ * Measures GPU time between two points of the render command stream with timestamp queries.
+ * Begin/End are called on the game thread around code that enqueues rendering work (e.g. CaptureScene);
+ * the queries execute in order with that work on the GPU.
+ */
+class FMinimapGpuTimer : public TSharedFromThis<FMinimapGpuTimer, ESPMode::ThreadSafe>
+{
+public:
+	void Begin();
+	void End();
+
+	/** Queues reading both timestamps. The result is available once rendering commands have been flushed. */
+	void Resolve();
+
+	/** GPU seconds between Begin and End, or a negative value when the RHI cannot time it. */
+	double GetElapsedSeconds() const { return ElapsedSeconds.load(); }
+
+private:
+	/** Render thread only. */
+	FRenderQueryRHIRef StartQuery;
+	FRenderQueryRHIRef EndQuery;
+
+	std::atomic<double> ElapsedSeconds{-1.0};
+};
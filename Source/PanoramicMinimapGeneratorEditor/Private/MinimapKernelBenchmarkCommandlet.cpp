@@ -0,0 +1,147 @@
+#include "MinimapKernelBenchmarkCommandlet.h"
+#include "MinimapImageKernelBenchmark.h"
+#include "PanoramicMinimapGeneratorEditor.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace MinimapKernelBenchmark
+{
+	static FString MakeResultKey(const FString& Kernel, const int32 Size)
+	{
+		return FString::Printf(TEXT("%s@%d"), *Kernel, Size);
+	}
+
+	static bool LoadBaseline(const FString& Path, TMap<FString, double>& OutMegapixelsPerSecond)
+	{
+		FString JsonText;
+		TSharedPtr<FJsonObject> Root;
+		if (!FFileHelper::LoadFileToString(JsonText, *Path) ||
+			!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), Root) || !Root.IsValid())
+		{
+			return false;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* ResultValues = nullptr;
+		if (!Root->TryGetArrayField(TEXT("results"), ResultValues))
+		{
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& Value : *ResultValues)
+		{
+			const TSharedPtr<FJsonObject> Result = Value->AsObject();
+			if (Result.IsValid())
+			{
+				OutMegapixelsPerSecond.Add(MakeResultKey(Result->GetStringField(TEXT("kernel")), static_cast<int32>(Result->GetNumberField(TEXT("size")))),
+				                           Result->GetNumberField(TEXT("megapixelsPerSecond")));
+			}
+		}
+		return true;
+	}
+
+	static bool SaveResults(const FString& Path, const TArray<FMinimapKernelBenchmarkResult>& Results)
+	{
+		TArray<TSharedPtr<FJsonValue>> ResultValues;
+		for (const FMinimapKernelBenchmarkResult& Result : Results)
+		{
+			const TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+			ResultObject->SetStringField(TEXT("kernel"), Result.Kernel);
+			ResultObject->SetNumberField(TEXT("size"), Result.Size);
+			ResultObject->SetNumberField(TEXT("seconds"), Result.Seconds);
+			ResultObject->SetNumberField(TEXT("megapixelsPerSecond"), Result.MegapixelsPerSecond);
+			ResultValues.Add(MakeShared<FJsonValueObject>(ResultObject));
+		}
+
+		const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("numWorkerThreads"), FTaskGraphInterface::Get().GetNumWorkerThreads());
+		Root->SetArrayField(TEXT("results"), ResultValues);
+
+		FString JsonText;
+		return FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&JsonText)) && FFileHelper::SaveStringToFile(JsonText, *Path);
+	}
+}
+
+UMinimapKernelBenchmarkCommandlet::UMinimapKernelBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMinimapKernelBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace MinimapKernelBenchmark;
+
+	TArray<int32> Sizes = {2048, 8192, 16384};
+	FString SizesParam;
+	if (FParse::Value(*Params, TEXT("sizes="), SizesParam))
+	{
+		TArray<FString> SizeStrings;
+		SizesParam.ParseIntoArray(SizeStrings, TEXT(","));
+		Sizes.Reset();
+		for (const FString& SizeString : SizeStrings)
+		{
+			Sizes.Add(FCString::Atoi(*SizeString));
+		}
+	}
+
+	TArray<FString> Kernels;
+	FString KernelsParam;
+	if (FParse::Value(*Params, TEXT("kernels="), KernelsParam))
+	{
+		KernelsParam.ParseIntoArray(Kernels, TEXT(","));
+	}
+
+	int32 Iterations = 3;
+	FParse::Value(*Params, TEXT("iterations="), Iterations);
+	float Tolerance = 0.15f;
+	FParse::Value(*Params, TEXT("tolerance="), Tolerance);
+
+	UE_LOG(OBPanoramicMinimapGenerator, Display, TEXT("Benchmarking image kernels on %d worker threads..."),
+		FTaskGraphInterface::Get().GetNumWorkerThreads());
+	const TArray<FMinimapKernelBenchmarkResult> Results = MinimapImageKernels::RunBenchmarks(Sizes, Kernels, Iterations);
+	for (const FMinimapKernelBenchmarkResult& Result : Results)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Display, TEXT("%-18s %6d  %10.1f MPix/s  (%.3f s)"),
+			*Result.Kernel, Result.Size, Result.MegapixelsPerSecond, Result.Seconds);
+	}
+
+	FString JsonPath;
+	if (FParse::Value(*Params, TEXT("json="), JsonPath) && !SaveResults(JsonPath, Results))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to write benchmark results to %s"), *JsonPath);
+		return 1;
+	}
+
+	FString BaselinePath;
+	if (!FParse::Value(*Params, TEXT("baseline="), BaselinePath))
+	{
+		return 0;
+	}
+
+	TMap<FString, double> Baseline;
+	if (!LoadBaseline(BaselinePath, Baseline))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Failed to read benchmark baseline %s"), *BaselinePath);
+		return 1;
+	}
+
+	int32 NumRegressions = 0;
+	for (const FMinimapKernelBenchmarkResult& Result : Results)
+	{
+		const double* BaselineMegapixelsPerSecond = Baseline.Find(MakeResultKey(Result.Kernel, Result.Size));
+		if (BaselineMegapixelsPerSecond && Result.MegapixelsPerSecond < *BaselineMegapixelsPerSecond * (1.0 - Tolerance))
+		{
+			UE_LOG(OBPanoramicMinimapGenerator, Error, TEXT("Regression: %s at %d is %.1f MPix/s, baseline %.1f MPix/s."),
+				*Result.Kernel, Result.Size, Result.MegapixelsPerSecond, *BaselineMegapixelsPerSecond);
+			NumRegressions++;
+		}
+	}
+	return NumRegressions > 0 ? 1 : 0;
+}
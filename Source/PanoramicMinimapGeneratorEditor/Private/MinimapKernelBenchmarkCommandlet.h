@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MinimapKernelBenchmarkCommandlet.generated.h"
+
+/**
+ * Runs the stitching/encode kernel microbenchmarks without a world or a GPU:
+ *
+ *   UnrealEditor-Cmd <Project> -run=MinimapKernelBenchmark -nullrhi -unattended
+ *       [-sizes=2048,8192,16384] [-kernels=Composite,EncodePng] [-iterations=3]
+ *       [-json=<results.json>] [-baseline=<previous results.json>] [-tolerance=0.15]
+ *
+ * With -baseline, returns a non-zero exit code when any kernel is slower than its baseline by more than the tolerance.
+ */
+UCLASS()
+class UMinimapKernelBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMinimapKernelBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,113 @@
+#include "MinimapMemoryTracking.h"
+
+#include <atomic>
+
+namespace MinimapMemory
+{
+	constexpr int32 NumTags = static_cast<int32>(EMinimapMemoryTag::Num);
+
+	static std::atomic<int64> LiveBytes[NumTags];
+	static std::atomic<int64> HighWaterBytes[NumTags];
+	static std::atomic<int64> TotalLiveBytes{0};
+	static std::atomic<int64> TotalHighWaterBytes{0};
+
+	static void RaiseHighWater(std::atomic<int64>& HighWater, const int64 Value)
+	{
+		int64 Current = HighWater.load();
+		while (Value > Current && !HighWater.compare_exchange_weak(Current, Value))
+		{
+		}
+	}
+
+	const TCHAR* GetTagName(const EMinimapMemoryTag Tag)
+	{
+		switch (Tag)
+		{
+		case EMinimapMemoryTag::CapturedTileData: return TEXT("CapturedTileData");
+		case EMinimapMemoryTag::StagingPixelBuffer: return TEXT("StagingPixelBuffer");
+		case EMinimapMemoryTag::StitchCanvas: return TEXT("StitchCanvas");
+		case EMinimapMemoryTag::ImageWrapperBuffers: return TEXT("ImageWrapperBuffers");
+		case EMinimapMemoryTag::UncompressedBGRA: return TEXT("UncompressedBGRA");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	void Add(const EMinimapMemoryTag Tag, const int64 Bytes)
+	{
+		const int32 Index = static_cast<int32>(Tag);
+		if (Bytes == 0 || Index >= NumTags)
+		{
+			return;
+		}
+
+		RaiseHighWater(HighWaterBytes[Index], LiveBytes[Index].fetch_add(Bytes) + Bytes);
+		RaiseHighWater(TotalHighWaterBytes, TotalLiveBytes.fetch_add(Bytes) + Bytes);
+	}
+
+	void Remove(const EMinimapMemoryTag Tag, const int64 Bytes)
+	{
+		const int32 Index = static_cast<int32>(Tag);
+		if (Bytes == 0 || Index >= NumTags)
+		{
+			return;
+		}
+
+		LiveBytes[Index].fetch_sub(Bytes);
+		TotalLiveBytes.fetch_sub(Bytes);
+	}
+
+	void ResetHighWater()
+	{
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			HighWaterBytes[Index] = LiveBytes[Index].load();
+		}
+		TotalHighWaterBytes = TotalLiveBytes.load();
+	}
+
+	int64 GetLiveBytes()
+	{
+		return TotalLiveBytes.load();
+	}
+
+	int64 GetHighWaterBytes()
+	{
+		return TotalHighWaterBytes.load();
+	}
+
+	int64 GetHighWaterBytes(const EMinimapMemoryTag Tag)
+	{
+		const int32 Index = static_cast<int32>(Tag);
+		return Index < NumTags ? HighWaterBytes[Index].load() : 0;
+	}
+}
+
+FMinimapTrackedBytes::FMinimapTrackedBytes(const EMinimapMemoryTag InTag, const int64 InBytes)
+	: Tag(InTag), Bytes(InBytes)
+{
+	MinimapMemory::Add(Tag, Bytes);
+}
+
+FMinimapTrackedBytes::FMinimapTrackedBytes(FMinimapTrackedBytes&& Other)
+	: Tag(Other.Tag), Bytes(Other.Bytes)
+{
+	Other.Bytes = 0;
+}
+
+FMinimapTrackedBytes& FMinimapTrackedBytes::operator=(FMinimapTrackedBytes&& Other)
+{
+	if (this != &Other)
+	{
+		Reset();
+		Tag = Other.Tag;
+		Bytes = Other.Bytes;
+		Other.Bytes = 0;
+	}
+	return *this;
+}
+
+void FMinimapTrackedBytes::Reset()
+{
+	MinimapMemory::Remove(Tag, Bytes);
+	Bytes = 0;
+}
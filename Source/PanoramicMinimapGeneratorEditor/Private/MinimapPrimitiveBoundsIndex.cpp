@@ -0,0 +1,116 @@
+#include "MinimapPrimitiveBoundsIndex.h"
+
+#include "Components/BrushComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+
+void FMinimapPrimitiveBoundsIndex::Build(const TArray<AActor*>& VisibleActors, const FMinimapTileLayout& InLayout,
+                                         const FVector2D& WorldOrigin, const double WorldUnitsPerPixel)
+{
+	Reset();
+	Layout = InLayout;
+	if (!Layout.IsValid() || WorldUnitsPerPixel <= 0.0)
+	{
+		return;
+	}
+
+	TilePrimitives.SetNum(Layout.GetNumTiles());
+	// Everything the tiles render, including the part of the last column/row past the canvas in uniform layouts.
+	const FIntRect Footprint(FIntPoint::ZeroValue,
+		Layout.GetTileRect(Layout.NumTiles.X - 1, Layout.NumTiles.Y - 1).Max.ComponentMax(Layout.OutputSize));
+
+	TArray<UPrimitiveComponent*> Primitives;
+	for (AActor* Actor : VisibleActors)
+	{
+		if (!Actor || Actor->IsHidden())
+		{
+			continue;
+		}
+
+		Primitives.Reset();
+		Actor->GetComponents(Primitives);
+		for (UPrimitiveComponent* Primitive : Primitives)
+		{
+			// Volume brushes and primitives hidden in game only draw in the editor viewport, never in the capture.
+			if (!Primitive || !Primitive->IsRegistered() || !Primitive->ShouldRender() || Primitive->bHiddenInGame || Primitive->IsEditorOnly()
+				|| Primitive->IsA<UBrushComponent>())
+			{
+				continue;
+			}
+
+			// Round outwards by a pixel so primitives that only graze a tile edge still keep that tile.
+			// Unbounded primitives are clamped first so the conversion cannot overflow.
+			const FBox WorldBox = Primitive->Bounds.GetBox();
+			auto ToCanvas = [WorldUnitsPerPixel](const double WorldOffset)
+			{
+				return FMath::Clamp(WorldOffset / WorldUnitsPerPixel, -1.0e9, 1.0e9);
+			};
+			const FIntRect CanvasRect(
+				FMath::FloorToInt32(ToCanvas(WorldBox.Min.X - WorldOrigin.X)) - 1,
+				FMath::FloorToInt32(ToCanvas(WorldBox.Min.Y - WorldOrigin.Y)) - 1,
+				FMath::CeilToInt32(ToCanvas(WorldBox.Max.X - WorldOrigin.X)) + 1,
+				FMath::CeilToInt32(ToCanvas(WorldBox.Max.Y - WorldOrigin.Y)) + 1);
+
+			// Sky spheres, ocean planes and the like would keep every tile; they are left out so the tiles with
+			// nothing else in them can still be skipped.
+			if (CanvasRect.Min.X <= Footprint.Min.X && CanvasRect.Min.Y <= Footprint.Min.Y
+				&& CanvasRect.Max.X >= Footprint.Max.X && CanvasRect.Max.Y >= Footprint.Max.Y)
+			{
+				EnclosingPrimitiveNames.Add(FString::Printf(TEXT("%s.%s"), *Actor->GetActorNameOrLabel(), *Primitive->GetName()));
+				continue;
+			}
+			AddPrimitive(Primitive, CanvasRect);
+		}
+	}
+}
+
+void FMinimapPrimitiveBoundsIndex::AddPrimitive(UPrimitiveComponent* Primitive, const FIntRect& CanvasRect)
+{
+	// Single-tile axes can have an overlap larger than the tile; clamp so the step stays positive.
+	const FIntPoint Step(FMath::Max(1, Layout.TileSize.X - Layout.Overlap), FMath::Max(1, Layout.TileSize.Y - Layout.Overlap));
+
+	// Candidate tile range from the grid step; neighbours are included because tiles overlap.
+	const int32 FirstX = FMath::Clamp(FMath::FloorToInt32(static_cast<float>(CanvasRect.Min.X - Layout.TileSize.X) / Step.X), 0, Layout.NumTiles.X - 1);
+	const int32 FirstY = FMath::Clamp(FMath::FloorToInt32(static_cast<float>(CanvasRect.Min.Y - Layout.TileSize.Y) / Step.Y), 0, Layout.NumTiles.Y - 1);
+	const int32 LastX = FMath::Clamp(FMath::FloorToInt32(static_cast<float>(CanvasRect.Max.X) / Step.X), 0, Layout.NumTiles.X - 1);
+	const int32 LastY = FMath::Clamp(FMath::FloorToInt32(static_cast<float>(CanvasRect.Max.Y) / Step.Y), 0, Layout.NumTiles.Y - 1);
+
+	for (int32 TileY = FirstY; TileY <= LastY; ++TileY)
+	{
+		for (int32 TileX = FirstX; TileX <= LastX; ++TileX)
+		{
+			if (Layout.GetTileRect(TileX, TileY).Intersect(CanvasRect))
+			{
+				TilePrimitives[TileY * Layout.NumTiles.X + TileX].Add(Primitive);
+			}
+		}
+	}
+}
+
+void FMinimapPrimitiveBoundsIndex::Reset()
+{
+	TilePrimitives.Empty();
+	EnclosingPrimitiveNames.Empty();
+	Layout = FMinimapTileLayout();
+}
+
+bool FMinimapPrimitiveBoundsIndex::IsTileEmpty(const int32 TileIndex) const
+{
+	return TilePrimitives.IsValidIndex(TileIndex) && TilePrimitives[TileIndex].Num() == 0;
+}
+
+int32 FMinimapPrimitiveBoundsIndex::GetNumEmptyTiles() const
+{
+	int32 NumEmpty = 0;
+	for (const TArray<TWeakObjectPtr<UPrimitiveComponent>>& Bucket : TilePrimitives)
+	{
+		NumEmpty += Bucket.Num() == 0 ? 1 : 0;
+	}
+	return NumEmpty;
+}
+
+const TArray<TWeakObjectPtr<UPrimitiveComponent>>& FMinimapPrimitiveBoundsIndex::GetTilePrimitives(const int32 TileIndex) const
+{
+	static const TArray<TWeakObjectPtr<UPrimitiveComponent>> EmptyBucket;
+	return TilePrimitives.IsValidIndex(TileIndex) ? TilePrimitives[TileIndex] : EmptyBucket;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinimapTileLayout.h"
+
+class AActor;
+class UPrimitiveComponent;
+
+/**
+ * Buckets the world-space bounds of every visible primitive into the tiles of a capture layout.
+ * A tile whose bucket is empty has nothing to render and can be filled with the background color directly.
+ * Primitives that cannot render in the capture, and primitives covering the whole capture area, are not indexed.
+ */
+class FMinimapPrimitiveBoundsIndex
+{
+public:
+	/**
+	 * Indexes the primitives of the given actors. Canvas pixel = (World - WorldOrigin) / WorldUnitsPerPixel,
+	 * which is the same mapping the tiled capture uses to place its camera.
+	 */
+	void Build(const TArray<AActor*>& VisibleActors, const FMinimapTileLayout& InLayout, const FVector2D& WorldOrigin,
+	           double WorldUnitsPerPixel);
+
+	void Reset();
+
+	bool IsBuilt() const { return TilePrimitives.Num() > 0; }
+	bool IsTileEmpty(int32 TileIndex) const;
+	int32 GetNumEmptyTiles() const;
+
+	/** Primitives whose bounds touch the tile footprint. */
+	const TArray<TWeakObjectPtr<UPrimitiveComponent>>& GetTilePrimitives(int32 TileIndex) const;
+
+	/** "Actor.Component" of each primitive left out because its bounds enclose every tile. */
+	const TArray<FString>& GetEnclosingPrimitiveNames() const { return EnclosingPrimitiveNames; }
+
+private:
+	void AddPrimitive(UPrimitiveComponent* Primitive, const FIntRect& CanvasRect);
+
+	FMinimapTileLayout Layout;
+	TArray<TArray<TWeakObjectPtr<UPrimitiveComponent>>> TilePrimitives;
+	TArray<FString> EnclosingPrimitiveNames;
+};
@@ -0,0 +1,71 @@
+#include "MinimapStreamingSource.h"
+#include "PanoramicMinimapGeneratorEditor.h"
+
+#include "Engine/World.h"
+#include "WorldPartition/IWorldPartitionEditorModule.h"
+#include "WorldPartition/LoaderAdapter/LoaderAdapterShape.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionEditorLoaderAdapter.h"
+
+bool FMinimapStreamingSourceProvider::LoadRegion(UWorld& World, const FBox& Bounds, const bool bInHLODOnly)
+{
+	ReleaseRegion();
+
+	UWorldPartition* WorldPartition = World.GetWorldPartition();
+	if (!WorldPartition)
+	{
+		return false;
+	}
+
+	bHLODOnly = bInHLODOnly;
+	SetSourceLocation(Bounds.GetCenter(), static_cast<float>(Bounds.GetExtent().Size2D()));
+	RegionWorld = &World;
+
+	if (bHLODOnly)
+	{
+		IWorldPartitionEditorModule& WorldPartitionEditor = IWorldPartitionEditorModule::Get();
+		if (!WorldPartitionEditor.GetShowHLODsInEditor())
+		{
+			PreviousShowHLODsInEditor = false;
+			WorldPartitionEditor.SetShowHLODsInEditor(true);
+		}
+		return true;
+	}
+
+	// Cells are loaded down to the ground whatever the capture height; the bounds only limit them in X and Y.
+	FBox LoadBounds = Bounds;
+	LoadBounds.Min.Z = -HALF_WORLD_MAX;
+	LoadBounds.Max.Z = HALF_WORLD_MAX;
+	UWorldPartitionEditorLoaderAdapter* Loader =
+		WorldPartition->CreateEditorLoaderAdapter<FLoaderAdapterShape>(&World, LoadBounds, TEXT("Minimap Capture Region"));
+	if (!Loader || !Loader->GetLoaderAdapter())
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Could not create a World Partition loader for the capture region."));
+		return false;
+	}
+
+	Loader->GetLoaderAdapter()->Load();
+	RegionLoader = Loader;
+	return true;
+}
+
+void FMinimapStreamingSourceProvider::ReleaseRegion()
+{
+	if (UWorldPartitionEditorLoaderAdapter* Loader = RegionLoader.Get())
+	{
+		Loader->GetLoaderAdapter()->Unload();
+		if (UWorld* World = RegionWorld.Get(); World && World->GetWorldPartition())
+		{
+			World->GetWorldPartition()->ReleaseEditorLoaderAdapter(Loader);
+		}
+	}
+	RegionLoader.Reset();
+	RegionWorld.Reset();
+
+	if (PreviousShowHLODsInEditor.IsSet())
+	{
+		IWorldPartitionEditorModule::Get().SetShowHLODsInEditor(PreviousShowHLODsInEditor.GetValue());
+		PreviousShowHLODsInEditor.Reset();
+	}
+	bHLODOnly = false;
+}
@@ -5,9 +5,14 @@
 #include "CoreMinimal.h"
 #include "WorldPartition/WorldPartitionStreamingSource.h"
 
+class UWorld;
+class UWorldPartitionEditorLoaderAdapter;
+
 /**
  * A custom, temporary streaming source provider used by the minimap generator.
  * This allows us to force World Partition to load cells around a specific location.
+ * In the editor world, LoadRegion loads the cells of the capture area itself, or only shows their HLODs when the
+ * output is too coarse for full-detail actors to make a difference.
  */
 class FMinimapStreamingSourceProvider : public IWorldPartitionStreamingSourceProvider
 {
@@ -23,6 +28,11 @@ public:
     //~ Begin IWorldPartitionStreamingSourceProvider interface
     virtual bool GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const override
     {
+        // With no source of ours, only the HLODs World Partition keeps for unloaded cells cover the area.
+        if (bHLODOnly)
+        {
+            return false;
+        }
         OutStreamingSources.Add(StreamingSource);
         return true;
     }
@@ -45,6 +55,21 @@ public:
     
     FVector GetSourceLocation() const { return StreamingSource.Location; }
 
+    /**
+     * Loads every World Partition cell overlapping Bounds in the editor world, synchronously. With bInHLODOnly, loads
+     * nothing and turns on the editor's HLOD display instead, so unloaded cells are drawn with their HLODs.
+     * Returns false when the world is not partitioned or the region could not be loaded.
+     */
+    bool LoadRegion(UWorld& World, const FBox& Bounds, bool bInHLODOnly);
+    /** Unloads what LoadRegion loaded and restores the editor's HLOD display. */
+    void ReleaseRegion();
+    bool IsHLODOnly() const { return bHLODOnly; }
+
 private:
     FWorldPartitionStreamingSource StreamingSource;
+    TWeakObjectPtr<UWorldPartitionEditorLoaderAdapter> RegionLoader;
+    TWeakObjectPtr<UWorld> RegionWorld;
+    bool bHLODOnly = false;
+    /** The editor's Show HLODs setting before LoadRegion changed it; unset when it was left alone. */
+    TOptional<bool> PreviousShowHLODsInEditor;
 };
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "MinimapTextureSourceUpdate.h"
+
+#include "MinimapGeneratorStats.h"
+#include "MinimapImageKernels.h"
+
+#include "EditorFramework/AssetImportData.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "IImageWrapperModule.h"
+#include "Misc/FileHelper.h"
+
+void MinimapTextureSource::FindChangedRects(const UTexture2D& Texture, TConstArrayView<FColor> Pixels, const FIntPoint& Size,
+                                            const FIntRect& CapturedRect, TArray<FIntRect>& OutChangedRects)
+{
+	// The source is only read; FTextureSource has no const read-only lock.
+	FTextureSource& Source = const_cast<UTexture2D&>(Texture).Source;
+	OutChangedRects.Reset();
+	const bool bSameLayout = Source.IsValid() && Source.GetFormat() == TSF_BGRA8 && Source.GetSizeX() == Size.X && Source.GetSizeY() == Size.Y &&
+		Source.GetNumMips() == 1 && Source.GetNumLayers() == 1 && Source.GetNumBlocks() == 1;
+	if (!bSameLayout)
+	{
+		OutChangedRects.Emplace(FIntPoint::ZeroValue, Size);
+		return;
+	}
+
+	const FIntRect Captured(FIntPoint::ComponentMax(CapturedRect.Min, FIntPoint::ZeroValue), FIntPoint::ComponentMin(CapturedRect.Max, Size));
+	if (Source.GetSourceCompression() != TSCF_None)
+	{
+		if (Captured.Area() > 0)
+		{
+			OutChangedRects.Add(Captured);
+		}
+		return;
+	}
+
+	// A read-only lock leaves the source's id alone, so an identical image costs no texture rebuild or DDC write.
+	if (const uint8* CurrentData = Source.LockMipReadOnly(0, 0, 0))
+	{
+		const TConstArrayView<FColor> CurrentPixels(reinterpret_cast<const FColor*>(CurrentData), Size.X * Size.Y);
+		MinimapImageKernels::FindChangedBlocks(CurrentPixels, Pixels, Size, Captured, ChangedBlockSize, OutChangedRects);
+		Source.UnlockMip(0, 0, 0);
+	}
+	else
+	{
+		OutChangedRects.Emplace(FIntPoint::ZeroValue, Size);
+	}
+}
+
+void MinimapTextureSource::SetSource(UTexture2D& Texture, TConstArrayView<FColor> Pixels, const FIntPoint& Size, TArrayView64<uint8> CompressedImage,
+                                     const ETextureSourceCompressionFormat CompressionFormat)
+{
+	// The encoded file is an order of magnitude smaller than raw BGRA in the package, and decodes to the same pixels.
+	if (CompressionFormat != TSCF_None && CompressedImage.Num() > 0)
+	{
+		Texture.Source.InitWithCompressedSourceData(Size.X, Size.Y, 1, TSF_BGRA8, CompressedImage, CompressionFormat);
+	}
+	else
+	{
+		Texture.Source.Init(Size.X, Size.Y, 1, 1, TSF_BGRA8, reinterpret_cast<const uint8*>(Pixels.GetData()));
+	}
+}
+
+EMinimapTextureSourceUpdate MinimapTextureSource::Update(UTexture2D& Texture, TConstArrayView<FColor> Pixels, const FIntPoint& Size,
+                                                         const FIntRect& CapturedRect, TArray<FIntRect>& OutChangedRects,
+                                                         TArrayView64<uint8> CompressedImage, const ETextureSourceCompressionFormat CompressionFormat)
+{
+	FindChangedRects(Texture, Pixels, Size, CapturedRect, OutChangedRects);
+	if (OutChangedRects.IsEmpty())
+	{
+		return EMinimapTextureSourceUpdate::Unchanged;
+	}
+	SetSource(Texture, Pixels, Size, CompressedImage, CompressionFormat);
+	return EMinimapTextureSourceUpdate::Full;
+}
+
+FIntPoint MinimapTextureSource::GetPageCount(const FIntPoint& Size, const int32 PageSize)
+{
+	return PageSize > 0 ? FIntPoint(FMath::DivideAndRoundUp(Size.X, PageSize), FMath::DivideAndRoundUp(Size.Y, PageSize)) : FIntPoint::ZeroValue;
+}
+
+int32 MinimapTextureSource::GetUDIMIndex(const FIntPoint& PageCoord)
+{
+	return 1001 + PageCoord.X + PageCoord.Y * MaxUDIMColumns;
+}
+
+void MinimapTextureSource::InitPages(UTexture2D& Texture, const FIntPoint& PageCount, const int32 PageSize)
+{
+	TArray<FTextureSourceBlock> Blocks;
+	Blocks.Reserve(PageCount.X * PageCount.Y);
+	for (int32 PageY = 0; PageY < PageCount.Y; ++PageY)
+	{
+		for (int32 PageX = 0; PageX < PageCount.X; ++PageX)
+		{
+			FTextureSourceBlock& Block = Blocks.AddDefaulted_GetRef();
+			Block.BlockX = PageX;
+			Block.BlockY = PageY;
+			Block.SizeX = PageSize;
+			Block.SizeY = PageSize;
+			Block.NumSlices = 1;
+			Block.NumMips = 1;
+		}
+	}
+
+	// No initial data: the pages arrive one at a time, so the whole map is never held twice.
+	const ETextureSourceFormat Format = TSF_BGRA8;
+	SetImportedFile(Texture, FString(), FMD5Hash());
+	Texture.Source.InitBlocked(&Format, Blocks.GetData(), 1, Blocks.Num(), nullptr);
+	Texture.VirtualTextureStreaming = true;
+}
+
+bool MinimapTextureSource::WritePage(UTexture2D& Texture, const FIntPoint& PageCoord, TConstArrayView<FColor> Pixels, const FIntPoint& Size)
+{
+	FTextureSource& Source = Texture.Source;
+	FTextureSourceBlock Block;
+	int32 BlockIndex = 0;
+	for (; BlockIndex < Source.GetNumBlocks(); ++BlockIndex)
+	{
+		Source.GetBlock(BlockIndex, Block);
+		if (Block.BlockX == PageCoord.X && Block.BlockY == PageCoord.Y)
+		{
+			break;
+		}
+	}
+	if (BlockIndex == Source.GetNumBlocks())
+	{
+		return false;
+	}
+
+	uint8* BlockData = Source.LockMip(BlockIndex, 0, 0);
+	if (!BlockData)
+	{
+		return false;
+	}
+
+	const int64 BlockBytes = static_cast<int64>(Block.SizeX) * Block.SizeY * sizeof(FColor);
+	const bool bFullPage = Size == FIntPoint(Block.SizeX, Block.SizeY) && Pixels.Num() == Block.SizeX * Block.SizeY;
+	if (bFullPage)
+	{
+		FMemory::Memcpy(BlockData, Pixels.GetData(), BlockBytes);
+	}
+	else
+	{
+		FMemory::Memzero(BlockData, BlockBytes);
+	}
+	Source.UnlockMip(BlockIndex, 0, 0);
+	return bFullPage;
+}
+
+bool MinimapTextureSource::IsImportedFile(const UTexture2D& Texture, const FMD5Hash& FileHash, const FIntPoint& Size)
+{
+	const FTextureSource& Source = Texture.Source;
+	if (!FileHash.IsValid() || !Texture.AssetImportData || !Source.IsValid() || Source.GetNumBlocks() != 1 || Source.GetSizeX() != Size.X ||
+		Source.GetSizeY() != Size.Y)
+	{
+		return false;
+	}
+	const TArray<FAssetImportInfo::FSourceFile>& SourceFiles = Texture.AssetImportData->SourceData.SourceFiles;
+	return SourceFiles.Num() == 1 && SourceFiles[0].FileHash == FileHash;
+}
+
+void MinimapTextureSource::SetImportedFile(UTexture2D& Texture, const FString& Path, const FMD5Hash& FileHash)
+{
+	if (!Texture.AssetImportData)
+	{
+		return;
+	}
+	// Also what the content browser's Reimport reads the file from.
+	Texture.AssetImportData->SourceData = FAssetImportInfo();
+	if (!Path.IsEmpty())
+	{
+		Texture.AssetImportData->SourceData.Insert(FAssetImportInfo::FSourceFile(Texture.AssetImportData->SanitizeImportFilename(Path),
+			IFileManager::Get().GetTimeStamp(*Path), FileHash));
+	}
+}
+
+bool MinimapTextureSource::DecodeImageFile(const FString& Path, FMinimapDecodedImage& OutImage, FString& OutError)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	OutImage = FMinimapDecodedImage();
+	OutImage.Path = Path;
+	if (!FFileHelper::LoadFileToArray(OutImage.FileData, *Path))
+	{
+		OutError = FString::Printf(TEXT("Failed to load saved image file from disk: %s"), *Path);
+		return false;
+	}
+	FMD5 FileMD5;
+	FileMD5.Update(OutImage.FileData.GetData(), OutImage.FileData.Num());
+	OutImage.FileHash.Set(FileMD5);
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	TSharedPtr<IImageWrapper> ImageWrapper;
+	FMinimapTrackedBytes ImageWrapperBytes;
+	{
+		LLM_SCOPE_BYTAG(MinimapGenerator_ImageWrapperBuffers);
+		// Captures are always PNG; the capture commandlet can also re-encode to JPEG or BMP.
+		OutImage.Format = ImageWrapperModule.DetectImageFormat(OutImage.FileData.GetData(), OutImage.FileData.Num());
+		ImageWrapper = ImageWrapperModule.CreateImageWrapper(OutImage.Format);
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(OutImage.FileData.GetData(), OutImage.FileData.Num()))
+		{
+			OutError = FString::Printf(TEXT("Failed to decode image data from file: %s"), *Path);
+			return false;
+		}
+		// The file contents plus the wrapper's copy of them.
+		ImageWrapperBytes = FMinimapTrackedBytes(EMinimapMemoryTag::ImageWrapperBuffers, OutImage.FileData.Num() * 2);
+	}
+
+	LLM_SCOPE_BYTAG(MinimapGenerator_UncompressedBGRA);
+	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, OutImage.Pixels))
+	{
+		OutError = FString::Printf(TEXT("Failed to read raw image data from file: %s"), *Path);
+		return false;
+	}
+	OutImage.PixelBytes = FMinimapTrackedBytes(EMinimapMemoryTag::UncompressedBGRA, OutImage.Pixels.Num());
+	OutImage.Size = FIntPoint(ImageWrapper->GetWidth(), ImageWrapper->GetHeight());
+	OutImage.BitDepth = ImageWrapper->GetBitDepth();
+	OutImage.DecodeSeconds = FPlatformTime::Seconds() - StartTime;
+	return true;
+}
+
+ETextureSourceCompressionFormat MinimapTextureSource::GetCompressionFormat(const EImageFormat ImageFormat)
+{
+	switch (ImageFormat)
+	{
+	case EImageFormat::PNG:
+		return TSCF_PNG;
+	case EImageFormat::JPEG:
+		return TSCF_JPEG;
+	default:
+		return TSCF_None;
+	}
+}
+
+double MinimapTextureSource::GetChangedFraction(const TArray<FIntRect>& ChangedRects, const FIntPoint& Size)
+{
+	int64 ChangedPixels = 0;
+	for (const FIntRect& Rect : ChangedRects)
+	{
+		ChangedPixels += static_cast<int64>(Rect.Width()) * Rect.Height();
+	}
+	return Size.X > 0 && Size.Y > 0 ? static_cast<double>(ChangedPixels) / (static_cast<int64>(Size.X) * Size.Y) : 0.0;
+}
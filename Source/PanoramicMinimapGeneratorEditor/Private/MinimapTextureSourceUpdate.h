@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture.h"
+#include "IImageWrapper.h"
+#include "MinimapMemoryTracking.h"
+#include "Misc/SecureHash.h"
+
+class UTexture2D;
+
+/** An image file decoded to BGRA8, keeping the file's bytes for the texture source. */
+struct FMinimapDecodedImage
+{
+	FString Path;
+	TArray64<uint8> FileData;
+	/** MD5 of FileData, recorded on the texture so an identical file is recognized without decoding its source. */
+	FMD5Hash FileHash;
+	TArray64<uint8> Pixels;
+	FMinimapTrackedBytes PixelBytes;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	EImageFormat Format = EImageFormat::Invalid;
+	int32 BitDepth = 0;
+	double DecodeSeconds = 0.0;
+
+	bool IsValid() const { return Size.X > 0 && Size.Y > 0; }
+	TConstArrayView<FColor> GetPixels() const
+	{
+		return TConstArrayView<FColor>(reinterpret_cast<const FColor*>(Pixels.GetData()), Pixels.Num() / sizeof(FColor));
+	}
+};
+
+/** What MinimapTextureSource::Update did to a texture's source. */
+enum class EMinimapTextureSourceUpdate : uint8
+{
+	/** The source already held these pixels; the texture does not need rebuilding. */
+	Unchanged,
+	/** The source was (re)initialized from the whole image, compressed when an encoded copy was given. */
+	Full,
+};
+
+namespace MinimapTextureSource
+{
+	/** Granularity of the comparison with the existing source, in pixels. */
+	constexpr int32 ChangedBlockSize = 256;
+
+	/**
+	 * Regions of CapturedRect, the part of the image the capture wrote, where Pixels differ from the texture's source.
+	 * Only a raw source that already is a single BGRA8 image of Size is compared, block by block, and only inside
+	 * CapturedRect. A compressed source would have to be decoded on the calling thread, so it is not compared and all of
+	 * CapturedRect counts as changed; callers recognize an unchanged file by its hash instead (see IsImportedFile).
+	 * Any other layout changes the whole image.
+	 */
+	void FindChangedRects(const UTexture2D& Texture, TConstArrayView<FColor> Pixels, const FIntPoint& Size, const FIntRect& CapturedRect,
+	                      TArray<FIntRect>& OutChangedRects);
+
+	/**
+	 * Re-initializes the whole source with a BGRA8 image: the engine builds and caches a texture as one unit, so
+	 * rewriting only the changed blocks would not spare the rebuild. With CompressedImage (the same pixels encoded as
+	 * CompressionFormat, e.g. the PNG file they were decoded from) those bytes become the payload; without it the
+	 * pixels are stored raw.
+	 */
+	void SetSource(UTexture2D& Texture, TConstArrayView<FColor> Pixels, const FIntPoint& Size, TArrayView64<uint8> CompressedImage = {},
+	               ETextureSourceCompressionFormat CompressionFormat = TSCF_None);
+
+	/**
+	 * FindChangedRects over CapturedRect, then SetSource unless nothing changed. OutChangedRects receives the regions
+	 * that differ, for logs. The caller rebuilds the texture unless the result is Unchanged.
+	 */
+	EMinimapTextureSourceUpdate Update(UTexture2D& Texture, TConstArrayView<FColor> Pixels, const FIntPoint& Size, const FIntRect& CapturedRect,
+	                                   TArray<FIntRect>& OutChangedRects, TArrayView64<uint8> CompressedImage = {},
+	                                   ETextureSourceCompressionFormat CompressionFormat = TSCF_None);
+
+	/** UDIM numbers hold at most 10 pages per row; rows are unlimited. */
+	constexpr int32 MaxUDIMColumns = 10;
+
+	/** Pages across and down that cover an image of Size; the last column and row may be partly outside it. */
+	FIntPoint GetPageCount(const FIntPoint& Size, int32 PageSize);
+
+	/** 1001 for the top-left page, +1 per column and +10 per row. */
+	int32 GetUDIMIndex(const FIntPoint& PageCoord);
+
+	/**
+	 * Re-initializes the source as PageCount UDIM blocks of PageSize BGRA8 pixels for WritePage to fill one page at a
+	 * time, and turns on virtual texture streaming, which UDIM textures need.
+	 */
+	void InitPages(UTexture2D& Texture, const FIntPoint& PageCount, int32 PageSize);
+
+	/**
+	 * Copies one page into its block. Pixels that are not a full page clear the block instead, and return false, so
+	 * a page that could not be read does not keep stale data.
+	 */
+	bool WritePage(UTexture2D& Texture, const FIntPoint& PageCoord, TConstArrayView<FColor> Pixels, const FIntPoint& Size);
+
+	/**
+	 * True when the texture's source was last set from a file with this hash by SetImportedFile and is still a single
+	 * image of Size. Compressed sources are checked this way instead of being decoded to compare pixels.
+	 */
+	bool IsImportedFile(const UTexture2D& Texture, const FMD5Hash& FileHash, const FIntPoint& Size);
+
+	/** Records the file the source was set from in the texture's import data; an empty Path clears it. */
+	void SetImportedFile(UTexture2D& Texture, const FString& Path, const FMD5Hash& FileHash);
+
+	/** Loads and decodes an image file. Touches no UObject, so it runs on any thread. */
+	bool DecodeImageFile(const FString& Path, FMinimapDecodedImage& OutImage, FString& OutError);
+
+	/** The engine's compressed-source format for an encoded image file, or TSCF_None when it has to be stored raw. */
+	ETextureSourceCompressionFormat GetCompressionFormat(EImageFormat ImageFormat);
+
+	/** Share of the image covered by the rects, for logs. */
+	double GetChangedFraction(const TArray<FIntRect>& ChangedRects, const FIntPoint& Size);
+}
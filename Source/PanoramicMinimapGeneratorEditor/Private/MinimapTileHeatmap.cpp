@@ -0,0 +1,224 @@
+#include "MinimapTileHeatmap.h"
+
+#include "Rendering/DrawElements.h"
+#include "Styling/AppStyle.h"
+
+#define LOCTEXT_NAMESPACE "SMinimapTileHeatmap"
+
+namespace MinimapTileHeatmap
+{
+	constexpr float CellOpacity = 0.45f;
+	const FLinearColor CheapColor(0.0f, 0.8f, 0.1f);
+	const FLinearColor ExpensiveColor(1.0f, 0.05f, 0.0f);
+	/** Skipped tiles and tiles without a measurement for the selected metric. */
+	const FLinearColor NoDataColor(0.3f, 0.3f, 0.3f, 0.35f);
+}
+
+void SMinimapTileHeatmap::Construct(const FArguments& InArgs)
+{
+	Metric = InArgs._Metric;
+	SetToolTipText(MakeAttributeSP(this, &SMinimapTileHeatmap::GetHoveredTileText));
+}
+
+void SMinimapTileHeatmap::SetTiles(const FMinimapTileLayout& InLayout, const TArray<FMinimapTileStats>& InTiles)
+{
+	Layout = InLayout;
+	Tiles = InTiles;
+	HoveredTile = INDEX_NONE;
+}
+
+void SMinimapTileHeatmap::ClearTiles()
+{
+	Layout = FMinimapTileLayout();
+	Tiles.Reset();
+	HoveredTile = INDEX_NONE;
+}
+
+double SMinimapTileHeatmap::GetMetricSeconds(const FMinimapTileStats& Tile, const EMinimapHeatmapMetric InMetric)
+{
+	switch (InMetric)
+	{
+	case EMinimapHeatmapMetric::GpuRender:
+		return Tile.GpuRenderSeconds;
+	case EMinimapHeatmapMetric::Readback:
+		return Tile.ReadbackSeconds;
+	case EMinimapHeatmapMetric::StreamingWait:
+		return Tile.StreamingWaitSeconds;
+	case EMinimapHeatmapMetric::Latency:
+	default:
+		return Tile.LatencySeconds;
+	}
+}
+
+FText SMinimapTileHeatmap::GetMetricDisplayName(const EMinimapHeatmapMetric InMetric)
+{
+	switch (InMetric)
+	{
+	case EMinimapHeatmapMetric::GpuRender:
+		return LOCTEXT("MetricGpuRender", "GPU Render");
+	case EMinimapHeatmapMetric::Readback:
+		return LOCTEXT("MetricReadback", "Readback");
+	case EMinimapHeatmapMetric::StreamingWait:
+		return LOCTEXT("MetricStreamingWait", "Streaming Wait");
+	case EMinimapHeatmapMetric::Latency:
+	default:
+		return LOCTEXT("MetricLatency", "Total Latency");
+	}
+}
+
+FIntRect SMinimapTileHeatmap::GetTileCellRect(const FMinimapTileStats& Tile) const
+{
+	const FIntPoint Step(FMath::Max(1, Layout.TileSize.X - Layout.Overlap), FMath::Max(1, Layout.TileSize.Y - Layout.Overlap));
+	const FIntPoint Min(Tile.TileCoord.X * Step.X, Tile.TileCoord.Y * Step.Y);
+	const FIntPoint Max(Tile.TileCoord.X == Layout.NumTiles.X - 1 ? Layout.OutputSize.X : Min.X + Step.X,
+	                    Tile.TileCoord.Y == Layout.NumTiles.Y - 1 ? Layout.OutputSize.Y : Min.Y + Step.Y);
+	return FIntRect(Min.ComponentMin(Layout.OutputSize), Max.ComponentMin(Layout.OutputSize));
+}
+
+int32 SMinimapTileHeatmap::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+                                   FSlateWindowElementList& OutDrawElements, const int32 LayerId, const FWidgetStyle& InWidgetStyle,
+                                   const bool bParentEnabled) const
+{
+	using namespace MinimapTileHeatmap;
+
+	if (Tiles.Num() == 0 || Layout.OutputSize.X <= 0 || Layout.OutputSize.Y <= 0)
+	{
+		return LayerId;
+	}
+
+	const EMinimapHeatmapMetric CurrentMetric = Metric.Get();
+	double MinSeconds = TNumericLimits<double>::Max();
+	double MaxSeconds = 0.0;
+	for (const FMinimapTileStats& Tile : Tiles)
+	{
+		const double Seconds = GetMetricSeconds(Tile, CurrentMetric);
+		if (!Tile.bSkipped && Seconds >= 0.0)
+		{
+			MinSeconds = FMath::Min(MinSeconds, Seconds);
+			MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+		}
+	}
+
+	const FSlateBrush* WhiteBrush = FAppStyle::GetBrush("WhiteBrush");
+	const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+	const FVector2D CanvasToLocal = LocalSize / FVector2D(Layout.OutputSize);
+
+	for (int32 Index = 0; Index < Tiles.Num(); ++Index)
+	{
+		const FMinimapTileStats& Tile = Tiles[Index];
+		const FIntRect Cell = GetTileCellRect(Tile);
+		if (Cell.Area() <= 0)
+		{
+			continue;
+		}
+
+		const double Seconds = GetMetricSeconds(Tile, CurrentMetric);
+		FLinearColor Color = NoDataColor;
+		if (!Tile.bSkipped && Seconds >= 0.0)
+		{
+			const double Range = MaxSeconds - MinSeconds;
+			const float Alpha = Range > UE_SMALL_NUMBER ? static_cast<float>((Seconds - MinSeconds) / Range) : 0.0f;
+			Color = FLinearColor::LerpUsingHSV(CheapColor, ExpensiveColor, Alpha);
+			Color.A = Index == HoveredTile ? FMath::Min(1.0f, CellOpacity * 1.6f) : CellOpacity;
+		}
+
+		// Leave a one-pixel gap between cells so tiles with similar costs stay distinguishable.
+		const FVector2D CellMin = FVector2D(Cell.Min) * CanvasToLocal;
+		const FVector2D CellSize = (FVector2D(Cell.Size()) * CanvasToLocal - FVector2D(1.0, 1.0)).ComponentMax(FVector2D::ZeroVector);
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			LayerId,
+			AllottedGeometry.ToPaintGeometry(CellSize, FSlateLayoutTransform(CellMin)),
+			WhiteBrush,
+			ESlateDrawEffect::None,
+			Color * InWidgetStyle.GetColorAndOpacityTint());
+	}
+
+	return LayerId;
+}
+
+FVector2D SMinimapTileHeatmap::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Fills whatever the image beneath it is given.
+	return FVector2D::ZeroVector;
+}
+
+int32 SMinimapTileHeatmap::FindTileAt(const FVector2D& LocalPosition, const FVector2D& LocalSize) const
+{
+	if (Tiles.Num() == 0 || LocalSize.X <= 0.0 || LocalSize.Y <= 0.0)
+	{
+		return INDEX_NONE;
+	}
+
+	const FIntPoint CanvasPosition(
+		FMath::FloorToInt32(LocalPosition.X / LocalSize.X * Layout.OutputSize.X),
+		FMath::FloorToInt32(LocalPosition.Y / LocalSize.Y * Layout.OutputSize.Y));
+	for (int32 Index = 0; Index < Tiles.Num(); ++Index)
+	{
+		if (GetTileCellRect(Tiles[Index]).Contains(CanvasPosition))
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+FReply SMinimapTileHeatmap::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	const FVector2D LocalPosition = MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition());
+	HoveredTile = FindTileAt(LocalPosition, MyGeometry.GetLocalSize());
+	return FReply::Unhandled();
+}
+
+void SMinimapTileHeatmap::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	SLeafWidget::OnMouseLeave(MouseEvent);
+	HoveredTile = INDEX_NONE;
+}
+
+FText SMinimapTileHeatmap::GetHoveredTileText() const
+{
+	if (!Tiles.IsValidIndex(HoveredTile))
+	{
+		return FText::GetEmpty();
+	}
+
+	const FMinimapTileStats& Tile = Tiles[HoveredTile];
+	if (Tile.bSkipped)
+	{
+		return FText::Format(LOCTEXT("SkippedTileTooltip", "Tile ({0}, {1}) #{2}\nSkipped: no visible primitives"),
+			FText::AsNumber(Tile.TileCoord.X), FText::AsNumber(Tile.TileCoord.Y), FText::AsNumber(Tile.TileIndex));
+	}
+
+	FNumberFormattingOptions Milliseconds;
+	Milliseconds.MinimumFractionalDigits = 2;
+	Milliseconds.MaximumFractionalDigits = 2;
+	const auto FormatMs = [&Milliseconds](const double Seconds)
+	{
+		return Seconds >= 0.0
+			? FText::Format(LOCTEXT("MsFormat", "{0} ms"), FText::AsNumber(Seconds * 1000.0, &Milliseconds))
+			: LOCTEXT("NotMeasured", "n/a");
+	};
+
+	FFormatNamedArguments Args;
+	Args.Add(TEXT("X"), FText::AsNumber(Tile.TileCoord.X));
+	Args.Add(TEXT("Y"), FText::AsNumber(Tile.TileCoord.Y));
+	Args.Add(TEXT("Index"), FText::AsNumber(Tile.TileIndex));
+	Args.Add(TEXT("Width"), FText::AsNumber(Tile.Size.X));
+	Args.Add(TEXT("Height"), FText::AsNumber(Tile.Size.Y));
+	Args.Add(TEXT("Gpu"), FormatMs(Tile.GpuRenderSeconds));
+	Args.Add(TEXT("Queue"), FormatMs(Tile.RenderSeconds));
+	Args.Add(TEXT("Wait"), FormatMs(Tile.StreamingWaitSeconds));
+	Args.Add(TEXT("Readback"), FormatMs(Tile.ReadbackSeconds));
+	Args.Add(TEXT("Latency"), FormatMs(Tile.LatencySeconds));
+	Args.Add(TEXT("Frames"), FText::AsNumber(Tile.FramesRendered));
+	return FText::Format(LOCTEXT("TileTooltip",
+		"Tile ({X}, {Y}) #{Index} - {Width}x{Height}\n"
+		"GPU render: {Gpu} ({Frames} frame(s))\n"
+		"Queue (game thread): {Queue}\n"
+		"Streaming wait: {Wait}\n"
+		"Readback: {Readback}\n"
+		"Total latency: {Latency}"), Args);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinimapCaptureReport.h"
+#include "MinimapTileLayout.h"
+#include "Widgets/SLeafWidget.h"
+
+/** Which per-tile timing the heatmap colours by. */
+enum class EMinimapHeatmapMetric : uint8
+{
+	Latency,
+	GpuRender,
+	Readback,
+	StreamingWait
+};
+
+/**
+ * Draws one translucent cell per capture tile, coloured from green (cheapest) to red (most expensive) for the
+ * selected metric. Meant to be stacked over the preview image in an SOverlay so it scales with it; hovering a
+ * cell shows the exact timings of that tile.
+ */
+class SMinimapTileHeatmap : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SMinimapTileHeatmap)
+		: _Metric(EMinimapHeatmapMetric::Latency)
+		{
+		}
+
+		SLATE_ATTRIBUTE(EMinimapHeatmapMetric, Metric)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	void SetTiles(const FMinimapTileLayout& InLayout, const TArray<FMinimapTileStats>& InTiles);
+	void ClearTiles();
+	bool HasTiles() const { return Tiles.Num() > 0; }
+
+	/** Seconds of the given metric, or a negative value when the tile has no measurement for it. */
+	static double GetMetricSeconds(const FMinimapTileStats& Tile, EMinimapHeatmapMetric InMetric);
+	static FText GetMetricDisplayName(EMinimapHeatmapMetric InMetric);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	                      FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
+	                      bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+
+private:
+	/** Canvas-space rect a tile owns, i.e. its rect without the overlap shared with the next tile. */
+	FIntRect GetTileCellRect(const FMinimapTileStats& Tile) const;
+	int32 FindTileAt(const FVector2D& LocalPosition, const FVector2D& LocalSize) const;
+	FText GetHoveredTileText() const;
+
+	TAttribute<EMinimapHeatmapMetric> Metric;
+	FMinimapTileLayout Layout;
+	TArray<FMinimapTileStats> Tiles;
+	/** Index into Tiles of the cell under the cursor. */
+	int32 HoveredTile = INDEX_NONE;
+};
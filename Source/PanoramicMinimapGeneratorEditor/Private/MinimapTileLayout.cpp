@@ -0,0 +1,98 @@
+#include "MinimapTileLayout.h"
+
+namespace MinimapTileLayout
+{
+	/** Plans one axis: fewest tiles first, then the smallest aligned tile that still covers the axis. */
+	static void PlanAxis(const int32 OutputSize, const int32 Overlap, const int32 MaxTileSize, const int32 Alignment,
+	                     int32& OutNumTiles, int32& OutTileSize, int32& OutEdgeTileSize)
+	{
+		if (OutputSize <= MaxTileSize)
+		{
+			OutNumTiles = 1;
+			OutTileSize = OutputSize;
+			OutEdgeTileSize = OutputSize;
+			return;
+		}
+
+		const int32 MaxStep = MaxTileSize - Overlap;
+		OutNumTiles = FMath::DivideAndRoundUp(OutputSize - Overlap, MaxStep);
+
+		// Spread the canvas evenly so the edge tile is not a thin sliver, then round up for GPU-friendly sizes.
+		const int32 BalancedTileSize = FMath::DivideAndRoundUp(OutputSize + (OutNumTiles - 1) * Overlap, OutNumTiles);
+		OutTileSize = FMath::Min(FMath::DivideAndRoundUp(BalancedTileSize, Alignment) * Alignment, MaxTileSize);
+		OutEdgeTileSize = OutputSize - (OutNumTiles - 1) * (OutTileSize - Overlap);
+	}
+}
+
+FIntRect FMinimapTileLayout::GetTileRect(const int32 TileX, const int32 TileY) const
+{
+	const FIntPoint Step = TileSize - FIntPoint(Overlap, Overlap);
+	const FIntPoint Min(TileX * Step.X, TileY * Step.Y);
+	const FIntPoint Size(TileX == NumTiles.X - 1 ? EdgeTileSize.X : TileSize.X,
+	                     TileY == NumTiles.Y - 1 ? EdgeTileSize.Y : TileSize.Y);
+	return FIntRect(Min, Min + Size);
+}
+
+int64 FMinimapTileLayout::GetRenderedPixelCount() const
+{
+	const int64 RenderedWidth = static_cast<int64>(NumTiles.X - 1) * TileSize.X + EdgeTileSize.X;
+	const int64 RenderedHeight = static_cast<int64>(NumTiles.Y - 1) * TileSize.Y + EdgeTileSize.Y;
+	return IsValid() ? RenderedWidth * RenderedHeight : 0;
+}
+
+FString FMinimapTileLayout::ToString() const
+{
+	if (!IsValid())
+	{
+		return TEXT("Invalid tile layout");
+	}
+
+	const int64 CanvasPixels = static_cast<int64>(OutputSize.X) * OutputSize.Y;
+	const double Overdraw = CanvasPixels > 0 ? static_cast<double>(GetRenderedPixelCount()) / CanvasPixels : 0.0;
+	return FString::Printf(TEXT("%dx%d tiles of %dx%d (edge %dx%d), overlap %d px, %.1f MPix rendered (%.1f%% of canvas)"),
+		NumTiles.X, NumTiles.Y, TileSize.X, TileSize.Y, EdgeTileSize.X, EdgeTileSize.Y, Overlap,
+		GetRenderedPixelCount() / 1000000.0, Overdraw * 100.0);
+}
+
+FMinimapTileLayout FMinimapTileLayout::MakeUniform(const FIntPoint& InOutputSize, const int32 TileResolution, const int32 InOverlap)
+{
+	FMinimapTileLayout Layout;
+	Layout.OutputSize = InOutputSize;
+	Layout.Overlap = InOverlap;
+
+	const int32 EffectiveTileRes = TileResolution - InOverlap;
+	if (EffectiveTileRes <= 0 || InOutputSize.X <= 0 || InOutputSize.Y <= 0)
+	{
+		return Layout;
+	}
+
+	Layout.TileSize = FIntPoint(TileResolution, TileResolution);
+	Layout.EdgeTileSize = Layout.TileSize;
+	Layout.NumTiles.X = (InOutputSize.X <= TileResolution)
+		                    ? 1
+		                    : (1 + FMath::CeilToInt(static_cast<float>(InOutputSize.X - TileResolution) / EffectiveTileRes));
+	Layout.NumTiles.Y = (InOutputSize.Y <= TileResolution)
+		                    ? 1
+		                    : (1 + FMath::CeilToInt(static_cast<float>(InOutputSize.Y - TileResolution) / EffectiveTileRes));
+	return Layout;
+}
+
+FMinimapTileLayout FMinimapTileLayout::Plan(const FIntPoint& InOutputSize, const int32 InOverlap, const int32 MaxRenderTargetSize,
+                                            const int32 Alignment)
+{
+	FMinimapTileLayout Layout;
+	Layout.OutputSize = InOutputSize;
+	Layout.Overlap = InOverlap;
+
+	if (MaxRenderTargetSize - InOverlap <= 0 || InOutputSize.X <= 0 || InOutputSize.Y <= 0)
+	{
+		return Layout;
+	}
+
+	const int32 SafeAlignment = FMath::Max(1, Alignment);
+	MinimapTileLayout::PlanAxis(InOutputSize.X, InOverlap, MaxRenderTargetSize, SafeAlignment,
+	                            Layout.NumTiles.X, Layout.TileSize.X, Layout.EdgeTileSize.X);
+	MinimapTileLayout::PlanAxis(InOutputSize.Y, InOverlap, MaxRenderTargetSize, SafeAlignment,
+	                            Layout.NumTiles.Y, Layout.TileSize.Y, Layout.EdgeTileSize.Y);
+	return Layout;
+}
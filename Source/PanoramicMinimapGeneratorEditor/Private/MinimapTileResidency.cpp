@@ -0,0 +1,97 @@
+#include "MinimapTileResidency.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture.h"
+#include "Engine/StreamableRenderAsset.h"
+#include "SceneTypes.h"
+
+void FMinimapTileResidency::Build(const TArray<AActor*>& VisibleActors, const FMinimapTileLayout& Layout, const FVector2D& WorldOrigin,
+                                  const double WorldUnitsPerPixel)
+{
+	Reset();
+	PrimitiveBounds.Build(VisibleActors, Layout, WorldOrigin, WorldUnitsPerPixel);
+}
+
+void FMinimapTileResidency::Reset()
+{
+	PrimitiveBounds.Reset();
+	RequestedAssets.Empty();
+}
+
+void FMinimapTileResidency::Request(const int32 TileIndex, const float ResidentSeconds)
+{
+	if (!PrimitiveBounds.IsBuilt() || RequestedAssets.Contains(TileIndex))
+	{
+		return;
+	}
+
+	// Primitives share materials and meshes; force each asset once.
+	TSet<UStreamableRenderAsset*> Assets;
+	TArray<UTexture*> Textures;
+	for (const TWeakObjectPtr<UPrimitiveComponent>& WeakPrimitive : PrimitiveBounds.GetTilePrimitives(TileIndex))
+	{
+		const UPrimitiveComponent* Primitive = WeakPrimitive.Get();
+		if (!Primitive)
+		{
+			continue;
+		}
+
+		Textures.Reset();
+		Primitive->GetUsedTextures(Textures, EMaterialQualityLevel::Num);
+		for (UTexture* Texture : Textures)
+		{
+			if (Texture && Texture->IsStreamable())
+			{
+				Assets.Add(Texture);
+			}
+		}
+
+		if (const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Primitive))
+		{
+			if (UStaticMesh* Mesh = MeshComponent->GetStaticMesh(); Mesh && Mesh->IsStreamable())
+			{
+				Assets.Add(Mesh);
+			}
+		}
+	}
+
+	TArray<TWeakObjectPtr<UStreamableRenderAsset>>& Requested = RequestedAssets.Add(TileIndex);
+	Requested.Reserve(Assets.Num());
+	for (UStreamableRenderAsset* Asset : Assets)
+	{
+		Asset->SetForceMipLevelsToBeResident(ResidentSeconds);
+		Requested.Add(Asset);
+	}
+}
+
+int32 FMinimapTileResidency::GetNumPendingAssets(const int32 TileIndex) const
+{
+	const TArray<TWeakObjectPtr<UStreamableRenderAsset>>* Requested = RequestedAssets.Find(TileIndex);
+	if (!Requested)
+	{
+		return 0;
+	}
+
+	int32 NumPending = 0;
+	for (const TWeakObjectPtr<UStreamableRenderAsset>& WeakAsset : *Requested)
+	{
+		UStreamableRenderAsset* Asset = WeakAsset.Get();
+		if (Asset && (Asset->HasPendingInitOrStreaming() || !Asset->IsFullyStreamedIn()))
+		{
+			NumPending++;
+		}
+	}
+	return NumPending;
+}
+
+bool FMinimapTileResidency::IsResident(const int32 TileIndex) const
+{
+	return GetNumPendingAssets(TileIndex) == 0;
+}
+
+void FMinimapTileResidency::Release(const int32 TileIndex)
+{
+	RequestedAssets.Remove(TileIndex);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinimapPrimitiveBoundsIndex.h"
+
+class UStreamableRenderAsset;
+
+/**
+ * Forces the streamed mips of the textures and static meshes in a tile's footprint to be resident before the tile is
+ * captured, so it is not rendered with the low mips streaming had time to load. Tiles are requested ahead of time
+ * and polled until every requested asset is fully streamed in; everything else in the level streams as usual.
+ */
+class FMinimapTileResidency
+{
+public:
+	/** Indexes the primitives of the visible actors by tile, with the same mapping as the empty-tile index. */
+	void Build(const TArray<AActor*>& VisibleActors, const FMinimapTileLayout& Layout, const FVector2D& WorldOrigin, double WorldUnitsPerPixel);
+	void Reset();
+
+	/** Asks the streamer for every mip of the tile's assets. Requesting a tile again does nothing. */
+	void Request(int32 TileIndex, float ResidentSeconds);
+	/** True once every asset requested for the tile is fully streamed in, or when it was never requested. */
+	bool IsResident(int32 TileIndex) const;
+	int32 GetNumPendingAssets(int32 TileIndex) const;
+	/** Forgets the tile's request once it has been captured; the forced residency runs out on its own. */
+	void Release(int32 TileIndex);
+
+private:
+	FMinimapPrimitiveBoundsIndex PrimitiveBounds;
+	TMap<int32, TArray<TWeakObjectPtr<UStreamableRenderAsset>>> RequestedAssets;
+};
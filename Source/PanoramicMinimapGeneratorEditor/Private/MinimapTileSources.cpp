@@ -0,0 +1,743 @@
+#include "MinimapTileSources.h"
+
+#include "MinimapGeneratorManager.h"
+#include "MinimapGeneratorStats.h"
+#include "MinimapGpuTimer.h"
+#include "MinimapImageKernels.h"
+#include "PanoramicMinimapGeneratorEditor.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/SceneCapture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// ===================================================================
+// CONTEXT
+// ===================================================================
+
+FIntRect FMinimapTileSourceContext::GetTileRect(const int32 TileIndex) const
+{
+	const FIntPoint TileCoord = Layout.GetTileCoord(TileIndex);
+	return Layout.GetTileRect(TileCoord.X, TileCoord.Y);
+}
+
+FIntPoint FMinimapTileSourceContext::GetTileSize(const int32 TileIndex) const
+{
+	const FIntRect TileRect = GetTileRect(TileIndex);
+	return IsPortrait() ? FIntPoint(TileRect.Height(), TileRect.Width()) : TileRect.Size();
+}
+
+FIntPoint FMinimapTileSourceContext::TileToCanvas(const FIntRect& TileRect, const int32 X, const int32 Y) const
+{
+	// Mirrors MinimapImageKernels::CompositeTile: rotated tile row Y becomes canvas column (Width - 1 - Y), column X becomes row X.
+	return IsPortrait()
+		       ? FIntPoint(TileRect.Min.X + TileRect.Width() - 1 - Y, TileRect.Min.Y + X)
+		       : FIntPoint(TileRect.Min.X + X, TileRect.Min.Y + Y);
+}
+
+FString GetSavedTileFileName(const FString& BaseFileName, const FIntPoint& TileCoord)
+{
+	return FString::Printf(TEXT("%s_Tile_%d_%d.png"), *BaseFileName, TileCoord.X, TileCoord.Y);
+}
+
+// ===================================================================
+// SCENE CAPTURE
+// ===================================================================
+
+bool FMinimapSceneCaptureTileSource::Begin(const FMinimapTileSourceContext& InContext, FString& OutError)
+{
+	Context = InContext;
+	Manager.ActiveRenderTarget = Manager.AcquireTileRenderTarget(Context.GetTileSize(0));
+	Manager.ActiveCaptureActor = Manager.AcquireCaptureActor(Manager.ActiveRenderTarget.Get());
+	if (!Manager.ActiveCaptureActor.IsValid() || !Manager.ActiveRenderTarget.IsValid())
+	{
+		OutError = TEXT("Failed to create capture actor or render target for tiling.");
+		return false;
+	}
+
+	// A perspective tile sees past its ground footprint, so only orthographic footprints say what a tile needs.
+	bPrestreaming = Context.Settings.bPrestreamTiles && Context.Settings.bIsOrthographic;
+	if (!bPrestreaming && Context.Settings.Floors.IsEmpty())
+	{
+		return true;
+	}
+
+	TArray<AActor*> VisibleActors;
+	Manager.GatherVisibleActors(Manager.ActiveCaptureActor->GetCaptureComponent2D(), VisibleActors);
+	if (bPrestreaming)
+	{
+		Residency.Build(VisibleActors, Context.Layout, FVector2D(Context.Settings.CaptureBounds.Min), Context.WorldUnitsPerPixel);
+	}
+
+	FloorPrimitives.SetNum(Context.Settings.Floors.Num());
+	for (AActor* Actor : VisibleActors)
+	{
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [this](const UPrimitiveComponent* Primitive)
+		{
+			if (!Primitive->IsRegistered() || !Primitive->IsVisible())
+			{
+				return;
+			}
+			const FBox Bounds = Primitive->Bounds.GetBox();
+			for (int32 FloorIndex = 0; FloorIndex < FloorPrimitives.Num(); ++FloorIndex)
+			{
+				const FMinimapFloorRange& Floor = Context.Settings.Floors[FloorIndex];
+				if (Bounds.Max.Z >= Floor.MinZ && Bounds.Min.Z <= Floor.MaxZ)
+				{
+					FloorPrimitives[FloorIndex].Add(const_cast<UPrimitiveComponent*>(Primitive));
+				}
+			}
+		});
+	}
+
+	static const IConsoleVariable* AllowClipPlane = IConsoleManager::Get().FindConsoleVariable(TEXT("r.AllowGlobalClipPlane"));
+	if (FloorPrimitives.Num() > 0 && (!AllowClipPlane || AllowClipPlane->GetInt() == 0))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Support Global Clip Plane is off in the project settings, so each floor also shows the parts of taller primitives above it."));
+	}
+	return true;
+}
+
+void FMinimapSceneCaptureTileSource::End()
+{
+	Residency.Reset();
+	FloorPrimitives.Empty();
+	Manager.ReleaseCaptureActor();
+	Manager.ReleaseRenderTargets();
+}
+
+void FMinimapSceneCaptureTileSource::PrepareTile(const int32 TileIndex)
+{
+	if (bPrestreaming)
+	{
+		// Long enough for the tile to wait out the timeout while the one before it renders.
+		Residency.Request(TileIndex, 2.0f * MinimapCapture::TileResidencyTimeoutSeconds);
+	}
+}
+
+bool FMinimapSceneCaptureTileSource::IsTileReady(const int32 TileIndex) const
+{
+	return Residency.IsResident(TileIndex);
+}
+
+bool FMinimapSceneCaptureTileSource::RequestTile(const int32 TileIndex, double& OutReadDelaySeconds, FString& OutError)
+{
+	// Edge tiles are smaller than the others, so they render into their own (pooled) render target.
+	const FIntRect TileRect = Context.GetTileRect(TileIndex);
+	const FIntPoint RenderTargetSize = Context.GetTileSize(TileIndex);
+	Manager.ActiveRenderTarget = Manager.AcquireTileRenderTarget(RenderTargetSize);
+	if (!Manager.ActiveCaptureActor.IsValid() || !Manager.ActiveRenderTarget.IsValid())
+	{
+		OutError = TEXT("Capture actor or render target became invalid during tiling process.");
+		return false;
+	}
+
+	// Tile origins are integer pixel offsets multiplied by WUPP in double precision, so every tile edge lands on an
+	// exact texel boundary no matter how far the tile is from the bounds origin.
+	const double WorldUnitsPerPixel = Context.WorldUnitsPerPixel;
+	const FVector BoundsMin = Context.Settings.CaptureBounds.Min;
+	const FVector TileCenterLocation(
+		BoundsMin.X + (TileRect.Min.X + TileRect.Width() * 0.5) * WorldUnitsPerPixel,
+		BoundsMin.Y + (TileRect.Min.Y + TileRect.Height() * 0.5) * WorldUnitsPerPixel,
+		Context.Settings.CameraHeight);
+
+	Manager.ActiveCaptureActor->SetActorLocation(TileCenterLocation);
+	USceneCaptureComponent2D* CaptureComponent = Manager.ActiveCaptureActor->GetCaptureComponent2D();
+	CaptureComponent->TextureTarget = Manager.ActiveRenderTarget.Get();
+
+	// OrthoWidth is the horizontal extent of the render target; the vertical extent follows from its aspect ratio.
+	CaptureComponent->OrthoWidth = static_cast<float>(RenderTargetSize.X * WorldUnitsPerPixel);
+
+	TileFrames = 0;
+	TileGpuSeconds = -1.0;
+	PreviousFrame.Reset();
+	SettledFrame.Reset();
+	if (Context.Settings.bPersistentViewState)
+	{
+		// The view state still holds the history of the previous tile, which is somewhere else entirely.
+		CaptureComponent->bCameraCutThisFrame = true;
+	}
+	CaptureFrame(*CaptureComponent);
+
+	// Give texture and World Partition streaming a moment to settle before reading the tile back. Prestreamed tiles
+	// were only requested once their mips were resident, and with a persistent view state the frames themselves tell
+	// when the tile has settled, so neither waits.
+	OutReadDelaySeconds = bPrestreaming || Context.Settings.bPersistentViewState ? 0.0 : MinimapCapture::TileReadbackDelaySeconds;
+	return true;
+}
+
+void FMinimapSceneCaptureTileSource::CaptureFrame(USceneCaptureComponent2D& CaptureComponent)
+{
+	Manager.TileGpuTimer->Begin();
+	CaptureComponent.CaptureScene();
+	Manager.TileGpuTimer->End();
+	++TileFrames;
+}
+
+void FMinimapSceneCaptureTileSource::ReadFrame(TArray<FColor>& OutPixels)
+{
+	UTextureRenderTarget2D* RenderTarget = Manager.ActiveRenderTarget.Get();
+	if (auto* RTResource = RenderTarget ? static_cast<FTextureRenderTargetResource*>(RenderTarget->GetResource()) : nullptr)
+	{
+		Manager.TileGpuTimer->Resolve();
+		FlushRenderingCommands();
+		RTResource->ReadPixels(OutPixels);
+		if (const double FrameGpuSeconds = Manager.TileGpuTimer->GetElapsedSeconds(); FrameGpuSeconds >= 0.0)
+		{
+			TileGpuSeconds = FMath::Max(TileGpuSeconds, 0.0) + FrameGpuSeconds;
+		}
+	}
+}
+
+bool FMinimapSceneCaptureTileSource::NeedsMoreFrames(const int32 TileIndex, double& OutReadDelaySeconds)
+{
+	if (!Context.Settings.bPersistentViewState || !Manager.ActiveCaptureActor.IsValid())
+	{
+		return false;
+	}
+
+	TArray<FColor> Frame;
+	ReadFrame(Frame);
+	const double Difference = MinimapImageKernels::MeanAbsoluteDifference(Frame, PreviousFrame);
+	const bool bConverged = PreviousFrame.Num() > 0 && Difference >= 0.0 && Difference <= Context.Settings.ConvergenceThreshold;
+	if (bConverged || Frame.Num() == 0 || TileFrames >= FMath::Max(1, Context.Settings.MaxFramesPerTile))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Verbose, TEXT("Tile %d %s after %d frame(s), last difference %.3f."), TileIndex,
+			bConverged ? TEXT("converged") : TEXT("stopped"), TileFrames, Difference);
+		SettledFrame = MoveTemp(Frame);
+		PreviousFrame.Empty();
+		return false;
+	}
+
+	PreviousFrame = MoveTemp(Frame);
+	CaptureFrame(*Manager.ActiveCaptureActor->GetCaptureComponent2D());
+	OutReadDelaySeconds = 0.0;
+	return true;
+}
+
+bool FMinimapSceneCaptureTileSource::ReadTile(const int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError)
+{
+	UTextureRenderTarget2D* RenderTarget = Manager.ActiveRenderTarget.Get();
+	if (!RenderTarget)
+	{
+		OutError = TEXT("Render Target lost during tiling.");
+		return false;
+	}
+
+	Residency.Release(TileIndex);
+	if (SettledFrame.Num() > 0)
+	{
+		OutPixels = MoveTemp(SettledFrame);
+		return true;
+	}
+
+	ReadFrame(OutPixels);
+	return true;
+}
+
+bool FMinimapSceneCaptureTileSource::ReadTileBuffer(const int32 TileIndex, const EMinimapCaptureBuffer Buffer, TArray<FColor>& OutPixels)
+{
+	ASceneCapture2D* CaptureActor = Manager.ActiveCaptureActor.Get();
+	const FIntPoint Size = Context.GetTileSize(TileIndex);
+	const bool bFloatBuffer = MinimapCaptureBuffers::IsFloatBuffer(Buffer);
+	// The color tile has been read back already, so the 8-bit buffers can reuse its render target.
+	UTextureRenderTarget2D* RenderTarget = bFloatBuffer ? Manager.AcquireFloatRenderTarget(Size) : Manager.AcquireTileRenderTarget(Size);
+	auto* RTResource = RenderTarget ? static_cast<FTextureRenderTargetResource*>(RenderTarget->GetResource()) : nullptr;
+	if (!CaptureActor || !RTResource)
+	{
+		return false;
+	}
+
+	// Same camera, same streamed content: only what the renderer writes out changes.
+	USceneCaptureComponent2D* CaptureComponent = CaptureActor->GetCaptureComponent2D();
+	const TEnumAsByte<ESceneCaptureSource> ColorSource = CaptureComponent->CaptureSource;
+	UTextureRenderTarget2D* ColorTarget = CaptureComponent->TextureTarget;
+	CaptureComponent->CaptureSource = MinimapCaptureBuffers::GetCaptureSource(Buffer);
+	CaptureComponent->TextureTarget = RenderTarget;
+	CaptureComponent->CaptureScene();
+	CaptureComponent->CaptureSource = ColorSource;
+	CaptureComponent->TextureTarget = ColorTarget;
+	FlushRenderingCommands();
+
+	if (!bFloatBuffer)
+	{
+		RTResource->ReadPixels(OutPixels);
+		return OutPixels.Num() > 0;
+	}
+
+	// Depth and normals are not in [0, 1]; read them back unclamped.
+	TArray<FLinearColor> Samples;
+	RTResource->ReadLinearColorPixels(Samples, FReadSurfaceDataFlags(RCM_MinMax));
+	if (Samples.IsEmpty())
+	{
+		return false;
+	}
+	MinimapCaptureBuffers::PackTile(Buffer, Context.Settings, Samples, OutPixels);
+	return true;
+}
+
+bool FMinimapSceneCaptureTileSource::ReadTileFloor(const int32 TileIndex, const int32 FloorIndex, TArray<FColor>& OutPixels)
+{
+	ASceneCapture2D* CaptureActor = Manager.ActiveCaptureActor.Get();
+	UTextureRenderTarget2D* RenderTarget = Manager.ActiveRenderTarget.Get();
+	auto* RTResource = RenderTarget ? static_cast<FTextureRenderTargetResource*>(RenderTarget->GetResource()) : nullptr;
+	if (!CaptureActor || !RTResource || !FloorPrimitives.IsValidIndex(FloorIndex))
+	{
+		return false;
+	}
+
+	// The color tile has been read back, so the floor renders over it from the same camera with its own primitives,
+	// and everything above the floor's ceiling is clipped. The plane keeps what lies on the side its normal points to.
+	USceneCaptureComponent2D* CaptureComponent = CaptureActor->GetCaptureComponent2D();
+	const ESceneCapturePrimitiveRenderMode RenderMode = CaptureComponent->PrimitiveRenderMode;
+	TArray<TObjectPtr<AActor>> ShowOnlyActors = MoveTemp(CaptureComponent->ShowOnlyActors);
+	CaptureComponent->PrimitiveRenderMode = ESceneCapturePrimitiveRenderMode::PRM_UseShowOnlyList;
+	CaptureComponent->ShowOnlyActors.Reset();
+	CaptureComponent->ShowOnlyComponents = FloorPrimitives[FloorIndex];
+	CaptureComponent->bEnableClipPlane = true;
+	CaptureComponent->ClipPlaneBase = FVector(0.0, 0.0, Context.Settings.Floors[FloorIndex].MaxZ);
+	CaptureComponent->ClipPlaneNormal = FVector::DownVector;
+	if (Context.Settings.bPersistentViewState)
+	{
+		CaptureComponent->bCameraCutThisFrame = true;
+	}
+	CaptureComponent->CaptureScene();
+
+	CaptureComponent->PrimitiveRenderMode = RenderMode;
+	CaptureComponent->ShowOnlyActors = MoveTemp(ShowOnlyActors);
+	CaptureComponent->ShowOnlyComponents.Reset();
+	CaptureComponent->bEnableClipPlane = false;
+	FlushRenderingCommands();
+
+	RTResource->ReadPixels(OutPixels);
+	return OutPixels.Num() > 0;
+}
+
+double FMinimapSceneCaptureTileSource::GetLastGpuSeconds() const
+{
+	return TileGpuSeconds;
+}
+
+// ===================================================================
+// SAVED TILES
+// ===================================================================
+
+bool FMinimapSavedTilesTileSource::Begin(const FMinimapTileSourceContext& InContext, FString& OutError)
+{
+	Context = InContext;
+	if (Directory.IsEmpty())
+	{
+		Directory = Context.Settings.TileSourceDirectory.IsEmpty() ? Context.Settings.OutputPath : Context.Settings.TileSourceDirectory;
+	}
+
+	AvailableTiles.Init(false, Context.Layout.GetNumTiles());
+	int32 NumAvailable = 0;
+	for (int32 TileIndex = 0; TileIndex < Context.Layout.GetNumTiles(); ++TileIndex)
+	{
+		if (FPaths::FileExists(GetTilePath(TileIndex)))
+		{
+			AvailableTiles[TileIndex] = true;
+			NumAvailable++;
+		}
+	}
+
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("Found %d of %d saved tiles named %s in '%s'."), NumAvailable,
+		Context.Layout.GetNumTiles(), *GetSavedTileFileName(Context.Settings.FileName, FIntPoint(0, 0)), *Directory);
+	return true;
+}
+
+bool FMinimapSavedTilesTileSource::CanProvideTile(const int32 TileIndex) const
+{
+	return AvailableTiles.IsValidIndex(TileIndex) && AvailableTiles[TileIndex];
+}
+
+FString FMinimapSavedTilesTileSource::GetTilePath(const int32 TileIndex) const
+{
+	return FPaths::Combine(Directory, GetSavedTileFileName(Context.Settings.FileName, Context.Layout.GetTileCoord(TileIndex)));
+}
+
+bool FMinimapSavedTilesTileSource::RequestTile(int32 TileIndex, double& OutReadDelaySeconds, FString& OutError)
+{
+	OutReadDelaySeconds = 0.0;
+	return true;
+}
+
+bool FMinimapSavedTilesTileSource::ReadTile(const int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError)
+{
+	const FString TilePath = GetTilePath(TileIndex);
+	TArray<uint8> PngData;
+	if (!FFileHelper::LoadFileToArray(PngData, *TilePath))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Failed to read saved tile: %s"), *TilePath);
+		return true;
+	}
+
+	DecodeTile(TileIndex, TilePath, PngData, OutPixels);
+	return true;
+}
+
+void FMinimapSavedTilesTileSource::DecodeTile(const int32 TileIndex, const FString& TilePath, const TArray<uint8>& PngData,
+                                              TArray<FColor>& OutPixels) const
+{
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	TArray<uint8> RawBGRA;
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(PngData.GetData(), PngData.Num()) ||
+		!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawBGRA))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Failed to decode saved tile: %s"), *TilePath);
+		return;
+	}
+
+	// Tiles saved with another layout (output size, tile resolution, overlap) cannot be placed on this grid.
+	const FIntPoint ExpectedSize = Context.GetTileSize(TileIndex);
+	if (ImageWrapper->GetWidth() != ExpectedSize.X || ImageWrapper->GetHeight() != ExpectedSize.Y)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Saved tile %s is %lldx%lld, expected %dx%d for the current layout."),
+			*TilePath, ImageWrapper->GetWidth(), ImageWrapper->GetHeight(), ExpectedSize.X, ExpectedSize.Y);
+		return;
+	}
+
+	OutPixels.SetNumUninitialized(ExpectedSize.X * ExpectedSize.Y);
+	FMemory::Memcpy(OutPixels.GetData(), RawBGRA.GetData(), OutPixels.Num() * sizeof(FColor));
+}
+
+// ===================================================================
+// SHARD TILES
+// ===================================================================
+
+bool FMinimapShardTilesTileSource::Begin(const FMinimapTileSourceContext& InContext, FString& OutError)
+{
+	if (!FMinimapSavedTilesTileSource::Begin(InContext, OutError))
+	{
+		return false;
+	}
+
+	// A tile file without an index record may be left over from an earlier capture, or still being written.
+	Records.Reset();
+	for (int32 ShardIndex = 0; ShardIndex < NumShards; ++ShardIndex)
+	{
+		TArray<FMinimapShardTileRecord> ShardRecords;
+		MinimapShards::ReadIndex(FPaths::Combine(Directory, MinimapShards::GetIndexFileName(Context.Settings.FileName, ShardIndex)),
+			ShardIndex, ShardRecords);
+		for (const FMinimapShardTileRecord& Record : ShardRecords)
+		{
+			if (AvailableTiles.IsValidIndex(Record.TileIndex))
+			{
+				Records.Add(Record.TileIndex, Record);
+			}
+		}
+	}
+
+	int32 NumAvailable = 0;
+	for (int32 TileIndex = 0; TileIndex < AvailableTiles.Num(); ++TileIndex)
+	{
+		AvailableTiles[TileIndex] = AvailableTiles[TileIndex] && Records.Contains(TileIndex);
+		NumAvailable += AvailableTiles[TileIndex] ? 1 : 0;
+	}
+	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("%d of %d tiles were rendered by %d worker processes."), NumAvailable,
+		Context.Layout.GetNumTiles(), NumShards);
+	return true;
+}
+
+bool FMinimapShardTilesTileSource::ReadTile(const int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError)
+{
+	const FString TilePath = GetTilePath(TileIndex);
+	const FMinimapShardTileRecord* Record = Records.Find(TileIndex);
+	TArray<uint8> PngData;
+	if (!Record || !FFileHelper::LoadFileToArray(PngData, *TilePath))
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Failed to read shard tile: %s"), *TilePath);
+		return true;
+	}
+
+	if (PngData.Num() != Record->FileBytes || FCrc::MemCrc32(PngData.GetData(), PngData.Num()) != Record->FileCrc)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Shard tile %s does not match its index record; it was changed after the worker wrote it."),
+			*TilePath);
+		return true;
+	}
+
+	DecodeTile(TileIndex, TilePath, PngData, OutPixels);
+	return true;
+}
+
+// ===================================================================
+// SYNTHETIC
+// ===================================================================
+
+bool FMinimapSyntheticTileSource::Begin(const FMinimapTileSourceContext& InContext, FString& OutError)
+{
+	Context = InContext;
+	return true;
+}
+
+bool FMinimapSyntheticTileSource::RequestTile(int32 TileIndex, double& OutReadDelaySeconds, FString& OutError)
+{
+	OutReadDelaySeconds = 0.0;
+	return true;
+}
+
+bool FMinimapSyntheticTileSource::ReadTile(const int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError)
+{
+	const FIntRect TileRect = Context.GetTileRect(TileIndex);
+	const FIntPoint TileSize = Context.GetTileSize(TileIndex);
+	const FIntPoint CanvasSize(Context.Settings.OutputWidth, Context.Settings.OutputHeight);
+
+	OutPixels.SetNumUninitialized(TileSize.X * TileSize.Y);
+	ParallelFor(TileSize.Y, [&](const int32 Y)
+	{
+		FColor* Row = &OutPixels[Y * TileSize.X];
+		for (int32 X = 0; X < TileSize.X; ++X)
+		{
+			Row[X] = GetPatternColor(Context.TileToCanvas(TileRect, X, Y), CanvasSize);
+		}
+	});
+	return true;
+}
+
+FColor FMinimapSyntheticTileSource::GetPatternColor(const FIntPoint& CanvasPixel, const FIntPoint& CanvasSize)
+{
+	if (CanvasPixel.X % 256 == 0 || CanvasPixel.Y % 256 == 0)
+	{
+		return FColor::White;
+	}
+
+	const bool bChecker = ((CanvasPixel.X / 64) + (CanvasPixel.Y / 64)) % 2 == 0;
+	return FColor(static_cast<uint8>(FMath::Clamp(CanvasPixel.X * 255 / FMath::Max(1, CanvasSize.X - 1), 0, 255)),
+	              static_cast<uint8>(FMath::Clamp(CanvasPixel.Y * 255 / FMath::Max(1, CanvasSize.Y - 1), 0, 255)),
+	              bChecker ? 160 : 64, 255);
+}
+
+// ===================================================================
+// CPU RASTER
+// ===================================================================
+
+bool FMinimapCpuRasterTileSource::Begin(const FMinimapTileSourceContext& InContext, FString& OutError)
+{
+	Context = InContext;
+	if (!Context.Settings.bIsOrthographic)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("The CPU rasterizer always draws a top-down orthographic view; the perspective camera is ignored."));
+	}
+
+	BackgroundColor = Context.Settings.BackgroundMode == EMinimapBackgroundMode::Transparent
+		                  ? FColor::Transparent
+		                  : Context.Settings.BackgroundColor.ToFColor(true);
+
+	MINIMAP_STAGE_SCOPE(STAT_MinimapFilterBuild);
+	PrimitiveBounds.Build(Context.VisibleActors, Context.Layout, FVector2D(Context.Settings.CaptureBounds.Min), Context.WorldUnitsPerPixel);
+	return true;
+}
+
+void FMinimapCpuRasterTileSource::End()
+{
+	PrimitiveBounds.Reset();
+	Context.VisibleActors.Empty();
+}
+
+bool FMinimapCpuRasterTileSource::RequestTile(int32 TileIndex, double& OutReadDelaySeconds, FString& OutError)
+{
+	OutReadDelaySeconds = 0.0;
+	return true;
+}
+
+bool FMinimapCpuRasterTileSource::ReadTile(const int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError)
+{
+	const FIntRect TileRect = Context.GetTileRect(TileIndex);
+	const FIntPoint TileSize = Context.GetTileSize(TileIndex);
+	OutPixels.Init(BackgroundColor, TileSize.X * TileSize.Y);
+
+	struct FFootprint
+	{
+		FIntRect CanvasRect;
+		double Top = 0.0;
+		FColor Color;
+	};
+
+	const FVector2D WorldOrigin(Context.Settings.CaptureBounds.Min);
+	const double WorldUnitsPerPixel = Context.WorldUnitsPerPixel;
+	const double MinZ = Context.Settings.CaptureBounds.Min.Z;
+	const double MaxZ = Context.Settings.CaptureBounds.Max.Z;
+
+	TArray<FFootprint> Footprints;
+	for (const TWeakObjectPtr<UPrimitiveComponent>& WeakPrimitive : PrimitiveBounds.GetTilePrimitives(TileIndex))
+	{
+		const UPrimitiveComponent* Primitive = WeakPrimitive.Get();
+		if (!Primitive)
+		{
+			continue;
+		}
+
+		const FBox WorldBox = Primitive->Bounds.GetBox();
+		FIntRect CanvasRect(
+			FMath::FloorToInt32(FMath::Clamp((WorldBox.Min.X - WorldOrigin.X) / WorldUnitsPerPixel, -1.0e9, 1.0e9)),
+			FMath::FloorToInt32(FMath::Clamp((WorldBox.Min.Y - WorldOrigin.Y) / WorldUnitsPerPixel, -1.0e9, 1.0e9)),
+			FMath::CeilToInt32(FMath::Clamp((WorldBox.Max.X - WorldOrigin.X) / WorldUnitsPerPixel, -1.0e9, 1.0e9)),
+			FMath::CeilToInt32(FMath::Clamp((WorldBox.Max.Y - WorldOrigin.Y) / WorldUnitsPerPixel, -1.0e9, 1.0e9)));
+		CanvasRect.Clip(TileRect);
+		if (CanvasRect.IsEmpty())
+		{
+			continue;
+		}
+
+		// Same hue for every actor of a class; brighter the higher it reaches inside the capture bounds.
+		const UClass* ColorClass = Primitive->GetOwner() ? Primitive->GetOwner()->GetClass() : Primitive->GetClass();
+		const uint8 Hue = static_cast<uint8>(GetTypeHash(ColorClass->GetFName()) & 0xFF);
+		const float Height = MaxZ > MinZ ? static_cast<float>(FMath::Clamp((WorldBox.Max.Z - MinZ) / (MaxZ - MinZ), 0.0, 1.0)) : 1.0f;
+		const uint8 Value = static_cast<uint8>(80 + FMath::RoundToInt32(Height * 175.0f));
+		Footprints.Add({CanvasRect, WorldBox.Max.Z, FLinearColor::MakeFromHSV8(Hue, 160, Value).ToFColor(true)});
+	}
+
+	// Lowest first, so whatever is on top in a top-down view is drawn last.
+	Footprints.Sort([](const FFootprint& A, const FFootprint& B) { return A.Top < B.Top; });
+
+	const bool bIsPortrait = Context.IsPortrait();
+	for (const FFootprint& Footprint : Footprints)
+	{
+		for (int32 CanvasY = Footprint.CanvasRect.Min.Y; CanvasY < Footprint.CanvasRect.Max.Y; ++CanvasY)
+		{
+			for (int32 CanvasX = Footprint.CanvasRect.Min.X; CanvasX < Footprint.CanvasRect.Max.X; ++CanvasX)
+			{
+				// Inverse of FMinimapTileSourceContext::TileToCanvas.
+				const int32 LocalX = CanvasX - TileRect.Min.X;
+				const int32 LocalY = CanvasY - TileRect.Min.Y;
+				const int32 PixelIndex = bIsPortrait
+					                         ? (TileRect.Width() - 1 - LocalX) * TileSize.X + LocalY
+					                         : LocalY * TileSize.X + LocalX;
+				OutPixels[PixelIndex] = Footprint.Color;
+			}
+		}
+	}
+	return true;
+}
+
+// ===================================================================
+// CHAIN
+// ===================================================================
+
+FString FMinimapTileSourceChain::GetName() const
+{
+	return FString::JoinBy(Sources, TEXT("+"), [](const TSharedRef<IMinimapTileSource>& Source) { return Source->GetName(); });
+}
+
+bool FMinimapTileSourceChain::ReadsWorld() const
+{
+	return Sources.ContainsByPredicate([](const TSharedRef<IMinimapTileSource>& Source) { return Source->ReadsWorld(); });
+}
+
+bool FMinimapTileSourceChain::NeedsVisibleActors() const
+{
+	return Sources.ContainsByPredicate([](const TSharedRef<IMinimapTileSource>& Source) { return Source->NeedsVisibleActors(); });
+}
+
+bool FMinimapTileSourceChain::Begin(const FMinimapTileSourceContext& InContext, FString& OutError)
+{
+	for (const TSharedRef<IMinimapTileSource>& Source : Sources)
+	{
+		if (!Source->Begin(InContext, OutError))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FMinimapTileSourceChain::End()
+{
+	for (const TSharedRef<IMinimapTileSource>& Source : Sources)
+	{
+		Source->End();
+	}
+	ActiveSource = nullptr;
+}
+
+IMinimapTileSource* FMinimapTileSourceChain::FindSource(const int32 TileIndex) const
+{
+	for (const TSharedRef<IMinimapTileSource>& Source : Sources)
+	{
+		if (Source->CanProvideTile(TileIndex))
+		{
+			return &Source.Get();
+		}
+	}
+	return nullptr;
+}
+
+bool FMinimapTileSourceChain::CanProvideTile(const int32 TileIndex) const
+{
+	return FindSource(TileIndex) != nullptr;
+}
+
+bool FMinimapTileSourceChain::IsNewTile(const int32 TileIndex) const
+{
+	const IMinimapTileSource* Source = FindSource(TileIndex);
+	return Source && Source->IsNewTile(TileIndex);
+}
+
+void FMinimapTileSourceChain::PrepareTile(const int32 TileIndex)
+{
+	if (IMinimapTileSource* Source = FindSource(TileIndex))
+	{
+		Source->PrepareTile(TileIndex);
+	}
+}
+
+bool FMinimapTileSourceChain::IsTileReady(const int32 TileIndex) const
+{
+	const IMinimapTileSource* Source = FindSource(TileIndex);
+	return !Source || Source->IsTileReady(TileIndex);
+}
+
+bool FMinimapTileSourceChain::RequestTile(const int32 TileIndex, double& OutReadDelaySeconds, FString& OutError)
+{
+	ActiveSource = FindSource(TileIndex);
+	if (!ActiveSource)
+	{
+		OutError = FString::Printf(TEXT("No tile source can provide tile %d."), TileIndex);
+		return false;
+	}
+	return ActiveSource->RequestTile(TileIndex, OutReadDelaySeconds, OutError);
+}
+
+bool FMinimapTileSourceChain::ReadTile(const int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError)
+{
+	if (!ActiveSource)
+	{
+		OutError = FString::Printf(TEXT("Tile %d was read before it was requested."), TileIndex);
+		return false;
+	}
+	return ActiveSource->ReadTile(TileIndex, OutPixels, OutError);
+}
+
+bool FMinimapTileSourceChain::ReadTileBuffer(const int32 TileIndex, const EMinimapCaptureBuffer Buffer, TArray<FColor>& OutPixels)
+{
+	return ActiveSource && ActiveSource->ReadTileBuffer(TileIndex, Buffer, OutPixels);
+}
+
+bool FMinimapTileSourceChain::ReadTileFloor(const int32 TileIndex, const int32 FloorIndex, TArray<FColor>& OutPixels)
+{
+	return ActiveSource && ActiveSource->ReadTileFloor(TileIndex, FloorIndex, OutPixels);
+}
+
+bool FMinimapTileSourceChain::NeedsMoreFrames(const int32 TileIndex, double& OutReadDelaySeconds)
+{
+	return ActiveSource && ActiveSource->NeedsMoreFrames(TileIndex, OutReadDelaySeconds);
+}
+
+double FMinimapTileSourceChain::GetLastGpuSeconds() const
+{
+	return ActiveSource ? ActiveSource->GetLastGpuSeconds() : -1.0;
+}
+
+int32 FMinimapTileSourceChain::GetLastFrameCount() const
+{
+	return ActiveSource ? ActiveSource->GetLastFrameCount() : 1;
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinimapCaptureShards.h"
+#include "MinimapPrimitiveBoundsIndex.h"
+#include "MinimapTileResidency.h"
+#include "MinimapTileSource.h"
+
+class UMinimapGeneratorManager;
+class USceneCaptureComponent2D;
+
+/** "<BaseFileName>_Tile_X_Y.png": the name debug tiles are saved under and the saved-tiles source reads. */
+FString GetSavedTileFileName(const FString& BaseFileName, const FIntPoint& TileCoord);
+
+/** Renders each tile with the manager's ASceneCapture2D and reads it back from a pooled render target. */
+class FMinimapSceneCaptureTileSource : public IMinimapTileSource
+{
+public:
+	explicit FMinimapSceneCaptureTileSource(UMinimapGeneratorManager& InManager) : Manager(InManager) {}
+
+	virtual FString GetName() const override { return TEXT("SceneCapture"); }
+	virtual bool ReadsWorld() const override { return true; }
+	virtual bool Begin(const FMinimapTileSourceContext& InContext, FString& OutError) override;
+	virtual void End() override;
+	virtual void PrepareTile(int32 TileIndex) override;
+	virtual bool IsTileReady(int32 TileIndex) const override;
+	virtual bool RequestTile(int32 TileIndex, double& OutReadDelaySeconds, FString& OutError) override;
+	virtual bool NeedsMoreFrames(int32 TileIndex, double& OutReadDelaySeconds) override;
+	virtual bool ReadTile(int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError) override;
+	virtual bool ReadTileBuffer(int32 TileIndex, EMinimapCaptureBuffer Buffer, TArray<FColor>& OutPixels) override;
+	virtual bool ReadTileFloor(int32 TileIndex, int32 FloorIndex, TArray<FColor>& OutPixels) override;
+	virtual double GetLastGpuSeconds() const override;
+	virtual int32 GetLastFrameCount() const override { return TileFrames; }
+
+private:
+	/** Queues one frame of the current tile, timed with the manager's GPU timer. */
+	void CaptureFrame(USceneCaptureComponent2D& CaptureComponent);
+	/** Waits for the last queued frame and reads it back; adds its GPU time to the tile's. */
+	void ReadFrame(TArray<FColor>& OutPixels);
+
+	UMinimapGeneratorManager& Manager;
+	FMinimapTileSourceContext Context;
+
+	/** Mips of each tile's footprint, forced resident a tile ahead; only built for orthographic captures. */
+	FMinimapTileResidency Residency;
+	bool bPrestreaming = false;
+
+	/** For each floor, the visible primitives whose bounds overlap its Z range. */
+	TArray<TArray<TWeakObjectPtr<UPrimitiveComponent>>> FloorPrimitives;
+
+	// Persistent view state: every frame of a tile is compared with the previous one until they converge.
+	int32 TileFrames = 0;
+	double TileGpuSeconds = -1.0;
+	TArray<FColor> PreviousFrame;
+	/** The converged frame, handed out by ReadTile. */
+	TArray<FColor> SettledFrame;
+};
+
+/** Reads the tiles an earlier capture saved with "Save Tiles" from a folder, so they can be stitched again without rendering. */
+class FMinimapSavedTilesTileSource : public IMinimapTileSource
+{
+public:
+	/** Reads from InDirectory, or from the settings' tile source directory (or output path) when it is empty. */
+	explicit FMinimapSavedTilesTileSource(FString InDirectory = FString()) : Directory(MoveTemp(InDirectory)) {}
+
+	virtual FString GetName() const override { return TEXT("SavedTiles"); }
+	virtual bool ReadsWorld() const override { return false; }
+	virtual bool Begin(const FMinimapTileSourceContext& InContext, FString& OutError) override;
+	virtual bool CanProvideTile(int32 TileIndex) const override;
+	virtual bool IsNewTile(int32 TileIndex) const override { return false; }
+	virtual bool RequestTile(int32 TileIndex, double& OutReadDelaySeconds, FString& OutError) override;
+	/** Only reads and decodes the tile's file, so several tiles can be read at once from worker threads. */
+	virtual bool ReadTile(int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError) override;
+
+protected:
+	FString GetTilePath(int32 TileIndex) const;
+	/** Decodes a saved tile; leaves OutPixels empty when the file is not a PNG of the tile's size. */
+	void DecodeTile(int32 TileIndex, const FString& TilePath, const TArray<uint8>& PngData, TArray<FColor>& OutPixels) const;
+
+	FMinimapTileSourceContext Context;
+	FString Directory;
+	TBitArray<> AvailableTiles;
+};
+
+/**
+ * Reads the tiles the worker processes of a sharded capture wrote to the shared folder. Only tiles listed in a
+ * worker's index are available, and each is checked against the size and CRC recorded there before it is decoded.
+ */
+class FMinimapShardTilesTileSource : public FMinimapSavedTilesTileSource
+{
+public:
+	FMinimapShardTilesTileSource(FString InDirectory, const int32 InNumShards)
+		: FMinimapSavedTilesTileSource(MoveTemp(InDirectory)), NumShards(InNumShards) {}
+
+	virtual FString GetName() const override { return TEXT("ShardTiles"); }
+	virtual bool Begin(const FMinimapTileSourceContext& InContext, FString& OutError) override;
+	virtual bool ReadTile(int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError) override;
+
+private:
+	int32 NumShards = 0;
+	/** Index records of the available tiles, by tile index. */
+	TMap<int32, FMinimapShardTileRecord> Records;
+};
+
+/**
+ * Generates a deterministic pattern that is a function of the canvas pixel only: gradients, a 256 px grid and a
+ * 64 px checker. Overlapping tiles agree exactly, so a correct stitch matches the pattern and any seam, offset or
+ * rotation mistake shows up as a broken line. Needs neither a level nor a GPU.
+ */
+class FMinimapSyntheticTileSource : public IMinimapTileSource
+{
+public:
+	virtual FString GetName() const override { return TEXT("Synthetic"); }
+	virtual bool ReadsWorld() const override { return false; }
+	virtual bool Begin(const FMinimapTileSourceContext& InContext, FString& OutError) override;
+	virtual bool RequestTile(int32 TileIndex, double& OutReadDelaySeconds, FString& OutError) override;
+	virtual bool ReadTile(int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError) override;
+
+	/** Color of the pattern at a canvas pixel. */
+	static FColor GetPatternColor(const FIntPoint& CanvasPixel, const FIntPoint& CanvasSize);
+
+private:
+	FMinimapTileSourceContext Context;
+};
+
+/**
+ * Draws the top-down footprint of every visible primitive's bounds on the CPU, lowest first, colored by actor class
+ * and shaded by height. A quick blockout map of the level that needs no GPU and no render thread.
+ */
+class FMinimapCpuRasterTileSource : public IMinimapTileSource
+{
+public:
+	virtual FString GetName() const override { return TEXT("CpuRaster"); }
+	virtual bool ReadsWorld() const override { return true; }
+	virtual bool NeedsVisibleActors() const override { return true; }
+	virtual bool Begin(const FMinimapTileSourceContext& InContext, FString& OutError) override;
+	virtual void End() override;
+	virtual bool RequestTile(int32 TileIndex, double& OutReadDelaySeconds, FString& OutError) override;
+	virtual bool ReadTile(int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError) override;
+
+private:
+	FMinimapTileSourceContext Context;
+	FMinimapPrimitiveBoundsIndex PrimitiveBounds;
+	FColor BackgroundColor;
+};
+
+/** Takes each tile from the first source that can provide it, e.g. saved tiles first and the scene capture for the rest. */
+class FMinimapTileSourceChain : public IMinimapTileSource
+{
+public:
+	explicit FMinimapTileSourceChain(TArray<TSharedRef<IMinimapTileSource>> InSources) : Sources(MoveTemp(InSources)) {}
+
+	virtual FString GetName() const override;
+	virtual bool ReadsWorld() const override;
+	virtual bool NeedsVisibleActors() const override;
+	virtual bool Begin(const FMinimapTileSourceContext& InContext, FString& OutError) override;
+	virtual void End() override;
+	virtual bool CanProvideTile(int32 TileIndex) const override;
+	virtual bool IsNewTile(int32 TileIndex) const override;
+	virtual void PrepareTile(int32 TileIndex) override;
+	virtual bool IsTileReady(int32 TileIndex) const override;
+	virtual bool RequestTile(int32 TileIndex, double& OutReadDelaySeconds, FString& OutError) override;
+	virtual bool NeedsMoreFrames(int32 TileIndex, double& OutReadDelaySeconds) override;
+	virtual bool ReadTile(int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError) override;
+	virtual bool ReadTileBuffer(int32 TileIndex, EMinimapCaptureBuffer Buffer, TArray<FColor>& OutPixels) override;
+	virtual bool ReadTileFloor(int32 TileIndex, int32 FloorIndex, TArray<FColor>& OutPixels) override;
+	virtual double GetLastGpuSeconds() const override;
+	virtual int32 GetLastFrameCount() const override;
+
+private:
+	IMinimapTileSource* FindSource(int32 TileIndex) const;
+
+	TArray<TSharedRef<IMinimapTileSource>> Sources;
+	/** Source of the tile between RequestTile and ReadTile. */
+	IMinimapTileSource* ActiveSource = nullptr;
+};
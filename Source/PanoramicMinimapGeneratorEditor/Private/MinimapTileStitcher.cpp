@@ -0,0 +1,73 @@
+#include "MinimapTileStitcher.h"
+
+#include "MinimapGeneratorManager.h"
+#include "MinimapGeneratorStats.h"
+#include "MinimapImageKernels.h"
+#include "PanoramicMinimapGeneratorEditor.h"
+
+FMinimapTileStitcher::FMinimapTileStitcher(const FMinimapCaptureSettings& Settings, const FMinimapTileLayout& InLayout, const int32 InFeatherWidth)
+	: FMinimapTileStitcher(Settings, InLayout, FIntRect(0, 0, Settings.OutputWidth, Settings.OutputHeight), InFeatherWidth)
+{
+}
+
+FMinimapTileStitcher::FMinimapTileStitcher(const FMinimapCaptureSettings& Settings, const FMinimapTileLayout& InLayout, const FIntRect& InCanvasRect,
+                                           const int32 InFeatherWidth)
+	: Layout(InLayout)
+	, CanvasOrigin(InCanvasRect.Min)
+	, CanvasSize(InCanvasRect.Size())
+	, bIsPortrait(Settings.OutputHeight > Settings.OutputWidth)
+	, FeatherWidth(InFeatherWidth == INDEX_NONE ? InLayout.Overlap : FMath::Clamp(InFeatherWidth, 0, InLayout.Overlap))
+{
+	{
+		LLM_SCOPE_BYTAG(MinimapGenerator_StitchCanvas);
+		Canvas.AddUninitialized(CanvasSize.X * CanvasSize.Y);
+		CanvasBytes = FMinimapTrackedBytes(EMinimapMemoryTag::StitchCanvas, Canvas.GetAllocatedSize());
+	}
+
+	// Initialize final image with the configured background color for correct blending.
+	const FColor BackgroundColor = (Settings.BackgroundMode == EMinimapBackgroundMode::Transparent)
+		                               ? FColor::Transparent
+		                               : Settings.BackgroundColor.ToFColor(true);
+	MinimapImageKernels::Fill(Canvas, BackgroundColor);
+}
+
+bool FMinimapTileStitcher::OverlapsCanvas(const int32 TileIndex) const
+{
+	const FIntPoint TileCoord = Layout.GetTileCoord(TileIndex);
+	return Layout.GetTileRect(TileCoord.X, TileCoord.Y).Intersect(FIntRect(CanvasOrigin, CanvasOrigin + CanvasSize));
+}
+
+FIntPoint FMinimapTileStitcher::GetTileSize(const int32 TileIndex) const
+{
+	const FIntPoint TileCoord = Layout.GetTileCoord(TileIndex);
+	const FIntRect TileRect = Layout.GetTileRect(TileCoord.X, TileCoord.Y);
+	return bIsPortrait ? FIntPoint(TileRect.Height(), TileRect.Width()) : TileRect.Size();
+}
+
+bool FMinimapTileStitcher::AddTile(const int32 TileIndex, TConstArrayView<FColor> Pixels, const FIntPoint& Size)
+{
+	const FIntPoint TileCoord = Layout.GetTileCoord(TileIndex);
+	const FIntPoint SrcSize = GetTileSize(TileIndex);
+	if (Size != SrcSize || Pixels.Num() != SrcSize.X * SrcSize.Y)
+	{
+		UE_LOG(OBPanoramicMinimapGenerator, Warning, TEXT("Tile (%d, %d) has %d pixels, expected %dx%d. Skipping."),
+			TileCoord.X, TileCoord.Y, Pixels.Num(), SrcSize.X, SrcSize.Y);
+		return false;
+	}
+
+	// Portrait tiles are captured rotated by 90 degrees; overlaps with the tiles to the left and above are feathered.
+	MinimapImageKernels::FTilePlacement Placement;
+	Placement.Offset = Layout.GetTileRect(TileCoord.X, TileCoord.Y).Min - CanvasOrigin;
+	Placement.Overlap = FeatherWidth;
+	Placement.bFeatherLeft = TileCoord.X > 0;
+	Placement.bFeatherTop = TileCoord.Y > 0;
+	Placement.bRotateClockwise = bIsPortrait;
+	MinimapImageKernels::CompositeTile(Canvas, CanvasSize, Pixels, SrcSize, Placement);
+	return true;
+}
+
+TArray<FColor> FMinimapTileStitcher::ReleaseCanvas(FMinimapTrackedBytes& OutCanvasBytes)
+{
+	OutCanvasBytes = MoveTemp(CanvasBytes);
+	return MoveTemp(Canvas);
+}
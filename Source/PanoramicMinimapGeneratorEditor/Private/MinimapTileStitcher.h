@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinimapMemoryTracking.h"
+#include "MinimapTileLayout.h"
+
+struct FMinimapCaptureSettings;
+
+/**
+ * Composites the tiles of a layout into the full-resolution canvas with the parallel CPU kernels.
+ * Shared by the tiled capture and the capture commandlet, so both stitch exactly the same way.
+ */
+class FMinimapTileStitcher
+{
+public:
+	/**
+	 * Allocates the canvas and clears it to the background color. FeatherWidth is the blended band along shared tile
+	 * edges; INDEX_NONE uses the whole layout overlap, smaller values blend over a narrower band.
+	 */
+	FMinimapTileStitcher(const FMinimapCaptureSettings& Settings, const FMinimapTileLayout& InLayout, int32 InFeatherWidth = INDEX_NONE);
+
+	/**
+	 * Stitches only CanvasRect of the output, e.g. one UDIM page, from the tiles that overlap it. The result matches
+	 * the same pixels of the full canvas; anything outside the output stays the background color.
+	 */
+	FMinimapTileStitcher(const FMinimapCaptureSettings& Settings, const FMinimapTileLayout& InLayout, const FIntRect& InCanvasRect,
+	                     int32 InFeatherWidth = INDEX_NONE);
+
+	/**
+	 * Composites one tile. Tiles must be added in row-major order so overlaps blend left-to-right and top-to-bottom.
+	 * Returns false (and leaves the canvas untouched) when the tile is not the size the layout expects.
+	 */
+	bool AddTile(int32 TileIndex, TConstArrayView<FColor> Pixels, const FIntPoint& Size);
+
+	/** Whether the tile covers any pixel of the canvas; tiles that do not can be skipped without reading them. */
+	bool OverlapsCanvas(int32 TileIndex) const;
+
+	/** Size of a tile's pixels in capture orientation; portrait tiles are captured rotated by 90 degrees. */
+	FIntPoint GetTileSize(int32 TileIndex) const;
+
+	const FIntPoint& GetCanvasSize() const { return CanvasSize; }
+
+	/** Hands the canvas over, e.g. to the encoder, together with its memory tracking. */
+	TArray<FColor> ReleaseCanvas(FMinimapTrackedBytes& OutCanvasBytes);
+
+private:
+	FMinimapTileLayout Layout;
+	/** Output pixel of the canvas' top-left corner. */
+	FIntPoint CanvasOrigin = FIntPoint::ZeroValue;
+	FIntPoint CanvasSize;
+	bool bIsPortrait = false;
+	int32 FeatherWidth = 0;
+
+	TArray<FColor> Canvas;
+	FMinimapTrackedBytes CanvasBytes;
+};
@@ -0,0 +1,211 @@
+#include "MinimapTileStore.h"
+#include "MinimapGeneratorStats.h"
+#include "MinimapMemoryTracking.h"
+
+#include "Hash/CityHash.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopeLock.h"
+
+FMinimapTileStore::FMinimapTileStore(const bool bInCompressTiles)
+	: bCompressTiles(bInCompressTiles)
+{
+}
+
+FMinimapTileStore::~FMinimapTileStore()
+{
+	// Workers hold a pointer to this store; never let them outlive it.
+	WaitForPendingTiles();
+}
+
+void FMinimapTileStore::Reset(const int32 NumTiles)
+{
+	Empty();
+	Tiles.SetNum(NumTiles);
+}
+
+void FMinimapTileStore::Empty()
+{
+	WaitForPendingTiles();
+
+	FScopeLock Lock(&StoreLock);
+	DEC_MEMORY_STAT_BY(STAT_MinimapTileStoreMemory, StoredBytes);
+	MinimapMemory::Remove(EMinimapMemoryTag::CapturedTileData, StoredBytes);
+	Tiles.Empty();
+	Blobs.Empty();
+	BlobsByHash.Empty();
+	StoredBytes = 0;
+	RawBytes = 0;
+}
+
+void FMinimapTileStore::AddTile(const int32 TileIndex, const FIntPoint& Size, TArray<FColor>&& Pixels)
+{
+	check(IsInGameThread());
+	if (!Tiles.IsValidIndex(TileIndex) || Pixels.Num() != Size.X * Size.Y)
+	{
+		return;
+	}
+
+	FMinimapTrackedBytes RawTileBytes(EMinimapMemoryTag::CapturedTileData, Pixels.GetAllocatedSize());
+	PendingTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[this, TileIndex, Size, TilePixels = MoveTemp(Pixels), RawTileBytes = MoveTemp(RawTileBytes)]() mutable
+	{
+		LLM_SCOPE_BYTAG(MinimapGenerator_CapturedTileData);
+		MINIMAP_STAGE_SCOPE(STAT_MinimapTileCompression);
+		FTileBlob Blob = EncodeTile(TilePixels);
+		// Free the raw pixels before taking the lock; this is where the memory saving comes from.
+		TilePixels.Empty();
+		RawTileBytes.Reset();
+		StoreBlob(TileIndex, Size, MoveTemp(Blob));
+	}));
+}
+
+void FMinimapTileStore::WaitForPendingTiles()
+{
+	if (PendingTasks.Num() > 0)
+	{
+		UE::Tasks::Wait(PendingTasks);
+		PendingTasks.Empty();
+	}
+}
+
+FMinimapTileStore::FTileBlob FMinimapTileStore::EncodeTile(const TArray<FColor>& Pixels) const
+{
+	FTileBlob Blob;
+	Blob.RawNumBytes = Pixels.Num() * sizeof(FColor);
+
+	// Sea, sky and background tiles are a single color: store just that color.
+	const FColor FirstColor = Pixels.Num() > 0 ? Pixels[0] : FColor::Transparent;
+	bool bIsUniform = true;
+	for (const FColor& Pixel : Pixels)
+	{
+		if (Pixel != FirstColor)
+		{
+			bIsUniform = false;
+			break;
+		}
+	}
+
+	if (bIsUniform)
+	{
+		Blob.bIsUniform = true;
+		Blob.UniformColor = FirstColor;
+		Blob.Hash = HashCombineFast(static_cast<uint64>(FirstColor.DWColor()), static_cast<uint64>(Blob.RawNumBytes));
+		return Blob;
+	}
+
+	Blob.Hash = CityHash64(reinterpret_cast<const char*>(Pixels.GetData()), Blob.RawNumBytes);
+
+	if (bCompressTiles)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_LZ4, Blob.RawNumBytes);
+		Blob.Payload.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(NAME_LZ4, Blob.Payload.GetData(), CompressedSize, Pixels.GetData(), Blob.RawNumBytes))
+		{
+			Blob.Payload.SetNum(CompressedSize, EAllowShrinking::Yes);
+			Blob.bIsCompressed = true;
+			return Blob;
+		}
+	}
+
+	Blob.Payload.SetNumUninitialized(Blob.RawNumBytes);
+	FMemory::Memcpy(Blob.Payload.GetData(), Pixels.GetData(), Blob.RawNumBytes);
+	return Blob;
+}
+
+void FMinimapTileStore::StoreBlob(const int32 TileIndex, const FIntPoint& Size, FTileBlob&& Blob)
+{
+	FScopeLock Lock(&StoreLock);
+	if (!Tiles.IsValidIndex(TileIndex))
+	{
+		return;
+	}
+
+	RawBytes += Blob.RawNumBytes;
+
+	// Identical tiles hash identically and LZ4 is deterministic, so equal payloads mean equal pixels.
+	TArray<int32, TInlineAllocator<4>> Candidates;
+	BlobsByHash.MultiFind(Blob.Hash, Candidates);
+	for (const int32 CandidateIndex : Candidates)
+	{
+		const FTileBlob& Candidate = Blobs[CandidateIndex];
+		if (Candidate.RawNumBytes == Blob.RawNumBytes && Candidate.bIsUniform == Blob.bIsUniform &&
+			Candidate.UniformColor == Blob.UniformColor && Candidate.Payload == Blob.Payload)
+		{
+			Tiles[TileIndex] = {CandidateIndex, Size};
+			return;
+		}
+	}
+
+	StoredBytes += Blob.Payload.Num();
+	INC_MEMORY_STAT_BY(STAT_MinimapTileStoreMemory, Blob.Payload.Num());
+	MinimapMemory::Add(EMinimapMemoryTag::CapturedTileData, Blob.Payload.Num());
+	const int32 BlobIndex = Blobs.Add(MoveTemp(Blob));
+	BlobsByHash.Add(Blobs[BlobIndex].Hash, BlobIndex);
+	Tiles[TileIndex] = {BlobIndex, Size};
+}
+
+bool FMinimapTileStore::HasTile(const int32 TileIndex) const
+{
+	FScopeLock Lock(&StoreLock);
+	return Tiles.IsValidIndex(TileIndex) && Tiles[TileIndex].BlobIndex != INDEX_NONE;
+}
+
+int32 FMinimapTileStore::GetNumStoredTiles() const
+{
+	FScopeLock Lock(&StoreLock);
+	int32 NumStored = 0;
+	for (const FTileEntry& Entry : Tiles)
+	{
+		NumStored += Entry.BlobIndex != INDEX_NONE ? 1 : 0;
+	}
+	return NumStored;
+}
+
+bool FMinimapTileStore::GetTile(const int32 TileIndex, TArray<FColor>& OutPixels, FIntPoint& OutSize) const
+{
+	FScopeLock Lock(&StoreLock);
+	if (!Tiles.IsValidIndex(TileIndex) || Tiles[TileIndex].BlobIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FTileEntry& Entry = Tiles[TileIndex];
+	const FTileBlob& Blob = Blobs[Entry.BlobIndex];
+	OutSize = Entry.Size;
+	OutPixels.SetNumUninitialized(Blob.RawNumBytes / sizeof(FColor), EAllowShrinking::No);
+
+	if (Blob.bIsUniform)
+	{
+		for (FColor& Pixel : OutPixels)
+		{
+			Pixel = Blob.UniformColor;
+		}
+		return true;
+	}
+
+	if (Blob.bIsCompressed)
+	{
+		return FCompression::UncompressMemory(NAME_LZ4, OutPixels.GetData(), Blob.RawNumBytes, Blob.Payload.GetData(), Blob.Payload.Num());
+	}
+
+	FMemory::Memcpy(OutPixels.GetData(), Blob.Payload.GetData(), Blob.RawNumBytes);
+	return true;
+}
+
+int64 FMinimapTileStore::GetStoredBytes() const
+{
+	FScopeLock Lock(&StoreLock);
+	return StoredBytes;
+}
+
+int64 FMinimapTileStore::GetRawBytes() const
+{
+	FScopeLock Lock(&StoreLock);
+	return RawBytes;
+}
+
+int32 FMinimapTileStore::GetNumUniqueTiles() const
+{
+	FScopeLock Lock(&StoreLock);
+	return Blobs.Num();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+/**
+ * In-memory storage for captured tiles, indexed densely by tile index.
+ * Tiles are compressed on a worker thread (LZ4), identical tiles are stored once (keyed by content hash),
+ * uniform tiles are stored as a single color, and pixels are only decompressed when the stitcher asks for them.
+ */
+class FMinimapTileStore
+{
+public:
+	explicit FMinimapTileStore(bool bInCompressTiles = true);
+	~FMinimapTileStore();
+
+	/** Discards all tiles and prepares NumTiles empty slots. */
+	void Reset(int32 NumTiles);
+	void Empty();
+
+	/** Takes ownership of the tile pixels and compresses/deduplicates them on a worker thread. */
+	void AddTile(int32 TileIndex, const FIntPoint& Size, TArray<FColor>&& Pixels);
+
+	/** Blocks until every queued tile has been compressed and stored. */
+	void WaitForPendingTiles();
+
+	bool HasTile(int32 TileIndex) const;
+	int32 GetNumStoredTiles() const;
+
+	/** Decompresses a tile into OutPixels (reusing its allocation). Returns false if the tile was never stored. */
+	bool GetTile(int32 TileIndex, TArray<FColor>& OutPixels, FIntPoint& OutSize) const;
+
+	/** Memory held by stored tile payloads. */
+	int64 GetStoredBytes() const;
+	/** Memory the same tiles would take as raw BGRA. */
+	int64 GetRawBytes() const;
+	int32 GetNumUniqueTiles() const;
+
+private:
+	struct FTileBlob
+	{
+		uint64 Hash = 0;
+		int32 RawNumBytes = 0;
+		bool bIsUniform = false;
+		bool bIsCompressed = false;
+		FColor UniformColor = FColor::Transparent;
+		TArray<uint8> Payload;
+	};
+
+	struct FTileEntry
+	{
+		int32 BlobIndex = INDEX_NONE;
+		FIntPoint Size = FIntPoint::ZeroValue;
+	};
+
+	/** Worker-side: compresses the pixels and returns the blob ready to be deduplicated. */
+	FTileBlob EncodeTile(const TArray<FColor>& Pixels) const;
+	/** Game-thread or worker-side: finds or inserts the blob under the lock and points the tile at it. */
+	void StoreBlob(int32 TileIndex, const FIntPoint& Size, FTileBlob&& Blob);
+
+	const bool bCompressTiles;
+
+	mutable FCriticalSection StoreLock;
+	TArray<FTileEntry> Tiles;
+	TArray<FTileBlob> Blobs;
+	TMultiMap<uint64, int32> BlobsByHash;
+	int64 StoredBytes = 0;
+	int64 RawBytes = 0;
+
+	TArray<UE::Tasks::FTask> PendingTasks;
+};
@@ -2,6 +2,7 @@
 #include "AssetTypeActions_MinimapDefinition.h"
 #include "PanoramicMinimapGeneratorCommands.h"
 #include "MinimapGeneratorWindow.h"
+#include "MinimapGeneratorStats.h"
 #include "MinimapDefinitionDataAsset.h"
 #include "AssetToolsModule.h"
 #include "Editor.h"
@@ -16,6 +17,26 @@ static const FName PanoramicMinimapGeneratorTabName("PanoramicMinimapGenerator")
 #define LOCTEXT_NAMESPACE "FPanoramicMinimapGeneratorEditorModule"
 
 DEFINE_LOG_CATEGORY(OBPanoramicMinimapGenerator);
+
+DEFINE_STAT(STAT_MinimapGridPlanning);
+DEFINE_STAT(STAT_MinimapFilterBuild);
+DEFINE_STAT(STAT_MinimapTileRender);
+DEFINE_STAT(STAT_MinimapReadback);
+DEFINE_STAT(STAT_MinimapTileCompression);
+DEFINE_STAT(STAT_MinimapComposite);
+DEFINE_STAT(STAT_MinimapEncode);
+DEFINE_STAT(STAT_MinimapDiskWrite);
+DEFINE_STAT(STAT_MinimapTextureImport);
+DEFINE_STAT(STAT_MinimapDataAssetExport);
+DEFINE_STAT(STAT_MinimapTileStoreMemory);
+
+LLM_DEFINE_TAG(MinimapGenerator);
+LLM_DEFINE_TAG(MinimapGenerator_CapturedTileData);
+LLM_DEFINE_TAG(MinimapGenerator_StagingPixelBuffer);
+LLM_DEFINE_TAG(MinimapGenerator_StitchCanvas);
+LLM_DEFINE_TAG(MinimapGenerator_ImageWrapperBuffers);
+LLM_DEFINE_TAG(MinimapGenerator_UncompressedBGRA);
+
 void FPanoramicMinimapGeneratorEditorModule::StartupModule()
 {
 	UE_LOG(OBPanoramicMinimapGenerator, Log, TEXT("PanoramicMinimapGeneratorEditor module startup."));
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "MinimapCaptureBuffers.generated.h"
+
+struct FMinimapCaptureSettings;
+
+/**
+ * Extra images a tiled capture renders at every tile position, right after the color tile and before the camera
+ * moves on, so they share its positioning and streaming. Each one is stitched into its own file next to the minimap.
+ */
+UENUM(BlueprintType)
+enum class EMinimapCaptureBuffer : uint8
+{
+	/** Unlit material base color, RGBA8. */
+	BaseColor UMETA(DisplayName = "Base Color"),
+	/** World height of the first surface below the camera, 16-bit grayscale over the capture bounds' Z range. */
+	Height UMETA(DisplayName = "World Height"),
+	/** World-space normal X and Y in the red and green channels, 8 bits each. */
+	Normal UMETA(DisplayName = "Normals"),
+	/** Scene depth from the camera, 16-bit grayscale from the camera down to the bottom of the capture bounds. */
+	Depth UMETA(DisplayName = "Scene Depth"),
+};
+
+namespace MinimapCaptureBuffers
+{
+	TConstArrayView<EMinimapCaptureBuffer> GetAll();
+
+	ESceneCaptureSource GetCaptureSource(EMinimapCaptureBuffer Buffer);
+	/** Float buffers render to a 32-bit float target and are read back as linear colors; the others as BGRA8. */
+	bool IsFloatBuffer(EMinimapCaptureBuffer Buffer);
+	/** 16-bit buffers are packed into the red (high byte) and green (low byte) channels until they are saved. */
+	bool Is16Bit(EMinimapCaptureBuffer Buffer);
+	/** "Height" in "<FileName>_Height.png". */
+	const TCHAR* GetFileSuffix(EMinimapCaptureBuffer Buffer);
+
+	/** Packs a float buffer's samples into tile pixels the tile store and stitcher can carry. */
+	void PackTile(EMinimapCaptureBuffer Buffer, const FMinimapCaptureSettings& Settings, TConstArrayView<FLinearColor> Samples, TArray<FColor>& OutPixels);
+
+	/** Encodes a stitched buffer as PNG: 16-bit grayscale for the 16-bit buffers, 8-bit RGBA otherwise. */
+	bool EncodePng(EMinimapCaptureBuffer Buffer, TConstArrayView<FColor> Canvas, const FIntPoint& Size, TArray64<uint8>& OutPng);
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinimapCaptureEstimate.generated.h"
+
+struct FMinimapCaptureSettings;
+
+namespace MinimapCapture
+{
+	/** Delay between queuing a tile render and reading it back; every rendered tile pays it once. */
+	constexpr float TileReadbackDelaySeconds = 0.2f;
+	/** Longest a tile waits for the mips requested for its footprint before it is captured anyway. */
+	constexpr float TileResidencyTimeoutSeconds = 10.0f;
+}
+
+/** Per-machine costs measured by a short calibration capture. Everything else in an estimate is derived from these. */
+USTRUCT(BlueprintType)
+struct FMinimapCaptureCalibration
+{
+	GENERATED_BODY()
+
+	/** Render target size used for the timed calibration capture. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	FIntPoint CalibrationSize = FIntPoint::ZeroValue;
+
+	/** Fixed cost of one capture + readback, independent of its size. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double CaptureFixedSeconds = 0.0;
+
+	/** Cost of one capture + readback per megapixel of render target. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double CaptureSecondsPerMegapixel = 0.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double PngEncodeMegapixelsPerSecond = 0.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double PngDecodeMegapixelsPerSecond = 0.0;
+
+	/** Size of the PNG the calibration image compressed to, per pixel. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double PngBytesPerPixel = 4.0;
+
+	/** Raw size / compressed size of the calibration image in the in-memory tile store. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double TileStoreCompressionRatio = 1.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double TileDecompressNanosecondsPerPixel = 0.0;
+
+	/** Stitch cost of a pixel outside the overlap, and of a feather-blended pixel inside it. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double CompositeNanosecondsPerPixel = 0.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double BlendNanosecondsPerPixel = 0.0;
+
+	/** Plain row copy, used by pixel-aligned stitching and to fill the background. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	double CopyNanosecondsPerPixel = 0.0;
+
+	/** Tiles the primitive bounds index proved empty; only skipped when Skip Empty Tiles is enabled. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Calibration")
+	int32 NumEmptyTiles = 0;
+
+	/** Times PNG encode/decode, tile-store compression and stitching on a captured image. */
+	void MeasureCpuCosts(const TArray<FColor>& Pixels, const FIntPoint& Size);
+};
+
+/** Predicted cost of a capture with a given set of settings, plus suggestions when it does not fit the budget. */
+USTRUCT(BlueprintType)
+struct PANORAMICMINIMAPGENERATOREDITOR_API FMinimapCaptureEstimate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate")
+	bool bIsValid = false;
+
+	/** Why the estimate could not be made, when bIsValid is false. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate")
+	FString Error;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate")
+	FString TileLayoutSummary;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate")
+	int32 NumTiles = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate")
+	int32 NumRenderedTiles = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Time")
+	double CaptureSeconds = 0.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Time")
+	double StitchSeconds = 0.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Time")
+	double EncodeSeconds = 0.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Time")
+	double ImportSeconds = 0.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Time")
+	double TotalSeconds = 0.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Memory")
+	int64 PeakRamBytes = 0;
+
+	/** Stage at which PeakRamBytes is reached. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Memory")
+	FString PeakRamStage;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Memory")
+	int64 PeakVramBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Memory")
+	int64 RamBudgetBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Memory")
+	int64 VramBudgetBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Disk")
+	int64 FinalImageBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Disk")
+	int64 DebugTileBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Disk")
+	int64 AssetBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate|Disk")
+	int64 TotalDiskBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate")
+	TArray<FString> Recommendations;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Estimate")
+	FMinimapCaptureCalibration Calibration;
+
+	bool FitsRamBudget() const { return RamBudgetBytes <= 0 || PeakRamBytes <= RamBudgetBytes; }
+	bool FitsVramBudget() const { return VramBudgetBytes <= 0 || PeakVramBytes <= VramBudgetBytes; }
+
+	/** Multi-line report used by the log and the editor window. */
+	FString ToString() const;
+
+	/**
+	 * Applies the capture pipeline's cost model to the settings. Pure: does not render anything.
+	 * Budgets of zero or less are treated as unlimited.
+	 */
+	static FMinimapCaptureEstimate Predict(const FMinimapCaptureSettings& InSettings, const FMinimapCaptureCalibration& InCalibration,
+	                                       int64 InRamBudgetBytes, int64 InVramBudgetBytes);
+
+	/** Re-predicts with tweaked settings and fills Recommendations with the changes that bring the capture within budget. */
+	void AddRecommendations(const FMinimapCaptureSettings& InSettings);
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinimapCaptureProfiles.generated.h"
+
+struct FEngineShowFlags;
+struct FPostProcessSettings;
+struct FMinimapCaptureSettings;
+
+/**
+ * Named sets of render features for the scene capture, cheapest first. Each one replaces the capture's show flags
+ * as a whole and adds matching post-process overrides, so a top-down map does not pay for what it cannot show.
+ */
+UENUM(BlueprintType)
+enum class EMinimapCaptureProfile : uint8
+{
+	/** The capture component's default show flags, Capture Dynamic Shadows and the quality overrides. */
+	Custom UMETA(DisplayName = "Custom"),
+	/** Unlit base colors with no shadows, fog, sky or effects: a flat, readable plan of the level. */
+	Schematic UMETA(DisplayName = "Schematic"),
+	/** Direct and sky lighting only; no shadows, AO, reflections, global illumination or translucency. */
+	Fast UMETA(DisplayName = "Fast"),
+	/** Lit and shadowed with screen-space AO, sky and translucency; no fog, clouds, particles or lens effects. */
+	Balanced UMETA(DisplayName = "Balanced"),
+	/** Every lighting feature, fog and atmosphere, at the quality override values. */
+	Cinematic UMETA(DisplayName = "Cinematic"),
+};
+
+/** GPU cost of one tile rendered with a profile, measured on this machine and level. */
+USTRUCT(BlueprintType)
+struct PANORAMICMINIMAPGENERATOREDITOR_API FMinimapCaptureProfileCost
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Profile")
+	EMinimapCaptureProfile Profile = EMinimapCaptureProfile::Custom;
+
+	/** GPU time of one tile's render, or a negative value when the RHI cannot time it. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Profile")
+	double GpuMillisecondsPerTile = -1.0;
+
+	/** Capture plus render-thread flush, as seen from the game thread. Always measured. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Profile")
+	double WallMillisecondsPerTile = 0.0;
+
+	/** Render target size the profile was timed at; the costs are scaled from it to a full tile. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Profile")
+	FIntPoint MeasuredSize = FIntPoint::ZeroValue;
+
+	/** "Fast: 3.2 ms GPU per tile", falling back to the wall time without GPU timestamps. */
+	FString ToString() const;
+};
+
+namespace MinimapCaptureProfiles
+{
+	/** The profiles in order of cost, Custom last. */
+	TConstArrayView<EMinimapCaptureProfile> GetAll();
+
+	/**
+	 * Replaces every show flag for the profile, starting from Defaults (the capture component's). Custom returns the
+	 * defaults with Dynamic Shadows as the settings ask. Pixel-aligned tiling turns temporal AA and motion blur off.
+	 */
+	FEngineShowFlags MakeShowFlags(const FMinimapCaptureSettings& Settings, const FEngineShowFlags& Defaults);
+
+	/** Writes the profile's overrides into a cleared FPostProcessSettings; Custom applies the quality overrides when enabled. */
+	void ApplyPostProcessOverrides(const FMinimapCaptureSettings& Settings, FPostProcessSettings& OutPostProcess);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "MinimapGeneratorManager.h"
+#include "MinimapCaptureQueueSubsystem.generated.h"
+
+/** One capture of a batch: its settings and, optionally, the level to open before capturing. */
+USTRUCT(BlueprintType)
+struct FMinimapCaptureJob
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap Capture Job")
+	FMinimapCaptureSettings Settings;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap Capture Job", meta = (
+	Tooltip = "Level to capture. Empty captures whatever level is open in the editor when the job starts."))
+	TSoftObjectPtr<UWorld> Level;
+};
+
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnMinimapQueueProgress, const FText& /*Status*/, float /*Percentage*/, int32 /*CompletedJobs*/,
+                                      int32 /*TotalJobs*/);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnMinimapQueueJobComplete, const FMinimapCaptureJob& /*Job*/, bool /*bSuccess*/,
+                                       const FString& /*FinalImagePath*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMinimapQueueComplete, int32 /*NumSucceeded*/, int32 /*NumFailed*/);
+
+/**
+ * Runs minimap captures back to back in one editor session, so only one capture uses the GPU at a time.
+ *
+ * Jobs are grouped by level and ordered so overlapping regions follow each other, which keeps the level loaded and
+ * the streamed-in textures warm between them. The capture actor and the render targets are reused from job to job,
+ * and job N's encode, write and import run while job N+1 renders.
+ */
+UCLASS()
+class PANORAMICMINIMAPGENERATOREDITOR_API UMinimapCaptureQueueSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Queues the jobs after the ones already queued and starts the queue if it is idle. */
+	void EnqueueJobs(const TArray<FMinimapCaptureJob>& InJobs);
+
+	/** Cancels the capture that is rendering and drops the queued jobs; jobs already encoding still finish. */
+	void CancelAll();
+
+	bool IsRunning() const { return bIsRunning; }
+
+	/** Status of the current job, and the progress of the whole queue weighted by output pixels. */
+	FOnMinimapQueueProgress OnProgress;
+	FOnMinimapQueueJobComplete OnJobComplete;
+	FOnMinimapQueueComplete OnQueueComplete;
+
+private:
+	/** Per-job bookkeeping, indexed like Jobs. */
+	struct FJobState
+	{
+		float Progress = 0.0f;
+		int64 NumPixels = 0;
+		bool bDone = false;
+	};
+
+	/** Groups jobs by level, keeping the order levels first appear in, and chains overlapping or nearby regions. */
+	static void SortJobs(TArray<FMinimapCaptureJob>& InOutJobs);
+
+	void ScheduleNextJob();
+	void StartNextJob();
+	bool IsJobLevelOpen(const FMinimapCaptureJob& Job) const;
+	bool OpenJobLevel(const FMinimapCaptureJob& Job, FString& OutError);
+
+	/** An idle manager holding the capture resources of the managers that have finished rendering. */
+	UMinimapGeneratorManager* AcquireManager();
+
+	void HandleJobProgress(const FText& Status, float Percentage, int32 CurrentTile, int32 TotalTiles, int32 JobIndex);
+	void HandleJobRenderComplete(int32 JobIndex, UMinimapGeneratorManager* Manager);
+	void HandleJobComplete(bool bSuccess, const FString& FinalImagePath, int32 JobIndex, UMinimapGeneratorManager* Manager);
+	void CompleteJob(int32 JobIndex, bool bSuccess, const FString& FinalImagePath);
+	void BroadcastProgress(const FText& Status);
+	void FinishQueue();
+
+	TArray<FMinimapCaptureJob> Jobs;
+	TArray<FJobState> JobStates;
+	int32 NextJobIndex = 0;
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+	bool bIsRunning = false;
+	double QueueStartSeconds = 0.0;
+
+	/** Every manager the queue created; at most one renders and one encodes and imports at a time. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UMinimapGeneratorManager>> Managers;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMinimapGeneratorManager> RenderingManager;
+
+	/** Managers whose capture has finished rendering and is being encoded, written and imported. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UMinimapGeneratorManager>> FinalizingManagers;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMinimapCaptureSettings;
+
+/** Stage names used as keys in the capture report and its JSON output. */
+namespace MinimapCaptureStage
+{
+	inline const TCHAR* GridPlanning = TEXT("GridPlanning");
+	inline const TCHAR* WorldStreaming = TEXT("WorldStreaming");
+	inline const TCHAR* FilterBuild = TEXT("FilterBuild");
+	inline const TCHAR* Render = TEXT("Render");
+	inline const TCHAR* Readback = TEXT("Readback");
+	inline const TCHAR* Composite = TEXT("Composite");
+	inline const TCHAR* Encode = TEXT("Encode");
+	inline const TCHAR* DiskWrite = TEXT("DiskWrite");
+	inline const TCHAR* TextureImport = TEXT("TextureImport");
+	inline const TCHAR* DataAssetExport = TEXT("DataAssetExport");
+}
+
+/** Timing of a single captured (or skipped) tile. The single-capture flow records one tile covering the whole image. */
+struct FMinimapTileStats
+{
+	int32 TileIndex = INDEX_NONE;
+	FIntPoint TileCoord = FIntPoint::ZeroValue;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	bool bSkipped = false;
+
+	/** Game-thread cost of queuing the scene capture. */
+	double RenderSeconds = 0.0;
+	/** GPU time of the scene capture from timestamp queries; negative when the RHI does not support them. */
+	double GpuRenderSeconds = -1.0;
+	/** Time the tile waited between queuing the capture and starting the readback, so streaming could settle. */
+	double StreamingWaitSeconds = 0.0;
+	/** Flush + GPU readback; includes the GPU work of the capture itself. */
+	double ReadbackSeconds = 0.0;
+	/** Wall time from queuing the capture until the pixels were handed to the tile store. */
+	double LatencySeconds = 0.0;
+	/** Frames the tile was rendered for; more than one with a persistent view state, until the frames converged. */
+	int32 FramesRendered = 1;
+};
+
+/** What the encode/write worker measured, handed back with the save result. */
+struct FMinimapSaveStats
+{
+	double EncodeSeconds = 0.0;
+	double WriteSeconds = 0.0;
+	int64 BytesWritten = 0;
+	/** Process physical memory right after encoding, while the pixels and the PNG are both alive. */
+	uint64 PeakUsedPhysicalBytes = 0;
+};
+
+/**
+ * Per-stage timings, per-tile latencies, bytes written and memory high-water marks of one capture.
+ * Filled by UMinimapGeneratorManager as the capture runs and written as JSON next to the output image.
+ */
+struct PANORAMICMINIMAPGENERATOREDITOR_API FMinimapCaptureReport
+{
+	FDateTime StartTime;
+	double StartSeconds = 0.0;
+	FString TileLayoutSummary;
+	/** IMinimapTileSource::GetName of the tiled capture's source; empty for the single capture. */
+	FString TileSourceName;
+
+	/** Accumulated seconds per stage, in the order the stages first ran. */
+	TArray<TPair<FString, double>> StageSeconds;
+	TArray<FMinimapTileStats> Tiles;
+
+	int64 FinalImageBytes = 0;
+	int64 DebugTileBytes = 0;
+	int64 TileStoreStoredBytes = 0;
+	int64 TileStoreRawBytes = 0;
+
+	/** Highest process physical memory seen at stage boundaries during this capture. */
+	uint64 PeakUsedPhysicalBytes = 0;
+	/** High-water mark of the plugin's own capture buffers (see EMinimapMemoryTag), exact rather than sampled. */
+	int64 PeakTrackedBytes = 0;
+
+	void Reset();
+	void AddStageSeconds(const TCHAR* Stage, double Seconds);
+	double GetStageSeconds(const TCHAR* Stage) const;
+	/** Updates both memory high-water marks. */
+	void SampleMemory();
+
+	/** Value at the given percentile (0-100) using nearest-rank; 0 for an empty set. */
+	static double Percentile(TArray<double> Values, double InPercentile);
+
+	/** Writes "<image>_report.json" next to the image. Returns the report path, or an empty string on failure. */
+	FString WriteJson(const FString& ImagePath, const FMinimapCaptureSettings& Settings, bool bSuccess) const;
+};
+
+/** Adds the scope's wall time to a report stage. */
+struct FMinimapScopedStageTimer
+{
+	FMinimapScopedStageTimer(FMinimapCaptureReport& InReport, const TCHAR* InStage)
+		: Report(InReport), Stage(InStage), StartSeconds(FPlatformTime::Seconds())
+	{
+	}
+
+	~FMinimapScopedStageTimer()
+	{
+		Report.AddStageSeconds(Stage, FPlatformTime::Seconds() - StartSeconds);
+	}
+
+private:
+	FMinimapCaptureReport& Report;
+	const TCHAR* Stage;
+	double StartSeconds;
+};
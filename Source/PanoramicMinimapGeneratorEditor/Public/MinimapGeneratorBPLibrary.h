@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MinimapCaptureQueueSubsystem.h"
 #include "MinimapGeneratorManager.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "MinimapGeneratorBPLibrary.generated.h"
@@ -16,6 +17,15 @@ class PANORAMICMINIMAPGENERATOREDITOR_API UMinimapGeneratorBPLibrary : public UB
 	GENERATED_BODY()
 
 public:
+	/** Queues a single capture; it starts once the captures queued before it are done. */
 	UFUNCTION(BlueprintCallable, Category = "Minimap Generator")
 	static void StartMinimapCapture(const FMinimapCaptureSettings& Settings);
+
+	/** Queues captures to run back to back, reusing the capture actor and render targets between them. */
+	UFUNCTION(BlueprintCallable, Category = "Minimap Generator")
+	static void EnqueueMinimapCaptures(const TArray<FMinimapCaptureJob>& Jobs);
+
+	/** Cancels the capture in progress and drops the queued ones. */
+	UFUNCTION(BlueprintCallable, Category = "Minimap Generator")
+	static void CancelMinimapCaptures();
 };
@@ -5,7 +5,14 @@
 #include "CoreMinimal.h"
 #include "Components/SceneCaptureComponent.h"
 #include "Engine/SceneCapture2D.h"
+#include "MinimapCaptureBuffers.h"
+#include "MinimapCaptureEstimate.h"
+#include "MinimapCaptureProfiles.h"
+#include "MinimapCaptureReport.h"
+#include "MinimapMemoryTracking.h"
 #include "MinimapDefinitionDataAsset.h"
+#include "MinimapTileLayout.h"
+#include "Tasks/Task.h"
 #include "UObject/Object.h"
 #include "MinimapGeneratorManager.generated.h"
 
@@ -16,6 +23,16 @@ enum class EMinimapBackgroundMode : uint8
 	SolidColor UMETA(DisplayName = "Solid Color"),
 };
 
+/** Where the tiled capture gets each tile's pixels from. */
+UENUM(BlueprintType)
+enum class EMinimapTileSourceType : uint8
+{
+	SceneCapture UMETA(DisplayName = "Scene Capture"),
+	SavedTiles UMETA(DisplayName = "Saved Tiles"),
+	Synthetic UMETA(DisplayName = "Synthetic"),
+	CpuRaster UMETA(DisplayName = "CPU Rasterizer"),
+};
+
 // Struct to hold all capture settings, easily passed around and exposed to UI/BP
 USTRUCT(BlueprintType)
 struct FMinimapCaptureSettings
@@ -25,6 +42,14 @@ struct FMinimapCaptureSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Region")
 	FBox CaptureBounds;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Partition", meta = (
+	Tooltip = "World Partition levels only. Loads the cells overlapping the capture bounds before capturing and unloads them afterwards. Without it, only the cells already loaded in the editor are captured."))
+	bool bLoadWorldPartitionRegion = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Partition", meta = (
+	EditCondition = "bLoadWorldPartitionRegion", ClampMin = "0", Units = "Centimeters", Tooltip = "When one output pixel covers at least this many world units, no cell is loaded and the region is captured from its HLODs, which must be built. 0 always loads the full cells. HLOD captures do not skip empty tiles or prestream tiles."))
+	float HLODWorldUnitsPerPixel = 1000.0f;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output")
 	int32 OutputWidth = 4096;
 
@@ -34,12 +59,65 @@ struct FMinimapCaptureSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling")
 	bool bUseTiling = false;
 	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling", meta = (EditCondition = "bUseTiling"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling", meta = (
+	EditCondition = "bUseTiling", Tooltip = "Render target size of each tile. When the layout planner is enabled, this is the maximum render target size."))
 	int32 TileResolution = 2048;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling", meta = (
+	EditCondition = "bUseTiling", Tooltip = "If checked, picks non-square, balanced tiles and shrinks the last column/row so no pixels are rendered outside the output canvas."))
+	bool bPlanTileLayout = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling", meta = (
+	EditCondition = "bUseTiling && bIsOrthographic", Tooltip = "Orthographic only. Tests each tile footprint against the bounds of the visible (filtered) primitives and fills tiles with nothing in them with the background color instead of rendering them."))
+	bool bSkipEmptyTiles = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling", meta = (
+	EditCondition = "bUseTiling", Tooltip = "If checked, captured tiles are LZ4-compressed on a worker thread and identical tiles are stored once until stitching. Greatly reduces peak memory on large grids."))
+	bool bCompressTilesInMemory = true;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling", meta = (EditCondition = "bUseTiling"))
 	int32 TileOverlap = 64;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling|Source", meta = (
+	EditCondition = "bUseTiling", Tooltip = "Scene Capture renders the level on the GPU. Saved Tiles re-stitches tiles saved by an earlier capture. Synthetic generates a seamless test pattern. CPU Rasterizer draws the bounds of the visible primitives without a GPU."))
+	EMinimapTileSourceType TileSourceType = EMinimapTileSourceType::SceneCapture;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling|Source", meta = (
+	EditCondition = "bUseTiling && TileSourceType == EMinimapTileSourceType::SavedTiles", Tooltip = "Folder holding the <File Name>_Tile_X_Y.png tiles to read. Empty uses the output path."))
+	FString TileSourceDirectory;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling|Source", meta = (
+	EditCondition = "bUseTiling && TileSourceType == EMinimapTileSourceType::SavedTiles", Tooltip = "If checked, tiles missing from the folder are rendered with the scene capture, so deleting stale tiles and capturing again only re-renders those. If unchecked, missing tiles are left to the background color."))
+	bool bRenderMissingTiles = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling|Distributed", meta = (
+	ClampMin = "1", EditCondition = "bUseTiling && TileSourceType == EMinimapTileSourceType::SceneCapture", Tooltip = "Number of headless editor processes that render the tiles in parallel. The level must be saved; the tiles are written to the output path and merged by this editor. 1 renders every tile here."))
+	int32 NumCaptureShards = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling", meta = (
+	EditCondition = "bUseTiling && bIsOrthographic", Tooltip = "Orthographic only. Before each tile is rendered, forces every mip of the textures and static meshes in its footprint to be resident and waits for exactly those, instead of a fixed delay. Requests run one tile ahead, so the next tile streams while this one renders."))
+	bool bPrestreamTiles = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling|Floors", meta = (
+	EditCondition = "bUseTiling", Tooltip = "Scene Capture only. Renders every tile once more per floor, showing only the primitives that overlap the floor's Z range and clipping everything above it, and saves each floor as <FileName>_Floor_<Name>.png. Clipping needs the project's Support Global Clip Plane setting."))
+	TArray<FMinimapFloorRange> Floors;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling|Convergence", meta = (
+	EditCondition = "bUseTiling", Tooltip = "Keeps the capture's view state (temporal AA, exposure and other history) alive and renders each tile frame after frame until two frames in a row differ by less than the convergence threshold, instead of reading one frame after a fixed delay."))
+	bool bPersistentViewState = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling|Convergence", meta = (
+	ClampMin = "0.0", UIMax = "4.0", EditCondition = "bUseTiling && bPersistentViewState", Tooltip = "Mean difference between two frames of a tile, per 8-bit channel, below which the tile counts as settled."))
+	float ConvergenceThreshold = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling|Convergence", meta = (
+	ClampMin = "2", UIMax = "32", EditCondition = "bUseTiling && bPersistentViewState", Tooltip = "Frames after which a tile that has not converged is read anyway."))
+	int32 MaxFramesPerTile = 8;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tiling", meta = (
+	EditCondition = "bUseTiling && bIsOrthographic", Tooltip = "Orthographic only. Snaps every tile to exact texel boundaries using double-precision math, so tiles can be stitched with zero overlap and a plain copy. Tile Overlap is ignored, and temporal AA, TSR and motion blur are turned off because they would show as seams without overlap."))
+	bool bPixelAlignedTiling = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debugging", meta = (
 	EditCondition = "bUseTiling", Tooltip = "If checked, saves each captured tile as a separate image for debugging the stitching process."))
 	bool bSaveTiles = true;
@@ -49,7 +127,11 @@ struct FMinimapCaptureSettings
 	Tooltip = "If checked, forces cinematic-quality post-processing. If unchecked (default), uses the current editor viewport scalability settings for better performance."))
 	bool bOverrideWithHighQualitySettings = false;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quality")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quality", meta = (
+	Tooltip = "Render features the capture pays for. Schematic, Fast, Balanced and Cinematic each set every show flag and matching post-process overrides, replacing Capture Dynamic Shadows. Custom keeps the engine defaults and the options below."))
+	EMinimapCaptureProfile CaptureProfile = EMinimapCaptureProfile::Custom;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quality", meta = (EditCondition = "CaptureProfile == EMinimapCaptureProfile::Custom"))
 	bool bCaptureDynamicShadows = true;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Quality|Overrides", meta = (EditCondition = "bOverrideWithHighQualitySettings"))
@@ -89,12 +171,28 @@ struct FMinimapCaptureSettings
 	Tooltip = "If checked, automatically appends a timestamp (_DD_MM_HH_mm) to the filename."))
 	bool bUseAutoFilename = true;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (
+	EditCondition = "bUseTiling", Tooltip = "Tiled Scene Capture only. Also renders these buffers at every tile position, right after the color tile, and saves each one as <FileName>_<Buffer>.png. Height and depth assume the default straight-down camera."))
+	TArray<EMinimapCaptureBuffer> AdditionalBuffers;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output|Import")
 	bool bImportAsTextureAsset = false;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output|Import", meta = (EditCondition = "bImportAsTextureAsset"))
 	FString AssetPath = TEXT("/Game/Minimaps/");
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output|Import", meta = (
+	EditCondition = "bUseTiling", Tooltip = "Virtual Texture (UDIM) stitches the tiles page by page into <FileName>_1001.png, _1002.png, ... without assembling the whole map, and imports the pages as one streaming virtual texture. Needed to import maps beyond 16384 px; only the pages on screen are loaded at runtime."))
+	EMinimapTextureMode TextureMode = EMinimapTextureMode::SingleTexture;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output|Import", meta = (
+	ClampMin = "512", ClampMax = "8192", EditCondition = "bUseTiling && TextureMode == EMinimapTextureMode::VirtualTextureUDIM", Tooltip = "Pixel size of each UDIM page, a power of two. At most 10 pages fit across the map; the last column and row are padded with the background."))
+	int32 UDIMPageSize = 4096;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output|Import", meta = (
+	ClampMin = "256", EditCondition = "bUseTiling && TextureMode == EMinimapTextureMode::VirtualTextureUDIM", Tooltip = "Largest UDIM texture source, in MB, the import may create. The engine keeps UDIM pages uncompressed in the source, so it is held whole in editor memory and saved in the package at 4 bytes per pixel."))
+	int32 UDIMSourceBudgetMB = 2048;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output|Runtime")
 	bool bExportDefinitionAsset = true;
 
@@ -107,6 +205,10 @@ struct FMinimapCaptureSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (EditCondition = "BackgroundMode == EMinimapBackgroundMode::SolidColor"))
 	FLinearColor BackgroundColor = FLinearColor::Black;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output|Patch", meta = (
+	ClampMin = "0", UIMax = "512", Tooltip = "Pixels around a patched region over which the recaptured image fades into the existing minimap."))
+	int32 PatchFeatherWidth = 64;
+
 	// FILTERING
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Filtering")
 	ESceneCapturePrimitiveRenderMode PrimitiveRenderMode = ESceneCapturePrimitiveRenderMode::PRM_RenderScenePrimitives;
@@ -125,14 +227,28 @@ struct FMinimapCaptureSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay")
 	TArray<FMinimapOverlayLayer> OverlayLayers;
+
+	// PLANNING
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planning", meta = (
+	ClampMin = "0", Tooltip = "RAM the capture may use, in MB. The estimator recommends settings that fit it. 0 uses the physical memory currently available."))
+	int32 MemoryBudgetMB = 0;
 };
 
 class FMinimapStreamingSourceProvider;
+class FMinimapPrimitiveBoundsIndex;
+class FMinimapTileStore;
+class FMinimapGpuTimer;
+class IMinimapTileSource;
+struct FMinimapAssetImport;
+struct FMinimapDecodedImage;
 
 // Delegate to report progress back to the UI
 DECLARE_MULTICAST_DELEGATE_FourParams(FOnMinimapProgress, const FText&, /*Status*/ float, /*Percentage*/ int32,
                                       /*CurrentTile*/ int32 /*TotalTiles*/);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMinimapCaptureComplete, bool /*bSuccess*/, const FString& /*FinalImagePath*/);
+DECLARE_MULTICAST_DELEGATE(FOnMinimapRenderComplete);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnMinimapPreviewUpdated, TConstArrayView<FColor> /*Canvas*/, const FIntPoint& /*CanvasSize*/,
+                                       const FIntRect& /*DirtyRect*/);
 
 /**
  * 
@@ -145,18 +261,107 @@ class PANORAMICMINIMAPGENERATOREDITOR_API UMinimapGeneratorManager : public UObj
 public:
 	// Starts the entire capture and stitching process
 	void StartCaptureProcess(const FMinimapCaptureSettings& InSettings);
+
+	/**
+	 * Patch: recaptures only the tiles covering PatchBounds, at the bounds, output size and rotation recorded in Target,
+	 * and feathers them into Target's base map texture, whose source is rewritten in place. The patched image is also
+	 * saved to the output path. InSettings supplies the rest (camera, quality, filters, tile size) and should match the
+	 * capture that produced the texture.
+	 */
+	void StartPatchCapture(const FMinimapCaptureSettings& InSettings, UMinimapDefinitionDataAsset* Target, const FBox& PatchBounds);
+
+	/** Tile layout the tiled capture will use for these settings. Safe to call before a capture, e.g. from the UI. */
+	static FMinimapTileLayout MakeTileLayout(const FMinimapCaptureSettings& InSettings);
+	/** True when tiles are snapped to texel boundaries and composited without overlap. */
+	static bool IsPixelAlignedTiling(const FMinimapCaptureSettings& InSettings);
+	/** Overlap actually used by the grid and the stitcher (zero in pixel-aligned mode). */
+	static int32 GetEffectiveTileOverlap(const FMinimapCaptureSettings& InSettings);
 	void StartSingleCaptureForValidation();
 
+	/**
+	 * Progressive preview: captures the whole region in one coarse pass of at most 512 px and shows it stretched over
+	 * the preview canvas right away, then renders the canvas tile by tile, nearest to FocusLocation first, and swaps
+	 * each tile in. The canvas is the output resolution, capped at 4096 px. Every step broadcasts OnPreviewUpdated and
+	 * OnCaptureComplete follows with an empty path: nothing is written or imported.
+	 */
+	void StartProgressivePreview(const FMinimapCaptureSettings& InSettings, const FVector& FocusLocation);
+	/** Refines the remaining preview tiles nearest FocusUV (0-1 over the canvas) first, e.g. the one under the mouse. */
+	void SetPreviewFocus(const FVector2D& FocusUV);
+	bool IsRefiningPreview() const { return PreviewTileOrder.Num() > 0; }
+
+	/**
+	 * Dry run: calibrates on this machine with a short capture and encode benchmark, then predicts wall time,
+	 * peak RAM/VRAM and disk usage for the settings and recommends changes that fit the memory budget.
+	 * Blocks the editor for the calibration (typically well under a second). Not available while a capture runs.
+	 */
+	FMinimapCaptureEstimate EstimateCapture(const FMinimapCaptureSettings& InSettings);
+
+	/**
+	 * Renders one tile of InSettings at the center of the bounds with every capture profile and returns the GPU time
+	 * of each, cheapest profile first. Tiles larger than 2048 px are timed at 2048 px and at half that, and only the
+	 * per-pixel part of the cost is scaled up to the tile. Blocks the editor for a few captures per profile. Not
+	 * available while a capture runs; OutError says why when the result is empty.
+	 */
+	TArray<FMinimapCaptureProfileCost> MeasureCaptureProfiles(const FMinimapCaptureSettings& InSettings, FString& OutError);
+
 	// Delegate for UI updates
 	FOnMinimapProgress OnProgress;
 	FOnMinimapCaptureComplete OnCaptureComplete;
+	/**
+	 * Broadcast once the capture no longer needs the GPU, the level or the capture actor: the final image (or its UDIM
+	 * pages) has been handed to workers for encoding, and everything left runs there and in OnSaveTaskCompleted.
+	 * OnCaptureComplete follows once it is written and imported.
+	 */
+	FOnMinimapRenderComplete OnRenderComplete;
+	/** The progressive preview canvas changed inside DirtyRect. */
+	FOnMinimapPreviewUpdated OnPreviewUpdated;
+
+	/**
+	 * Keeps the capture actor and the pooled render targets when a capture ends instead of destroying them, so the
+	 * next capture of a batch skips the spawn and the render target allocations. Released by ReleaseRetainedCaptureResources.
+	 */
+	void SetRetainCaptureResources(const bool bRetain) { bRetainCaptureResources = bRetain; }
+	/** Destroys the retained capture actor and render targets. Only call it between captures. */
+	void ReleaseRetainedCaptureResources();
+	/** Takes over the retained capture actor and render targets of a manager whose capture has finished rendering. */
+	void AdoptCaptureResources(UMinimapGeneratorManager& Other);
 	
 	// Cancel an ongoing capture process
 	void CancelCapture();
 	void ShutdownCapture(bool bBroadcastResult);
 	
 	// Callback function when the async save task is complete
-	void OnSaveTaskCompleted(bool bSuccess, const FString& SavedImagePath);
+	/** EncodedImage holds the saved PNG's bytes when the save task was asked to keep them. */
+	void OnSaveTaskCompleted(bool bSuccess, const FString& SavedImagePath, const FMinimapSaveStats& SaveStats = FMinimapSaveStats(),
+	                         TArray64<uint8> EncodedImage = TArray64<uint8>());
+
+	/** Timings and memory of the current or last capture; written as "<image>_report.json" when a capture finishes. */
+	const FMinimapCaptureReport& GetCaptureReport() const { return CaptureReport; }
+	/** Tile layout of the last capture; the single capture is reported as one tile covering the image. */
+	const FMinimapTileLayout& GetTileLayout() const { return TileLayout; }
+
+	/**
+	 * Imports an image saved earlier as the Texture2D and/or definition DataAsset, as InSettings asks a finished
+	 * capture to. The packages are marked dirty and returned, not saved. Used by the capture commandlet.
+	 */
+	bool ImportSavedImage(const FMinimapCaptureSettings& InSettings, const FString& ImagePath, TArray<UPackage*>& OutPackages);
+
+	/**
+	 * Capture settings as JSON. A tiled capture with Save Tiles writes "<FileName>_settings.json" next to its tiles
+	 * so the capture commandlet can re-stitch them. Returns the path, or an empty string on failure.
+	 */
+	static FString WriteSettingsFile(const FMinimapCaptureSettings& InSettings, const FString& Path);
+	static bool ReadSettingsFile(const FString& Path, FMinimapCaptureSettings& OutSettings);
+
+	/**
+	 * Renders tiles [FirstTile, EndTile) of the tiled capture for InSettings with the scene capture, one after the
+	 * other without waiting on timers, and hands each to OnTileCaptured with its size; returning false from it stops
+	 * the capture. Empty tiles are skipped when the settings ask for it. Used by the shard worker commandlet, where
+	 * the editor does not tick.
+	 */
+	bool CaptureTilesBlocking(const FMinimapCaptureSettings& InSettings, int32 FirstTile, int32 EndTile,
+	                          TFunctionRef<bool(int32 /*TileIndex*/, const TArray<FColor>& /*Pixels*/, const FIntPoint& /*Size*/)> OnTileCaptured,
+	                          FString& OutError);
 
 	virtual void BeginDestroy() override;
 private:
@@ -165,21 +370,46 @@ private:
 
 	bool SaveFinalImage(const TArray<FColor>& ImageData, int32 Width, int32 Height);
 	UTexture2D* ImportTextureAssetFromSavedImage(const FString& SavedImagePath) const;
-	UMinimapDefinitionDataAsset* CreateOrUpdateDefinitionAsset(const FString& SavedImagePath, UTexture2D* BaseMapTexture) const;
+	/** Game-thread half of the texture import: finds or creates the asset and writes the decoded image into its source. */
+	UTexture2D* ImportDecodedTexture(FMinimapDecodedImage& Image) const;
+	/** Loads the texture at FullAssetPath, or creates it and registers it with the asset registry. */
+	UTexture2D* FindOrCreateTextureAsset(const FString& FullAssetPath) const;
+	/** "/Game/.../T_<ImageName>" and "/Game/.../DA_<ImageName>", from the asset path settings. */
+	FString MakeTextureAssetPath(const FString& ImagePath) const;
+	FString MakeDefinitionAssetPath(const FString& ImagePath) const;
+	UMinimapDefinitionDataAsset* CreateOrUpdateDefinitionAsset(const FString& SavedImagePath, UTexture2D* BaseMapTexture,
+	                                                           const TArray<FMinimapFloor>& Floors = {}) const;
 	void CleanupCaptureResources();
 
+	/** Renders and reads back a tile-sized calibration capture at two sizes and times the CPU stages on the result. */
+	bool CalibrateCapture(const FMinimapCaptureSettings& InSettings, FMinimapCaptureCalibration& OutCalibration);
+
 	// === FUNCTIONS FOR SINGLE CAPTURE ===
 	/** Create and configure the Render Target to draw to. */
-	UTextureRenderTarget2D* CreateRenderTarget() const;
+	UTextureRenderTarget2D* CreateRenderTarget(const FIntPoint& Size) const;
+	FLinearColor GetRenderTargetClearColor() const;
 
 	/** Spawn, configure, and position the Scene Capture Actor. */
 	ASceneCapture2D* SpawnAndConfigureCaptureActor(UTextureRenderTarget2D* RenderTarget) const;
+	void ConfigureCaptureActor(ASceneCapture2D& CaptureActor, UTextureRenderTarget2D* RenderTarget) const;
+
+	/** Reuses the retained capture actor when it is in the editor world, otherwise spawns one; configures it either way. */
+	ASceneCapture2D* AcquireCaptureActor(UTextureRenderTarget2D* RenderTarget);
+	/** Parks the active capture actor for the next capture when resources are retained, destroys it otherwise. */
+	void ReleaseCaptureActor();
 
 	/** Called by Timer to read pixels, clean up, and start saving. */
 	void ReadPixelsAndFinalize();
 
-	/** Generate the final file name and start AsyncTask to save the image. */
-	void StartImageSaveTask(TArray<FColor> PixelData, int32 ImageWidth, int32 ImageHeight);
+	/** "<OutputPath>/<FileName>", with the timestamp when auto filenames are on; the outputs add their suffix and extension. */
+	FString MakeOutputBasePath() const;
+
+	/**
+	 * Start AsyncTask to save the image as "<OutputBasePath>.png". With bKeepEncodedImage the PNG's bytes are handed
+	 * back to OnSaveTaskCompleted as well.
+	 */
+	void StartImageSaveTask(TArray<FColor> PixelData, FMinimapTrackedBytes PixelDataBytes, int32 ImageWidth, int32 ImageHeight,
+	                        const FString& OutputBasePath, bool bKeepEncodedImage = false);
 	
 	// === ASYNC READBACK ===
 	/** Called by Timer to check if the GPU has finished reading pixels */
@@ -196,6 +426,7 @@ private:
 
 	/** Staging buffer for the rendering thread to write pixel data into */
 	TArray<FColor> StagingPixelBuffer;
+	FMinimapTrackedBytes StagingPixelBufferBytes;
 	// ===========================================
 
 	// Handle to the timer that polls streaming completion
@@ -210,15 +441,161 @@ private:
 
 	// Member variables
 	FMinimapCaptureSettings Settings;
-	TMap<FIntPoint, TArray<FColor>> CapturedTileData;
-	int32 NumTilesX = 0;
-	int32 NumTilesY = 0;
+	/** Captured tiles, indexed by tile index (row-major over TileLayout). */
+	TSharedPtr<FMinimapTileStore> TileStore;
+	/** Tiles of each additional buffer, filled alongside TileStore. */
+	TMap<EMinimapCaptureBuffer, TSharedPtr<FMinimapTileStore>> BufferTileStores;
+	/** Tiles of each of the settings' floors, filled alongside TileStore. */
+	TArray<TSharedPtr<FMinimapTileStore>> FloorTileStores;
+	/** Where each floor's stitched image is being saved, by floor index; imported with the base map. */
+	TArray<FString> FloorImagePaths;
+	/** Encoding and writing of the stitched additional buffers, by output path; waited for before the capture reports. */
+	TArray<TPair<FString, UE::Tasks::TTask<bool>>> BufferSaveTasks;
+	FMinimapTileLayout TileLayout;
 	int32 CurrentTileIndex = 0;
+	/** Last tile whose residency was requested by CaptureNextTile; the wait for it is timed from then. */
+	int32 PreparedTileIndex = INDEX_NONE;
+	/** Shared start of the full and patch captures: validates InSettings and runs the tiled or single capture. */
+	void BeginCaptureProcess(const FMinimapCaptureSettings& InSettings);
 	void StartTiledCaptureProcess();
 	void CalculateGrid();
 	void CaptureNextTile();
+	/**
+	 * Loads the capture bounds' World Partition cells, or their HLODs for coarse outputs, when the settings ask for it.
+	 * An HLOD capture turns off empty-tile skipping and tile prestreaming, which only see loaded actors.
+	 */
+	void LoadCaptureRegion();
+	/** First tile at or after TileIndex that is neither skipped nor missing from the tile source; INDEX_NONE if none. */
+	int32 FindNextTileToCapture(int32 TileIndex) const;
+	/** Calls OnTileRenderedAndContinue after the delay, or next tick when there is none. */
+	void ScheduleTileRead(double ReadDelaySeconds);
 	void OnTileRenderedAndContinue();
 	void StartStitching();
+	/**
+	 * Stitches each additional buffer and floor and starts saving them as "<OutputBasePath>_<Buffer>.png" and
+	 * "<OutputBasePath>_Floor_<Name>.png".
+	 */
+	void SaveAdditionalBuffers(const FString& OutputBasePath);
+	/**
+	 * Virtual texture output: stitches the map one UDIM page at a time from the tiles that overlap it, copies each
+	 * page into its block of the texture when importing, and saves it as "<OutputBasePath>_<UDIM>.png", so the full
+	 * canvas is never assembled.
+	 */
+	void StitchAndSavePages(const FString& OutputBasePath);
+	/** Checks the texture mode against the output size and the source budget; logs the page layout of a UDIM output. */
+	bool ValidateTextureMode(FString& OutError) const;
+	/** The base path the current capture's UDIM pages were saved under, and the texture they were written into. */
+	FString PageOutputBasePath;
+	TWeakObjectPtr<UTexture2D> PagedTexture;
+	/** StitchAndSavePages is waiting for, or has waited for, the background load of the existing texture package. */
+	bool bPagedTextureLoadRequested = false;
+
+	// === ASSET IMPORT ===
+	/**
+	 * Imports the saved base map and floor images and exports the DataAsset without blocking the editor: each image is
+	 * decoded on a worker, existing packages load in the background, and the game thread only updates the assets.
+	 */
+	void StartAssetImport(const FString& SavedImagePath);
+	/** Starts the worker for the next image, or finishes the import once every image is in. */
+	void DecodeNextImportImage();
+	/** Imports the decoded image once the packages have loaded, then moves on to the next one. */
+	void ContinueAssetImport();
+	/** Exports the DataAsset, writes the capture report and reports completion. */
+	void FinishAssetImport();
+	TSharedPtr<FMinimapAssetImport> AssetImport;
+
+	/** Returns a render target of the requested size, creating it on first use. Edge tiles and the single capture use their own size. */
+	UTextureRenderTarget2D* AcquireTileRenderTarget(const FIntPoint& Size);
+	/** Same for the 32-bit float targets the depth and normal buffers render to. */
+	UTextureRenderTarget2D* AcquireFloatRenderTarget(const FIntPoint& Size);
+	void ReleaseRenderTargets();
+
+	/** Size of the render target for a tile; width and height are swapped in portrait because tiles are captured rotated. */
+	FIntPoint GetTileRenderTargetSize(const FIntRect& TileRect) const;
+
+	/** World distance covered by one output pixel, identical on X and Y. */
+	double GetWorldUnitsPerPixel() const;
+
+	/** Actors the capture renders: the component's show-only list when given one, otherwise what the settings filter would give it. */
+	void GatherVisibleActors(const USceneCaptureComponent2D* CaptureComponent, TArray<AActor*>& OutVisibleActors) const;
+
+	/** Indexes the primitives of the visible actors so empty tiles can be skipped. */
+	void BuildPrimitiveBoundsIndex(const TArray<AActor*>& VisibleActors);
+	/** True for tiles proven empty, and during a patch for tiles that do not reach the patched region. */
+	bool ShouldSkipTile(int32 TileIndex) const;
+
+	TSharedPtr<FMinimapPrimitiveBoundsIndex> PrimitiveBoundsIndex;
+	int32 NumSkippedTiles = 0;
+	/** Tiles the tile source had no pixels for; left to the background color. */
+	int32 NumUnavailableTiles = 0;
+
+	// === TILE SOURCE ===
+	/** Builds the source selected in the settings; saved tiles fall back to the scene capture for missing tiles. */
+	TSharedRef<IMinimapTileSource> CreateTileSource();
+
+	/** Produces the pixels of each tile of the tiled capture. */
+	TSharedPtr<IMinimapTileSource> TileSource;
+
+	/** The scene-capture source drives the capture actor and the pooled render targets owned by the manager. */
+	friend class FMinimapSceneCaptureTileSource;
+
+	// === PATCH ===
+	/**
+	 * Blends the stitched canvas into the patch texture's source around PatchRect and leaves the result in Canvas for
+	 * saving. Nothing is written to the texture when the patch leaves it unchanged. A raw source is rewritten here; a
+	 * compressed one takes the PNG the save task encodes, see bPatchAwaitsEncodedImage.
+	 */
+	bool ApplyPatch(TArray<FColor>& Canvas, FString& OutError);
+	/** Replaces the patch texture's source with the patched image (EncodedImage as PNG when given, else Pixels) and rebuilds it. */
+	void WritePatchSource(TConstArrayView<FColor> Pixels, const FIntPoint& Size, TArrayView64<uint8> EncodedImage);
+
+	/** Texture a patch capture is blended into; unset for a full capture. */
+	TWeakObjectPtr<UTexture2D> PatchTexture;
+	/** Canvas pixels recaptured by the patch, before feathering. */
+	FIntRect PatchRect;
+	/** The patch changed a compressed source, which is rewritten once the save task has encoded the patched canvas. */
+	bool bPatchAwaitsEncodedImage = false;
+
+	// === PROGRESSIVE PREVIEW ===
+	/** One capture of the whole region at the current (coarse) settings, stretched over a CanvasSize preview canvas. */
+	bool CaptureCoarsePreview(const FIntPoint& CanvasSize, FString& OutError);
+	void SortPreviewTiles();
+	void RefineNextPreviewTile();
+	void OnPreviewTileRendered();
+	void FinishProgressivePreview();
+
+	TArray<FColor> PreviewCanvas;
+	FIntPoint PreviewCanvasSize = FIntPoint::ZeroValue;
+	/** Canvas pixel the refinement starts from. */
+	FVector2D PreviewFocus = FVector2D::ZeroVector;
+	/** Tiles still to refine, nearest to the focus last. */
+	TArray<int32> PreviewTileOrder;
+	int32 NumRefinedPreviewTiles = 0;
+
+	// === SHARDED CAPTURE ===
+	/** Writes the shard manifest and launches one worker commandlet per shard on this machine. */
+	bool StartShardWorkers(FString& OutError);
+	/** Reports the workers' progress from their indices and merges their tiles once they have all exited. */
+	void PollShardWorkers();
+	void TerminateShardWorkers();
+
+	TArray<FProcHandle> ShardWorkers;
+	FTimerHandle ShardPollTimer;
+	double ShardStartSeconds = 0.0;
+	/** Set once the workers have exited: the tiled capture reads their tiles and renders only the ones they missed. */
+	bool bMergingShards = false;
+
+	// === CAPTURE REPORT ===
+	FMinimapCaptureReport CaptureReport;
+	/** When the current tile (or the single capture) was queued, and how long queuing it took on the game thread. */
+	double TileCaptureStartSeconds = 0.0;
+	double TileRenderSeconds = 0.0;
+	/** Bytes written by the debug tile tasks, which finish on worker threads. */
+	TSharedPtr<FThreadSafeCounter64, ESPMode::ThreadSafe> DebugTileBytesWritten;
+	/** GPU timestamps around the current tile's scene capture. */
+	TSharedPtr<FMinimapGpuTimer, ESPMode::ThreadSafe> TileGpuTimer;
+	/** Appends the capture's memory high-water marks so OnProgress listeners can watch them grow. */
+	FText WithMemoryHighWater(const FText& Status);
 	
 	FIntPoint CurrentCaptureTilePosition;
 	FDelegateHandle ScreenshotCapturedDelegateHandle;
@@ -230,4 +607,15 @@ private:
 	TWeakObjectPtr<ASceneCapture2D> ActiveCaptureActor;
 	TWeakObjectPtr<UTextureRenderTarget2D> ActiveRenderTarget;
 
+	bool bRetainCaptureResources = false;
+	/** Capture actor parked between captures while resources are retained. */
+	TWeakObjectPtr<ASceneCapture2D> RetainedCaptureActor;
+
+	/** Render targets used by the captures, keyed by size (at most one per distinct edge-tile size). */
+	UPROPERTY(Transient)
+	TMap<FIntPoint, TObjectPtr<UTextureRenderTarget2D>> TileRenderTargets;
+
+	UPROPERTY(Transient)
+	TMap<FIntPoint, TObjectPtr<UTextureRenderTarget2D>> FloatTileRenderTargets;
+
 };
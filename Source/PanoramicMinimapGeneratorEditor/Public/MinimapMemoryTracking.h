@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** The plugin's large capture buffers. Each one also has an LLM tag of the same name under "MinimapGenerator". */
+enum class EMinimapMemoryTag : uint8
+{
+	/** Tile pixels from readback until compressed, plus the tile store payloads. */
+	CapturedTileData,
+	/** Full-resolution readback of a single (non-tiled) capture. */
+	StagingPixelBuffer,
+	/** Stitched full-resolution image, until the encoder has consumed it. */
+	StitchCanvas,
+	/** Raw copies and compressed PNG data held by IImageWrapper during encode and decode. */
+	ImageWrapperBuffers,
+	/** Decoded PNG handed to the texture importer. */
+	UncompressedBGRA,
+
+	Num
+};
+
+/**
+ * Live bytes and high-water marks of the buffers above. Unlike LLM this works in every build configuration without
+ * command-line switches, so it is what the capture report and progress status use. Thread safe.
+ */
+namespace MinimapMemory
+{
+	PANORAMICMINIMAPGENERATOREDITOR_API const TCHAR* GetTagName(EMinimapMemoryTag Tag);
+
+	PANORAMICMINIMAPGENERATOREDITOR_API void Add(EMinimapMemoryTag Tag, int64 Bytes);
+	PANORAMICMINIMAPGENERATOREDITOR_API void Remove(EMinimapMemoryTag Tag, int64 Bytes);
+
+	/** Restarts the high-water marks from the bytes currently live; called when a capture starts. */
+	PANORAMICMINIMAPGENERATOREDITOR_API void ResetHighWater();
+
+	PANORAMICMINIMAPGENERATOREDITOR_API int64 GetLiveBytes();
+	/** Highest sum of all tags seen at once since the last reset. */
+	PANORAMICMINIMAPGENERATOREDITOR_API int64 GetHighWaterBytes();
+	PANORAMICMINIMAPGENERATOREDITOR_API int64 GetHighWaterBytes(EMinimapMemoryTag Tag);
+}
+
+/** Counts a buffer against a tag for as long as it lives. Move-only, so it can follow its buffer to a worker thread. */
+class PANORAMICMINIMAPGENERATOREDITOR_API FMinimapTrackedBytes
+{
+public:
+	FMinimapTrackedBytes() = default;
+	FMinimapTrackedBytes(EMinimapMemoryTag InTag, int64 InBytes);
+	FMinimapTrackedBytes(FMinimapTrackedBytes&& Other);
+	FMinimapTrackedBytes& operator=(FMinimapTrackedBytes&& Other);
+	FMinimapTrackedBytes(const FMinimapTrackedBytes&) = delete;
+	FMinimapTrackedBytes& operator=(const FMinimapTrackedBytes&) = delete;
+	~FMinimapTrackedBytes() { Reset(); }
+
+	void Reset();
+	int64 GetBytes() const { return Bytes; }
+
+private:
+	EMinimapMemoryTag Tag = EMinimapMemoryTag::Num;
+	int64 Bytes = 0;
+};
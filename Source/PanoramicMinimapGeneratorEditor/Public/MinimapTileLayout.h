@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Describes how the output canvas is split into capture tiles.
+ * All rects are expressed in output-canvas pixels; tiles in the last column/row may be smaller than TileSize
+ * so no pixel is rendered outside of the canvas.
+ */
+struct PANORAMICMINIMAPGENERATOREDITOR_API FMinimapTileLayout
+{
+	/** Size of the final stitched image. */
+	FIntPoint OutputSize = FIntPoint::ZeroValue;
+
+	/** Size of every tile except the last column/row. Not necessarily square. */
+	FIntPoint TileSize = FIntPoint::ZeroValue;
+
+	/** Width of the tiles in the last column and height of the tiles in the last row. */
+	FIntPoint EdgeTileSize = FIntPoint::ZeroValue;
+
+	/** Number of tiles along X and Y. */
+	FIntPoint NumTiles = FIntPoint::ZeroValue;
+
+	/** Overlap in pixels between neighbouring tiles. */
+	int32 Overlap = 0;
+
+	bool IsValid() const { return NumTiles.X > 0 && NumTiles.Y > 0; }
+	int32 GetNumTiles() const { return NumTiles.X * NumTiles.Y; }
+	FIntPoint GetTileCoord(const int32 TileIndex) const { return FIntPoint(TileIndex % NumTiles.X, TileIndex / NumTiles.X); }
+
+	/** Canvas-space rect covered by a tile (Min inclusive, Max exclusive). */
+	FIntRect GetTileRect(int32 TileX, int32 TileY) const;
+
+	/** Total number of pixels rendered by all tiles, overlap included. */
+	int64 GetRenderedPixelCount() const;
+
+	/** Human-readable summary used for logs and the editor window. */
+	FString ToString() const;
+
+	/** Legacy layout: square TileResolution tiles, the last row/column renders past the canvas edge. */
+	static FMinimapTileLayout MakeUniform(const FIntPoint& InOutputSize, int32 TileResolution, int32 InOverlap);
+
+	/**
+	 * Chooses the layout with the fewest tiles and the fewest rendered pixels that fits in MaxRenderTargetSize.
+	 * Tile width and height are planned independently (non-square tiles), balanced across the grid, rounded up
+	 * to Alignment, and the last column/row is shrunk to end exactly on the canvas edge.
+	 */
+	static FMinimapTileLayout Plan(const FIntPoint& InOutputSize, int32 InOverlap, int32 MaxRenderTargetSize, int32 Alignment = 8);
+};
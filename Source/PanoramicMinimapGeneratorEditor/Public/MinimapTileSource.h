@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinimapGeneratorManager.h"
+#include "MinimapTileLayout.h"
+
+/** What a tile source knows about the capture it produces tiles for. */
+struct PANORAMICMINIMAPGENERATOREDITOR_API FMinimapTileSourceContext
+{
+	FMinimapCaptureSettings Settings;
+	FMinimapTileLayout Layout;
+	/** Canvas pixel = (World - CaptureBounds.Min) / WorldUnitsPerPixel, on X and Y. */
+	double WorldUnitsPerPixel = 0.0;
+	/** Filtered actors the capture renders; only gathered for sources that read the world themselves. */
+	TArray<AActor*> VisibleActors;
+
+	/** Portrait tiles are produced rotated by 90 degrees and turned clockwise onto the canvas by the stitcher. */
+	bool IsPortrait() const { return Settings.OutputHeight > Settings.OutputWidth; }
+	FIntRect GetTileRect(int32 TileIndex) const;
+	/** Size of the pixels a source hands back for the tile, in tile (possibly rotated) orientation. */
+	FIntPoint GetTileSize(int32 TileIndex) const;
+	/** Canvas pixel that tile pixel (X, Y) lands on once the stitcher has placed and rotated it. */
+	FIntPoint TileToCanvas(const FIntRect& TileRect, int32 X, int32 Y) const;
+};
+
+/**
+ * Produces the pixels of each tile of a tiled capture. The manager plans the grid, asks the source for every tile
+ * in row-major order and stitches, encodes and imports the result the same way whatever the source is, so the
+ * whole pipeline can run from saved tiles or without a GPU.
+ *
+ * Every tile goes through RequestTile, then ReadTile once the returned delay has passed. A source that renders a
+ * tile over several frames is polled with NeedsMoreFrames before ReadTile until it returns false. All calls happen
+ * on the game thread, between Begin and End.
+ */
+class PANORAMICMINIMAPGENERATOREDITOR_API IMinimapTileSource
+{
+public:
+	virtual ~IMinimapTileSource() = default;
+
+	/** Short name used in logs and in the capture report. */
+	virtual FString GetName() const = 0;
+
+	/** True when the source renders the level, so tiles with nothing visible in them can be skipped. */
+	virtual bool ReadsWorld() const = 0;
+
+	/** True when the source needs FMinimapTileSourceContext::VisibleActors. */
+	virtual bool NeedsVisibleActors() const { return false; }
+
+	virtual bool Begin(const FMinimapTileSourceContext& InContext, FString& OutError) = 0;
+	virtual void End() {}
+
+	/** False when the source has no pixels for the tile; the tile is left to the background color. */
+	virtual bool CanProvideTile(int32 TileIndex) const { return true; }
+
+	/** False when the tile comes from existing saved tiles and saving it again would only rewrite the same file. */
+	virtual bool IsNewTile(int32 TileIndex) const { return true; }
+
+	/**
+	 * Starts whatever the tile needs before it can be requested, e.g. streaming. The manager calls it for the tile
+	 * it is about to request and for the one after, so the next tile prepares while this one renders.
+	 */
+	virtual void PrepareTile(int32 TileIndex) {}
+	/** False while the tile is still preparing; the manager polls it every tick before RequestTile, up to a timeout. */
+	virtual bool IsTileReady(int32 TileIndex) const { return true; }
+
+	/** Starts producing the tile. OutReadDelaySeconds is how long to wait before reading it, e.g. for streaming. */
+	virtual bool RequestTile(int32 TileIndex, double& OutReadDelaySeconds, FString& OutError) = 0;
+
+	/**
+	 * Called once the read delay has passed. Returning true means the source has rendered another frame of the tile
+	 * and wants to be polled again after OutReadDelaySeconds instead of being read.
+	 */
+	virtual bool NeedsMoreFrames(int32 TileIndex, double& OutReadDelaySeconds) { return false; }
+
+	/**
+	 * Returns the tile's pixels, GetTileSize() in size. Returning true with no pixels skips the tile with a warning;
+	 * returning false aborts the capture.
+	 */
+	virtual bool ReadTile(int32 TileIndex, TArray<FColor>& OutPixels, FString& OutError) = 0;
+
+	/**
+	 * Called right after ReadTile for each additional buffer, while the tile is still in place. Returns the buffer's
+	 * pixels packed as MinimapCaptureBuffers::PackTile does, GetTileSize() in size; false when the source cannot
+	 * produce it, which leaves the tile empty in that buffer.
+	 */
+	virtual bool ReadTileBuffer(int32 TileIndex, EMinimapCaptureBuffer Buffer, TArray<FColor>& OutPixels) { return false; }
+
+	/** Same for each of the settings' floors: the tile with only that floor's Z range drawn. */
+	virtual bool ReadTileFloor(int32 TileIndex, int32 FloorIndex, TArray<FColor>& OutPixels) { return false; }
+
+	/** GPU time of the last tile read; negative when the source does not measure it. */
+	virtual double GetLastGpuSeconds() const { return -1.0; }
+
+	/** Frames rendered for the last tile read. */
+	virtual int32 GetLastFrameCount() const { return 1; }
+};
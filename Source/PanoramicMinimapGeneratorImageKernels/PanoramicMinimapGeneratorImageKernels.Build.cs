@@ -0,0 +1,24 @@
+using UnrealBuildTool;
+
+public class PanoramicMinimapGeneratorImageKernels : ModuleRules
+{
+    public PanoramicMinimapGeneratorImageKernels(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        // CPU-only image processing: no UObjects, no RHI, so it runs on headless agents without a GPU.
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+            }
+        );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "ImageWrapper",
+            }
+        );
+    }
+}
@@ -0,0 +1,162 @@
+#include "MinimapImageKernelBenchmark.h"
+#include "MinimapImageKernels.h"
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace MinimapImageKernels
+{
+	static double TimeBest(const int32 Iterations, const TFunctionRef<void()> Kernel)
+	{
+		Kernel();
+
+		double BestSeconds = TNumericLimits<double>::Max();
+		for (int32 Iteration = 0; Iteration < FMath::Max(1, Iterations); ++Iteration)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Kernel();
+			BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartTime);
+		}
+		return BestSeconds;
+	}
+
+	/** Composites a grid of copies of Tile over the whole canvas the way the stitcher walks a tile layout. */
+	static void CompositeGrid(TArray<FColor>& Canvas, const int32 Size, const TArray<FColor>& Tile, const int32 TileSize,
+	                          const int32 Overlap, const bool bRotate)
+	{
+		const int32 Step = FMath::Max(1, TileSize - Overlap);
+		const int32 NumTiles = Size <= TileSize ? 1 : 1 + FMath::DivideAndRoundUp(Size - TileSize, Step);
+		for (int32 TileY = 0; TileY < NumTiles; ++TileY)
+		{
+			for (int32 TileX = 0; TileX < NumTiles; ++TileX)
+			{
+				FTilePlacement Placement;
+				Placement.Offset = FIntPoint(TileX * Step, TileY * Step);
+				Placement.Overlap = Overlap;
+				Placement.bFeatherLeft = TileX > 0;
+				Placement.bFeatherTop = TileY > 0;
+				Placement.bRotateClockwise = bRotate;
+				CompositeTile(Canvas, FIntPoint(Size, Size), Tile, FIntPoint(TileSize, TileSize), Placement);
+			}
+		}
+	}
+
+	const TArray<FString>& GetBenchmarkKernelNames()
+	{
+		static const TArray<FString> Names = {
+			TEXT("Fill"), TEXT("Composite"), TEXT("CompositeFeather"), TEXT("CompositeRotated"), TEXT("RotateClockwise"),
+			TEXT("Downsample2x"), TEXT("MeanAbsoluteDifference"), TEXT("ConvertToRGBA8"), TEXT("EncodePng")
+		};
+		return Names;
+	}
+
+	void MakeSyntheticImage(TArray<FColor>& Pixels, const FIntPoint& Size, const int32 Seed)
+	{
+		Pixels.SetNumUninitialized(Size.X * Size.Y);
+		FRandomStream Random(Seed);
+		for (int32 y = 0; y < Size.Y; ++y)
+		{
+			for (int32 x = 0; x < Size.X; ++x)
+			{
+				// Terrain-like gradients, 64 px "roads" and a little noise.
+				const uint8 Noise = static_cast<uint8>(Random.RandRange(0, 15));
+				const bool bRoad = ((x / 64) + (y / 64)) % 7 == 0;
+				Pixels[y * Size.X + x] = bRoad
+					? FColor(90 + Noise, 90 + Noise, 90 + Noise, 255)
+					: FColor(static_cast<uint8>(40 + (x * 120) / FMath::Max(1, Size.X) + Noise),
+					         static_cast<uint8>(80 + (y * 120) / FMath::Max(1, Size.Y) + Noise),
+					         static_cast<uint8>(30 + Noise), 255);
+			}
+		}
+	}
+
+	TArray<FMinimapKernelBenchmarkResult> RunBenchmarks(TConstArrayView<int32> Sizes, TConstArrayView<FString> Kernels, const int32 Iterations,
+	                                                     const int32 TileSize, const int32 Overlap)
+	{
+		TArray<FMinimapKernelBenchmarkResult> Results;
+		const auto ShouldRun = [&Kernels](const TCHAR* Kernel)
+		{
+			return Kernels.Num() == 0 || Kernels.Contains(FString(Kernel));
+		};
+
+		for (const int32 Size : Sizes)
+		{
+			if (Size <= 0)
+			{
+				continue;
+			}
+
+			const int32 EffectiveTileSize = FMath::Min(Size, TileSize);
+			const int32 EffectiveOverlap = FMath::Clamp(Overlap, 0, EffectiveTileSize / 2);
+			const double Megapixels = static_cast<double>(Size) * Size / 1000000.0;
+			const auto Record = [&Results, Size, Megapixels](const TCHAR* Kernel, const double Seconds)
+			{
+				FMinimapKernelBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+				Result.Kernel = Kernel;
+				Result.Size = Size;
+				Result.Seconds = Seconds;
+				Result.MegapixelsPerSecond = Seconds > 0.0 ? Megapixels / Seconds : 0.0;
+			};
+
+			TArray<FColor> Tile;
+			MakeSyntheticImage(Tile, FIntPoint(EffectiveTileSize, EffectiveTileSize), Size);
+			TArray<FColor> Canvas;
+			Canvas.SetNumUninitialized(Size * Size);
+
+			if (ShouldRun(TEXT("Fill")))
+			{
+				Record(TEXT("Fill"), TimeBest(Iterations, [&] { Fill(Canvas, FColor::Black); }));
+			}
+			if (ShouldRun(TEXT("Composite")))
+			{
+				Record(TEXT("Composite"), TimeBest(Iterations, [&] { CompositeGrid(Canvas, Size, Tile, EffectiveTileSize, 0, false); }));
+			}
+			if (ShouldRun(TEXT("CompositeFeather")))
+			{
+				Record(TEXT("CompositeFeather"), TimeBest(Iterations, [&] { CompositeGrid(Canvas, Size, Tile, EffectiveTileSize, EffectiveOverlap, false); }));
+			}
+			if (ShouldRun(TEXT("CompositeRotated")))
+			{
+				Record(TEXT("CompositeRotated"), TimeBest(Iterations, [&] { CompositeGrid(Canvas, Size, Tile, EffectiveTileSize, EffectiveOverlap, true); }));
+			}
+
+			// The remaining kernels work on a full canvas; build it once from the composited tiles.
+			CompositeGrid(Canvas, Size, Tile, EffectiveTileSize, 0, false);
+			Tile.Empty();
+
+			if (ShouldRun(TEXT("RotateClockwise")))
+			{
+				TArray<FColor> Rotated;
+				Rotated.SetNumUninitialized(Canvas.Num());
+				Record(TEXT("RotateClockwise"), TimeBest(Iterations, [&] { RotateClockwise(Canvas, FIntPoint(Size, Size), Rotated); }));
+			}
+			if (ShouldRun(TEXT("Downsample2x")))
+			{
+				const FIntPoint HalfSize = GetDownsampledSize(FIntPoint(Size, Size));
+				TArray<FColor> Half;
+				Half.SetNumUninitialized(HalfSize.X * HalfSize.Y);
+				Record(TEXT("Downsample2x"), TimeBest(Iterations, [&] { Downsample2x(Canvas, FIntPoint(Size, Size), Half); }));
+			}
+			if (ShouldRun(TEXT("MeanAbsoluteDifference")))
+			{
+				TArray<FColor> Previous = Canvas;
+				Previous[Previous.Num() / 2] = FColor::White;
+				Record(TEXT("MeanAbsoluteDifference"), TimeBest(Iterations, [&] { MeanAbsoluteDifference(Canvas, Previous); }));
+			}
+			if (ShouldRun(TEXT("ConvertToRGBA8")))
+			{
+				TArray<uint8> Rgba;
+				Rgba.SetNumUninitialized(Canvas.Num() * 4);
+				Record(TEXT("ConvertToRGBA8"), TimeBest(Iterations, [&] { ConvertToRGBA8(Canvas, Rgba); }));
+			}
+			if (ShouldRun(TEXT("EncodePng")))
+			{
+				// Encoding is by far the slowest kernel; one timed run is representative.
+				TArray64<uint8> Png;
+				Record(TEXT("EncodePng"), TimeBest(1, [&] { EncodePng(Canvas, FIntPoint(Size, Size), Png); }));
+			}
+		}
+
+		return Results;
+	}
+}
@@ -0,0 +1,446 @@
+#include "MinimapImageKernels.h"
+
+#include "Async/ParallelFor.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#endif
+
+namespace MinimapImageKernels
+{
+	/** Rows below this many pixels are processed on the calling thread; spreading them costs more than it saves. */
+	constexpr int32 MinParallelPixels = 64 * 1024;
+
+	static EParallelForFlags GetParallelForFlags(const int64 NumPixels)
+	{
+		return NumPixels >= MinParallelPixels ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+	}
+
+	/** Fraction of the tile's own colour at LocalCoord along one feathered edge; 1 outside the band. */
+	static float GetFeatherAlpha(const bool bFeather, const int32 LocalCoord, const int32 Overlap)
+	{
+		return bFeather && LocalCoord < Overlap ? static_cast<float>(LocalCoord) / FMath::Max(1, Overlap - 1) : 1.0f;
+	}
+
+	FColor FeatherBlend(const FColor& Dst, const FColor& Src, const float Alpha)
+	{
+		return FLinearColor::LerpUsingHSV(FLinearColor(Dst), FLinearColor(Src), Alpha).ToFColor(true);
+	}
+
+	void Fill(TArrayView<FColor> Pixels, const FColor Color)
+	{
+		constexpr int32 ChunkSize = 256 * 1024;
+		const int32 NumChunks = FMath::DivideAndRoundUp(Pixels.Num(), ChunkSize);
+		ParallelFor(NumChunks, [&Pixels, Color](const int32 ChunkIndex)
+		{
+			const int32 Start = ChunkIndex * ChunkSize;
+			const int32 End = FMath::Min(Start + ChunkSize, Pixels.Num());
+			for (int32 Index = Start; Index < End; ++Index)
+			{
+				Pixels[Index] = Color;
+			}
+		}, GetParallelForFlags(Pixels.Num()));
+	}
+
+	void CompositeTile(TArrayView<FColor> Canvas, const FIntPoint& CanvasSize, TConstArrayView<FColor> Tile, const FIntPoint& TileSize,
+	                   const FTilePlacement& Placement)
+	{
+		if (Canvas.Num() != CanvasSize.X * CanvasSize.Y || Tile.Num() != TileSize.X * TileSize.Y)
+		{
+			return;
+		}
+
+		const FIntPoint& Offset = Placement.Offset;
+		const int32 Overlap = Placement.Overlap;
+
+		// One source row per task. Rotated or not, distinct source rows never write the same canvas pixel.
+		ParallelFor(TileSize.Y, [&](const int32 y)
+		{
+			const FColor* SrcRow = &Tile[y * TileSize.X];
+
+			if (Placement.bRotateClockwise)
+			{
+				// Source row y becomes canvas column (TileSize.Y - 1 - y); source column x becomes canvas row x.
+				const int32 LocalX = TileSize.Y - 1 - y;
+				const int32 DstX = Offset.X + LocalX;
+				if (DstX < 0 || DstX >= CanvasSize.X)
+				{
+					return;
+				}
+
+				const float AlphaX = GetFeatherAlpha(Placement.bFeatherLeft, LocalX, Overlap);
+				for (int32 x = 0; x < TileSize.X; ++x)
+				{
+					const int32 DstY = Offset.Y + x;
+					if (DstY < 0 || DstY >= CanvasSize.Y)
+					{
+						continue;
+					}
+
+					FColor& Dst = Canvas[DstY * CanvasSize.X + DstX];
+					const float Alpha = FMath::Min(AlphaX, GetFeatherAlpha(Placement.bFeatherTop, x, Overlap));
+					Dst = Alpha < 1.0f ? FeatherBlend(Dst, SrcRow[x], Alpha) : SrcRow[x];
+				}
+				return;
+			}
+
+			const int32 DstY = Offset.Y + y;
+			if (DstY < 0 || DstY >= CanvasSize.Y)
+			{
+				return;
+			}
+
+			const int32 FirstX = FMath::Max(0, -Offset.X);
+			const int32 EndX = FMath::Min(TileSize.X, CanvasSize.X - Offset.X);
+			if (FirstX >= EndX)
+			{
+				return;
+			}
+
+			// May point before the row when Offset.X is negative; only [FirstX, EndX) is dereferenced.
+			FColor* DstRow = Canvas.GetData() + DstY * CanvasSize.X + Offset.X;
+			const float AlphaY = GetFeatherAlpha(Placement.bFeatherTop, y, Overlap);
+
+			// Outside the feather band a row is a straight copy; only its leading Overlap pixels may need blending.
+			const int32 BlendEndX = AlphaY < 1.0f ? EndX : (Placement.bFeatherLeft ? FMath::Clamp(Overlap, FirstX, EndX) : FirstX);
+			for (int32 x = FirstX; x < BlendEndX; ++x)
+			{
+				const float Alpha = FMath::Min(AlphaY, GetFeatherAlpha(Placement.bFeatherLeft, x, Overlap));
+				DstRow[x] = Alpha < 1.0f ? FeatherBlend(DstRow[x], SrcRow[x], Alpha) : SrcRow[x];
+			}
+			if (BlendEndX < EndX)
+			{
+				FMemory::Memcpy(&DstRow[BlendEndX], &SrcRow[BlendEndX], (EndX - BlendEndX) * sizeof(FColor));
+			}
+		}, GetParallelForFlags(Tile.Num()));
+	}
+
+	void RotateClockwise(TConstArrayView<FColor> Src, const FIntPoint& SrcSize, TArrayView<FColor> Dst)
+	{
+		if (Src.Num() != SrcSize.X * SrcSize.Y || Dst.Num() != Src.Num())
+		{
+			return;
+		}
+
+		// Parallel over destination rows so every task writes one contiguous range.
+		const int32 DstWidth = SrcSize.Y;
+		ParallelFor(SrcSize.X, [&](const int32 DstY)
+		{
+			FColor* DstRow = &Dst[DstY * DstWidth];
+			for (int32 DstX = 0; DstX < DstWidth; ++DstX)
+			{
+				DstRow[DstX] = Src[(SrcSize.Y - 1 - DstX) * SrcSize.X + DstY];
+			}
+		}, GetParallelForFlags(Src.Num()));
+	}
+
+	FIntPoint GetDownsampledSize(const FIntPoint& SrcSize)
+	{
+		return FIntPoint(FMath::DivideAndRoundUp(SrcSize.X, 2), FMath::DivideAndRoundUp(SrcSize.Y, 2));
+	}
+
+	void Downsample2x(TConstArrayView<FColor> Src, const FIntPoint& SrcSize, TArrayView<FColor> Dst)
+	{
+		const FIntPoint DstSize = GetDownsampledSize(SrcSize);
+		if (Src.Num() != SrcSize.X * SrcSize.Y || Dst.Num() != DstSize.X * DstSize.Y)
+		{
+			return;
+		}
+
+		ParallelFor(DstSize.Y, [&](const int32 DstY)
+		{
+			const FColor* Row0 = &Src[(DstY * 2) * SrcSize.X];
+			const FColor* Row1 = &Src[FMath::Min(DstY * 2 + 1, SrcSize.Y - 1) * SrcSize.X];
+			FColor* DstRow = &Dst[DstY * DstSize.X];
+			for (int32 DstX = 0; DstX < DstSize.X; ++DstX)
+			{
+				const int32 X0 = DstX * 2;
+				const int32 X1 = FMath::Min(X0 + 1, SrcSize.X - 1);
+				const FColor& A = Row0[X0];
+				const FColor& B = Row0[X1];
+				const FColor& C = Row1[X0];
+				const FColor& D = Row1[X1];
+				DstRow[DstX] = FColor(
+					static_cast<uint8>((A.R + B.R + C.R + D.R + 2) >> 2),
+					static_cast<uint8>((A.G + B.G + C.G + D.G + 2) >> 2),
+					static_cast<uint8>((A.B + B.B + C.B + D.B + 2) >> 2),
+					static_cast<uint8>((A.A + B.A + C.A + D.A + 2) >> 2));
+			}
+		}, GetParallelForFlags(Src.Num()));
+	}
+
+	void ResizeNearest(TConstArrayView<FColor> Src, const FIntPoint& SrcSize, TArrayView<FColor> Dst, const FIntPoint& DstSize)
+	{
+		if (Src.Num() != SrcSize.X * SrcSize.Y || Dst.Num() != DstSize.X * DstSize.Y || Src.Num() == 0)
+		{
+			return;
+		}
+
+		ParallelFor(DstSize.Y, [&](const int32 DstY)
+		{
+			const int32 SrcY = static_cast<int32>(static_cast<int64>(DstY) * SrcSize.Y / DstSize.Y);
+			const FColor* SrcRow = &Src[SrcY * SrcSize.X];
+			FColor* DstRow = &Dst[DstY * DstSize.X];
+			for (int32 DstX = 0; DstX < DstSize.X; ++DstX)
+			{
+				DstRow[DstX] = SrcRow[static_cast<int64>(DstX) * SrcSize.X / DstSize.X];
+			}
+		}, GetParallelForFlags(Dst.Num()));
+	}
+
+	void BlendPatch(TConstArrayView<FColor> Base, TArrayView<FColor> Patch, const FIntPoint& Size, const FIntRect& Region,
+	                const int32 FeatherWidth)
+	{
+		if (Base.Num() != Size.X * Size.Y || Patch.Num() != Base.Num())
+		{
+			return;
+		}
+
+		const int32 Feather = FMath::Max(0, FeatherWidth);
+		ParallelFor(Size.Y, [&](const int32 y)
+		{
+			const FColor* BaseRow = &Base[y * Size.X];
+			FColor* PatchRow = &Patch[y * Size.X];
+			const int32 DistanceY = FMath::Max3(Region.Min.Y - y, y - (Region.Max.Y - 1), 0);
+			if (DistanceY > Feather)
+			{
+				FMemory::Memcpy(PatchRow, BaseRow, Size.X * sizeof(FColor));
+				return;
+			}
+
+			for (int32 x = 0; x < Size.X; ++x)
+			{
+				// Square band: the distance to the region is the larger of the two axis distances.
+				const int32 Distance = FMath::Max(DistanceY, FMath::Max3(Region.Min.X - x, x - (Region.Max.X - 1), 0));
+				if (Distance > Feather)
+				{
+					PatchRow[x] = BaseRow[x];
+				}
+				else if (Distance > 0)
+				{
+					PatchRow[x] = FeatherBlend(BaseRow[x], PatchRow[x], 1.0f - static_cast<float>(Distance) / (Feather + 1));
+				}
+			}
+		}, GetParallelForFlags(Patch.Num()));
+	}
+
+	void FindChangedBlocks(TConstArrayView<FColor> A, TConstArrayView<FColor> B, const FIntPoint& Size, const FIntRect& Region,
+	                       const int32 BlockSize, TArray<FIntRect>& OutRects)
+	{
+		OutRects.Reset();
+		const FIntRect Clipped(FIntPoint::ComponentMax(Region.Min, FIntPoint::ZeroValue), FIntPoint::ComponentMin(Region.Max, Size));
+		if (Clipped.Width() <= 0 || Clipped.Height() <= 0)
+		{
+			return;
+		}
+		// Nothing can be compared, so all of it counts as changed.
+		if (A.Num() != Size.X * Size.Y || B.Num() != A.Num() || BlockSize <= 0)
+		{
+			OutRects.Add(Clipped);
+			return;
+		}
+
+		const FIntPoint NumBlocks(FMath::DivideAndRoundUp(Clipped.Width(), BlockSize), FMath::DivideAndRoundUp(Clipped.Height(), BlockSize));
+		TArray<TArray<FIntRect>> BlockRowRects;
+		BlockRowRects.SetNum(NumBlocks.Y);
+		ParallelFor(NumBlocks.Y, [&](const int32 BlockY)
+		{
+			const int32 MinY = Clipped.Min.Y + BlockY * BlockSize;
+			const int32 MaxY = FMath::Min(MinY + BlockSize, Clipped.Max.Y);
+			TBitArray<> Changed(false, NumBlocks.X);
+			for (int32 y = MinY; y < MaxY; ++y)
+			{
+				for (int32 BlockX = 0; BlockX < NumBlocks.X; ++BlockX)
+				{
+					const int32 MinX = Clipped.Min.X + BlockX * BlockSize;
+					const int32 Width = FMath::Min(BlockSize, Clipped.Max.X - MinX);
+					const int32 Offset = y * Size.X + MinX;
+					if (!Changed[BlockX] && FMemory::Memcmp(&A[Offset], &B[Offset], Width * sizeof(FColor)) != 0)
+					{
+						Changed[BlockX] = true;
+					}
+				}
+			}
+
+			for (int32 BlockX = 0; BlockX < NumBlocks.X; ++BlockX)
+			{
+				if (!Changed[BlockX])
+				{
+					continue;
+				}
+				const int32 FirstBlockX = BlockX;
+				while (BlockX + 1 < NumBlocks.X && Changed[BlockX + 1])
+				{
+					++BlockX;
+				}
+				BlockRowRects[BlockY].Emplace(Clipped.Min.X + FirstBlockX * BlockSize, MinY,
+					FMath::Min(Clipped.Min.X + (BlockX + 1) * BlockSize, Clipped.Max.X), MaxY);
+			}
+		}, GetParallelForFlags(Clipped.Area()));
+
+		for (TArray<FIntRect>& Rects : BlockRowRects)
+		{
+			OutRects.Append(MoveTemp(Rects));
+		}
+	}
+
+	/** Sum of |A - B| over every byte of Num pixels. */
+	static uint64 SumAbsoluteDifferences(const FColor* A, const FColor* B, const int32 Num)
+	{
+		uint64 Sum = 0;
+		int32 Index = 0;
+#if PLATFORM_CPU_X86_FAMILY
+		// Four pixels per step; _mm_sad_epu8 sums each half of the 16 bytes into a 64-bit lane.
+		__m128i Sums = _mm_setzero_si128();
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			const __m128i PixelsA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(A + Index));
+			const __m128i PixelsB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(B + Index));
+			Sums = _mm_add_epi64(Sums, _mm_sad_epu8(PixelsA, PixelsB));
+		}
+		alignas(16) uint64 Lanes[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(Lanes), Sums);
+		Sum = Lanes[0] + Lanes[1];
+#endif
+		for (; Index < Num; ++Index)
+		{
+			Sum += FMath::Abs(A[Index].R - B[Index].R) + FMath::Abs(A[Index].G - B[Index].G) +
+				FMath::Abs(A[Index].B - B[Index].B) + FMath::Abs(A[Index].A - B[Index].A);
+		}
+		return Sum;
+	}
+
+	double MeanAbsoluteDifference(TConstArrayView<FColor> A, TConstArrayView<FColor> B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return -1.0;
+		}
+		if (A.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		constexpr int32 ChunkSize = 256 * 1024;
+		const int32 NumChunks = FMath::DivideAndRoundUp(A.Num(), ChunkSize);
+		TArray<uint64, TInlineAllocator<64>> ChunkSums;
+		ChunkSums.SetNumZeroed(NumChunks);
+		ParallelFor(NumChunks, [&](const int32 ChunkIndex)
+		{
+			const int32 Start = ChunkIndex * ChunkSize;
+			ChunkSums[ChunkIndex] = SumAbsoluteDifferences(A.GetData() + Start, B.GetData() + Start, FMath::Min(ChunkSize, A.Num() - Start));
+		}, GetParallelForFlags(A.Num()));
+
+		uint64 Sum = 0;
+		for (const uint64 ChunkSum : ChunkSums)
+		{
+			Sum += ChunkSum;
+		}
+		return static_cast<double>(Sum) / (static_cast<double>(A.Num()) * 4.0);
+	}
+
+	void ConvertToRGBA8(TConstArrayView<FColor> Src, TArrayView<uint8> Dst)
+	{
+		if (Dst.Num() != Src.Num() * 4)
+		{
+			return;
+		}
+
+		constexpr int32 ChunkSize = 256 * 1024;
+		const int32 NumChunks = FMath::DivideAndRoundUp(Src.Num(), ChunkSize);
+		ParallelFor(NumChunks, [&](const int32 ChunkIndex)
+		{
+			const int32 Start = ChunkIndex * ChunkSize;
+			const int32 End = FMath::Min(Start + ChunkSize, Src.Num());
+			for (int32 Index = Start; Index < End; ++Index)
+			{
+				const FColor& Pixel = Src[Index];
+				uint8* Out = &Dst[Index * 4];
+				Out[0] = Pixel.R;
+				Out[1] = Pixel.G;
+				Out[2] = Pixel.B;
+				Out[3] = Pixel.A;
+			}
+		}, GetParallelForFlags(Src.Num()));
+	}
+
+	bool EncodePng(TConstArrayView<FColor> Pixels, const FIntPoint& Size, TArray64<uint8>& OutPng)
+	{
+		return EncodeImage(Pixels, Size, EMinimapImageFormat::Png, 0, OutPng);
+	}
+
+	bool EncodeImage(TConstArrayView<FColor> Pixels, const FIntPoint& Size, const EMinimapImageFormat Format, const int32 Quality,
+	                 TArray64<uint8>& OutData)
+	{
+		OutData.Reset();
+		if (Pixels.Num() != Size.X * Size.Y || Pixels.Num() == 0)
+		{
+			return false;
+		}
+
+		EImageFormat WrapperFormat = EImageFormat::PNG;
+		int32 CompressionQuality = static_cast<int32>(EImageCompressionQuality::Default);
+		switch (Format)
+		{
+		case EMinimapImageFormat::Jpeg:
+			WrapperFormat = EImageFormat::JPEG;
+			CompressionQuality = FMath::Clamp(Quality, 1, 100);
+			break;
+		case EMinimapImageFormat::Bmp:
+			WrapperFormat = EImageFormat::BMP;
+			break;
+		case EMinimapImageFormat::Png:
+		default:
+			break;
+		}
+
+		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+		const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(WrapperFormat);
+		if (!ImageWrapper.IsValid() ||
+			!ImageWrapper->SetRaw(Pixels.GetData(), static_cast<int64>(Pixels.Num()) * sizeof(FColor), Size.X, Size.Y, ERGBFormat::BGRA, 8))
+		{
+			return false;
+		}
+
+		OutData = ImageWrapper->GetCompressed(CompressionQuality);
+		return OutData.Num() > 0;
+	}
+
+	const TCHAR* GetImageFormatExtension(const EMinimapImageFormat Format)
+	{
+		switch (Format)
+		{
+		case EMinimapImageFormat::Jpeg:
+			return TEXT("jpg");
+		case EMinimapImageFormat::Bmp:
+			return TEXT("bmp");
+		case EMinimapImageFormat::Png:
+		default:
+			return TEXT("png");
+		}
+	}
+
+	bool ParseImageFormat(const FString& Name, EMinimapImageFormat& OutFormat)
+	{
+		if (Name.Equals(TEXT("png"), ESearchCase::IgnoreCase))
+		{
+			OutFormat = EMinimapImageFormat::Png;
+		}
+		else if (Name.Equals(TEXT("jpg"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("jpeg"), ESearchCase::IgnoreCase))
+		{
+			OutFormat = EMinimapImageFormat::Jpeg;
+		}
+		else if (Name.Equals(TEXT("bmp"), ESearchCase::IgnoreCase))
+		{
+			OutFormat = EMinimapImageFormat::Bmp;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+}
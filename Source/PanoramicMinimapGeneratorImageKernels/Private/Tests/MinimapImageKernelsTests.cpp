@@ -0,0 +1,283 @@
+#include "MinimapImageKernels.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Behaviour checks for the image kernels on small synthetic images, against outputs worked out by hand. They need
+ * no world or GPU: run them with "Automation RunTests OBPanoramicMinimapGenerator.ImageKernels" under -nullrhi.
+ */
+namespace MinimapImageKernelsTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	const FColor Blue(0, 0, 255, 255);
+	const FColor Red(255, 0, 0, 255);
+
+	/** Pixel I has red channel I, so a pixel shows where it came from. */
+	static TArray<FColor> MakeIndexedPixels(const int32 Num)
+	{
+		TArray<FColor> Pixels;
+		Pixels.Reserve(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Pixels.Emplace(static_cast<uint8>(Index), 0, 0, 255);
+		}
+		return Pixels;
+	}
+
+	static void TestPixels(FAutomationTestBase& Test, const TCHAR* What, TConstArrayView<FColor> Actual, TConstArrayView<FColor> Expected)
+	{
+		if (!Test.TestEqual(FString::Printf(TEXT("%s: pixel count"), What), Actual.Num(), Expected.Num()))
+		{
+			return;
+		}
+		for (int32 Index = 0; Index < Actual.Num(); ++Index)
+		{
+			Test.TestEqual(FString::Printf(TEXT("%s: pixel %d"), What, Index), Actual[Index], Expected[Index]);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinimapCompositeTileTest, "OBPanoramicMinimapGenerator.ImageKernels.CompositeTile", MinimapImageKernelsTests::TestFlags)
+
+bool FMinimapCompositeTileTest::RunTest(const FString& Parameters)
+{
+	using namespace MinimapImageKernels;
+	using namespace MinimapImageKernelsTests;
+
+	// Left feather over 3 px: alpha 0, 0.5, 1 across the band, then a plain copy.
+	{
+		TArray<FColor> Canvas;
+		Canvas.Init(Blue, 4);
+		TArray<FColor> Tile;
+		Tile.Init(Red, 4);
+		FTilePlacement Placement;
+		Placement.Overlap = 3;
+		Placement.bFeatherLeft = true;
+		CompositeTile(Canvas, FIntPoint(4, 1), Tile, FIntPoint(4, 1), Placement);
+		TestPixels(*this, TEXT("Left feather"), Canvas, {FeatherBlend(Blue, Red, 0.0f), FeatherBlend(Blue, Red, 0.5f), Red, Red});
+	}
+
+	// A negative offset clips the tile's first columns; the canvas pixels it does not reach keep their colour.
+	{
+		TArray<FColor> Canvas;
+		Canvas.Init(Blue, 4);
+		const TArray<FColor> Tile = MakeIndexedPixels(4);
+		FTilePlacement Placement;
+		Placement.Offset = FIntPoint(-2, 0);
+		CompositeTile(Canvas, FIntPoint(4, 1), Tile, FIntPoint(4, 1), Placement);
+		TestPixels(*this, TEXT("Negative offset"), Canvas, {Tile[2], Tile[3], Blue, Blue});
+	}
+
+	// A 2x3 tile turned clockwise onto a 3x2 canvas: source (x, y) lands on canvas (2 - y, x).
+	{
+		TArray<FColor> Canvas;
+		Canvas.Init(Blue, 6);
+		const TArray<FColor> Tile = MakeIndexedPixels(6);
+		FTilePlacement Placement;
+		Placement.bRotateClockwise = true;
+		CompositeTile(Canvas, FIntPoint(3, 2), Tile, FIntPoint(2, 3), Placement);
+		TestPixels(*this, TEXT("Rotated placement"), Canvas, {Tile[4], Tile[2], Tile[0], Tile[5], Tile[3], Tile[1]});
+	}
+
+	// Rotated tiles feather along the canvas edges, not their own: the left band runs across canvas columns.
+	{
+		TArray<FColor> Canvas;
+		Canvas.Init(Blue, 6);
+		TArray<FColor> Tile;
+		Tile.Init(Red, 6);
+		FTilePlacement Placement;
+		Placement.Overlap = 3;
+		Placement.bFeatherLeft = true;
+		Placement.bRotateClockwise = true;
+		CompositeTile(Canvas, FIntPoint(3, 2), Tile, FIntPoint(2, 3), Placement);
+		const FColor Edge = FeatherBlend(Blue, Red, 0.0f);
+		const FColor Half = FeatherBlend(Blue, Red, 0.5f);
+		TestPixels(*this, TEXT("Rotated left feather"), Canvas, {Edge, Half, Red, Edge, Half, Red});
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinimapRotateClockwiseTest, "OBPanoramicMinimapGenerator.ImageKernels.RotateClockwise", MinimapImageKernelsTests::TestFlags)
+
+bool FMinimapRotateClockwiseTest::RunTest(const FString& Parameters)
+{
+	using namespace MinimapImageKernelsTests;
+
+	// [0 1 2]      [3 0]
+	// [3 4 5]  ->  [4 1]
+	//              [5 2]
+	const TArray<FColor> Src = MakeIndexedPixels(6);
+	TArray<FColor> Dst;
+	Dst.SetNumZeroed(6);
+	MinimapImageKernels::RotateClockwise(Src, FIntPoint(3, 2), Dst);
+	TestPixels(*this, TEXT("3x2 turned clockwise"), Dst, {Src[3], Src[0], Src[4], Src[1], Src[5], Src[2]});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinimapDownsample2xTest, "OBPanoramicMinimapGenerator.ImageKernels.Downsample2x", MinimapImageKernelsTests::TestFlags)
+
+bool FMinimapDownsample2xTest::RunTest(const FString& Parameters)
+{
+	using namespace MinimapImageKernels;
+	using namespace MinimapImageKernelsTests;
+
+	TestEqual(TEXT("3x3 halves to 2x2"), GetDownsampledSize(FIntPoint(3, 3)).ToString(), FIntPoint(2, 2).ToString());
+	TestEqual(TEXT("4x1 halves to 2x1"), GetDownsampledSize(FIntPoint(4, 1)).ToString(), FIntPoint(2, 1).ToString());
+
+	// Odd sizes replicate the last column and row:
+	// [0 1 2]     (0+1+3+4+2)/4 = 2   (2+2+5+5+2)/4 = 4
+	// [3 4 5]  -> (6+7+6+7+2)/4 = 7   (8+8+8+8+2)/4 = 8
+	// [6 7 8]
+	const TArray<FColor> Src = MakeIndexedPixels(9);
+	TArray<FColor> Dst;
+	Dst.SetNumZeroed(4);
+	Downsample2x(Src, FIntPoint(3, 3), Dst);
+	TestPixels(*this, TEXT("3x3 box filter"), Dst, {FColor(2, 0, 0, 255), FColor(4, 0, 0, 255), FColor(7, 0, 0, 255), FColor(8, 0, 0, 255)});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinimapResizeNearestTest, "OBPanoramicMinimapGenerator.ImageKernels.ResizeNearest", MinimapImageKernelsTests::TestFlags)
+
+bool FMinimapResizeNearestTest::RunTest(const FString& Parameters)
+{
+	using namespace MinimapImageKernels;
+	using namespace MinimapImageKernelsTests;
+
+	// 2x2 up to 4x3: columns map 0 0 1 1, rows map 0 0 1.
+	const TArray<FColor> Src = MakeIndexedPixels(4);
+	TArray<FColor> Dst;
+	Dst.SetNumZeroed(12);
+	ResizeNearest(Src, FIntPoint(2, 2), Dst, FIntPoint(4, 3));
+	TestPixels(*this, TEXT("2x2 to 4x3"), Dst, {
+		Src[0], Src[0], Src[1], Src[1],
+		Src[0], Src[0], Src[1], Src[1],
+		Src[2], Src[2], Src[3], Src[3]});
+
+	// 4x1 down to 2x1 keeps every other column.
+	const TArray<FColor> Row = MakeIndexedPixels(4);
+	TArray<FColor> Half;
+	Half.SetNumZeroed(2);
+	ResizeNearest(Row, FIntPoint(4, 1), Half, FIntPoint(2, 1));
+	TestPixels(*this, TEXT("4x1 to 2x1"), Half, {Row[0], Row[2]});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinimapBlendPatchTest, "OBPanoramicMinimapGenerator.ImageKernels.BlendPatch", MinimapImageKernelsTests::TestFlags)
+
+bool FMinimapBlendPatchTest::RunTest(const FString& Parameters)
+{
+	using namespace MinimapImageKernels;
+	using namespace MinimapImageKernelsTests;
+
+	// Region is pixel 3 of a 7x1 row with a 2 px band: the patch weight is 1 - Distance / 3 inside the band.
+	{
+		TArray<FColor> Base;
+		Base.Init(Blue, 7);
+		TArray<FColor> Patch;
+		Patch.Init(Red, 7);
+		BlendPatch(Base, Patch, FIntPoint(7, 1), FIntRect(3, 0, 4, 1), 2);
+		const FColor Near = FeatherBlend(Blue, Red, 1.0f - 1.0f / 3);
+		const FColor Far = FeatherBlend(Blue, Red, 1.0f - 2.0f / 3);
+		TestPixels(*this, TEXT("Horizontal band"), Patch, {Blue, Far, Near, Red, Near, Far, Blue});
+	}
+
+	// The band is square: a diagonal neighbour is at distance 1, and everything 2 px away is outside a 1 px band.
+	{
+		TArray<FColor> Base;
+		Base.Init(Blue, 25);
+		TArray<FColor> Patch;
+		Patch.Init(Red, 25);
+		BlendPatch(Base, Patch, FIntPoint(5, 5), FIntRect(2, 2, 3, 3), 1);
+		const FColor Band = FeatherBlend(Blue, Red, 0.5f);
+		TestPixels(*this, TEXT("Square band"), Patch, {
+			Blue, Blue, Blue, Blue, Blue,
+			Blue, Band, Band, Band, Blue,
+			Blue, Band, Red, Band, Blue,
+			Blue, Band, Band, Band, Blue,
+			Blue, Blue, Blue, Blue, Blue});
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinimapMeanAbsoluteDifferenceTest, "OBPanoramicMinimapGenerator.ImageKernels.MeanAbsoluteDifference",
+                                 MinimapImageKernelsTests::TestFlags)
+
+bool FMinimapMeanAbsoluteDifferenceTest::RunTest(const FString& Parameters)
+{
+	using namespace MinimapImageKernels;
+
+	// 7 pixels: the first 4 go through the SIMD path on x86, the last 3 through the scalar tail. A is larger than B
+	// in the tail's green channel so both signs of the difference are covered.
+	TArray<FColor> A;
+	A.Init(FColor(0, 0, 0, 0), 7);
+	TArray<FColor> B;
+	B.Init(FColor(0, 0, 0, 0), 7);
+	for (int32 Index = 0; Index < 7; ++Index)
+	{
+		B[Index].R = static_cast<uint8>(10 * (Index + 1));
+	}
+	A[5].G = 14;
+	A[6].G = 16;
+
+	// Sums: 10+20+30+40 = 100 over 4 pixels; 50+60+70+14+16 = 210 over 3 pixels; 310 over all 7. Four channels each.
+	TestEqual(TEXT("SIMD block only"), MeanAbsoluteDifference(MakeArrayView(A).Left(4), MakeArrayView(B).Left(4)), 100.0 / 16.0);
+	TestEqual(TEXT("Scalar tail only"), MeanAbsoluteDifference(MakeArrayView(A).Right(3), MakeArrayView(B).Right(3)), 210.0 / 12.0);
+	TestEqual(TEXT("Block and tail"), MeanAbsoluteDifference(A, B), 310.0 / 28.0);
+	TestEqual(TEXT("Symmetric"), MeanAbsoluteDifference(B, A), 310.0 / 28.0);
+	TestEqual(TEXT("Identical"), MeanAbsoluteDifference(A, A), 0.0);
+	TestEqual(TEXT("Empty"), MeanAbsoluteDifference(TConstArrayView<FColor>(), TConstArrayView<FColor>()), 0.0);
+	TestEqual(TEXT("Size mismatch"), MeanAbsoluteDifference(MakeArrayView(A).Left(3), B), -1.0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinimapFindChangedBlocksTest, "OBPanoramicMinimapGenerator.ImageKernels.FindChangedBlocks", MinimapImageKernelsTests::TestFlags)
+
+bool FMinimapFindChangedBlocksTest::RunTest(const FString& Parameters)
+{
+	using namespace MinimapImageKernels;
+	using namespace MinimapImageKernelsTests;
+
+	// 5x3 in 2 px blocks is a 3x2 block grid whose last column and row are 1 px.
+	const FIntPoint Size(5, 3);
+	const TArray<FColor> A = MakeIndexedPixels(15);
+	TArray<FIntRect> Rects;
+
+	const FIntRect Whole(FIntPoint::ZeroValue, Size);
+	FindChangedBlocks(A, A, Size, Whole, 2, Rects);
+	TestEqual(TEXT("Identical images have no changed block"), Rects.Num(), 0);
+
+	// Changes in blocks (0,0) and (1,0) merge into one rect; (0,1) and the clipped corner (2,1) stay apart.
+	TArray<FColor> B = A;
+	B[0 * 5 + 0] = Blue;
+	B[1 * 5 + 2] = Blue;
+	B[2 * 5 + 0] = Blue;
+	B[2 * 5 + 4] = Blue;
+	FindChangedBlocks(A, B, Size, Whole, 2, Rects);
+	const TArray<FIntRect> Expected = {FIntRect(0, 0, 4, 2), FIntRect(0, 2, 2, 3), FIntRect(4, 2, 5, 3)};
+	if (TestEqual(TEXT("Changed rect count"), Rects.Num(), Expected.Num()))
+	{
+		for (int32 Index = 0; Index < Rects.Num(); ++Index)
+		{
+			TestEqual(FString::Printf(TEXT("Changed rect %d"), Index), Rects[Index].ToString(), Expected[Index].ToString());
+		}
+	}
+
+	// Blocks count from the region's corner and are clipped to it; the changes outside it are not seen.
+	FindChangedBlocks(A, B, Size, FIntRect(1, 1, 4, 3), 2, Rects);
+	if (TestEqual(TEXT("Region changed rect count"), Rects.Num(), 1))
+	{
+		TestEqual(TEXT("Region changed rect"), Rects[0].ToString(), FIntRect(1, 1, 3, 3).ToString());
+	}
+
+	FindChangedBlocks(A, MakeArrayView(B).Left(10), Size, Whole, 2, Rects);
+	if (TestEqual(TEXT("Size mismatch rect count"), Rects.Num(), 1))
+	{
+		TestEqual(TEXT("Size mismatch changes the whole region"), Rects[0].ToString(), Whole.ToString());
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Throughput of one kernel on one synthetic canvas size. */
+struct FMinimapKernelBenchmarkResult
+{
+	FString Kernel;
+	/** Side of the square canvas the kernel processed. */
+	int32 Size = 0;
+	/** Best wall time over the measured iterations. */
+	double Seconds = 0.0;
+	double MegapixelsPerSecond = 0.0;
+};
+
+namespace MinimapImageKernels
+{
+	/** Kernel names accepted by RunBenchmarks, in the order they run. */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API const TArray<FString>& GetBenchmarkKernelNames();
+
+	/**
+	 * Times every requested kernel on square synthetic canvases of each size, composed of TileSize tiles with a
+	 * deterministic pattern so runs are comparable across machines and builds. An empty Kernels list runs them all.
+	 * Each kernel runs once to warm up and is then timed Iterations times; the fastest run is reported.
+	 */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API TArray<FMinimapKernelBenchmarkResult> RunBenchmarks(
+		TConstArrayView<int32> Sizes, TConstArrayView<FString> Kernels, int32 Iterations = 3, int32 TileSize = 2048, int32 Overlap = 64);
+
+	/** Fills Pixels with gradients, hard edges and noise that compress roughly like a rendered minimap. */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API void MakeSyntheticImage(TArray<FColor>& Pixels, const FIntPoint& Size, int32 Seed);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// CPU image kernels used to build the final minimap: compositing tiles into the canvas, feather blending,
+// the portrait orientation fix-up, downsampling, format conversion and PNG encoding.
+// All images are tightly packed, row-major FColor (BGRA8, sRGB) buffers. Large kernels split their rows across
+// the task graph; none of them touch UObjects or the RHI.
+
+/** File formats the final image can be encoded to. */
+enum class EMinimapImageFormat : uint8
+{
+	Png,
+	Jpeg,
+	Bmp,
+};
+
+namespace MinimapImageKernels
+{
+	/** Where and how a tile lands on the canvas. */
+	struct FTilePlacement
+	{
+		/** Canvas position of the tile's top-left pixel, after rotation. */
+		FIntPoint Offset = FIntPoint::ZeroValue;
+
+		/** Width of the feathered band along the edges shared with previously composited tiles. */
+		int32 Overlap = 0;
+		bool bFeatherLeft = false;
+		bool bFeatherTop = false;
+
+		/** The tile was captured rotated by 90 degrees (portrait output) and is turned clockwise onto the canvas. */
+		bool bRotateClockwise = false;
+	};
+
+	/** Blends Src over Dst in linear space with HSV interpolation, as the stitcher has always done in overlaps. */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API FColor FeatherBlend(const FColor& Dst, const FColor& Src, float Alpha);
+
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API void Fill(TArrayView<FColor> Pixels, FColor Color);
+
+	/**
+	 * Writes a tile into the canvas, clipped to it. Pixels inside the feather band are blended with what is already
+	 * there; everything else is copied. Rows are processed in parallel.
+	 */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API void CompositeTile(TArrayView<FColor> Canvas, const FIntPoint& CanvasSize,
+	                                                             TConstArrayView<FColor> Tile, const FIntPoint& TileSize,
+	                                                             const FTilePlacement& Placement);
+
+	/** Dst (SrcSize.Y x SrcSize.X) receives Src turned 90 degrees clockwise. */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API void RotateClockwise(TConstArrayView<FColor> Src, const FIntPoint& SrcSize, TArrayView<FColor> Dst);
+
+	/** Halves both dimensions (rounding up) with a 2x2 box filter; edge pixels are replicated for odd sizes. */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API FIntPoint GetDownsampledSize(const FIntPoint& SrcSize);
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API void Downsample2x(TConstArrayView<FColor> Src, const FIntPoint& SrcSize, TArrayView<FColor> Dst);
+
+	/** Scales Src to DstSize with nearest-neighbour sampling, e.g. to stretch a coarse preview over the full canvas. */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API void ResizeNearest(TConstArrayView<FColor> Src, const FIntPoint& SrcSize, TArrayView<FColor> Dst,
+	                                                             const FIntPoint& DstSize);
+
+	/**
+	 * Blends a recaptured region into an existing image of the same Size: Patch is kept inside Region, Base outside it,
+	 * and Patch fades into Base over FeatherWidth pixels around the region. The result is written to Patch.
+	 */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API void BlendPatch(TConstArrayView<FColor> Base, TArrayView<FColor> Patch, const FIntPoint& Size,
+	                                                          const FIntRect& Region, int32 FeatherWidth);
+
+	/**
+	 * Mean absolute difference of A and B per 8-bit channel (0-255), alpha included; -1 when the sizes differ.
+	 * Cheap enough to compare every frame of a tile: SSE2 sums of absolute differences on x86, scalar elsewhere.
+	 */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API double MeanAbsoluteDifference(TConstArrayView<FColor> A, TConstArrayView<FColor> B);
+
+	/**
+	 * Regions of Region where two images of Size differ, in BlockSize blocks counted from Region.Min and clipped to the
+	 * region and the image: changed blocks next to each other in a block row are merged into one rect. Pixels outside
+	 * Region are not read. Empty when the images are identical there; the whole region when A or B is not Size.
+	 */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API void FindChangedBlocks(TConstArrayView<FColor> A, TConstArrayView<FColor> B, const FIntPoint& Size,
+	                                                                 const FIntRect& Region, int32 BlockSize, TArray<FIntRect>& OutRects);
+
+	/** Byte-swizzles BGRA8 pixels to RGBA8 (4 bytes per pixel in Dst). */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API void ConvertToRGBA8(TConstArrayView<FColor> Src, TArrayView<uint8> Dst);
+
+	/** Encodes BGRA8 pixels as PNG with the engine's image wrapper. Returns false if encoding failed. */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API bool EncodePng(TConstArrayView<FColor> Pixels, const FIntPoint& Size, TArray64<uint8>& OutPng);
+
+	/** Encodes BGRA8 pixels in the given format. Quality (1-100) only applies to JPEG; JPEG drops alpha. */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API bool EncodeImage(TConstArrayView<FColor> Pixels, const FIntPoint& Size, EMinimapImageFormat Format,
+	                                                           int32 Quality, TArray64<uint8>& OutData);
+
+	/** File extension without the dot: "png", "jpg" or "bmp". */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API const TCHAR* GetImageFormatExtension(EMinimapImageFormat Format);
+
+	/** Parses "png", "jpg"/"jpeg" or "bmp" (case-insensitive). */
+	PANORAMICMINIMAPGENERATORIMAGEKERNELS_API bool ParseImageFormat(const FString& Name, EMinimapImageFormat& OutFormat);
+}
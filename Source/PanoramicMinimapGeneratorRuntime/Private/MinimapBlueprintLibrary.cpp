@@ -85,6 +85,19 @@ FVector UMinimapBlueprintLibrary::MapUVToWorldLocation(const UMinimapDefinitionD
 		WorldZ);
 }
 
+FVector2D UMinimapBlueprintLibrary::MapUVToTextureUV(const UMinimapDefinitionDataAsset* MinimapDefinition, const FVector2D MapUV)
+{
+	if (!MinimapDefinition || MinimapDefinition->TextureMode != EMinimapTextureMode::VirtualTextureUDIM || MinimapDefinition->UDIMPageSize <= 0)
+	{
+		return MapUV;
+	}
+
+	// One UV unit per page; the map ends inside the last page where its padding starts.
+	return FVector2D(
+		MapUV.X * MinimapDefinition->OutputSize.X / MinimapDefinition->UDIMPageSize,
+		MapUV.Y * MinimapDefinition->OutputSize.Y / MinimapDefinition->UDIMPageSize);
+}
+
 void UMinimapBlueprintLibrary::GetOverlayElementsByCategory(const UMinimapDefinitionDataAsset* MinimapDefinition, const FName Category, TArray<FMinimapOverlayElement>& OutElements)
 {
 	OutElements.Reset();
@@ -124,3 +137,16 @@ void UMinimapBlueprintLibrary::GetOverlayElementsByTag(const UMinimapDefinitionD
 		}
 	}
 }
+
+int32 UMinimapBlueprintLibrary::FindFloorIndex(const UMinimapDefinitionDataAsset* MinimapDefinition, const float WorldZ)
+{
+	if (!MinimapDefinition)
+	{
+		return INDEX_NONE;
+	}
+
+	return MinimapDefinition->Floors.IndexOfByPredicate([WorldZ](const FMinimapFloor& Floor)
+	{
+		return WorldZ >= Floor.Range.MinZ && WorldZ < Floor.Range.MaxZ;
+	});
+}
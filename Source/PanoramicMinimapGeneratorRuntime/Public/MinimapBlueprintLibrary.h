@@ -20,9 +20,20 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Minimap")
 	static FVector MapUVToWorldLocation(const UMinimapDefinitionDataAsset* MinimapDefinition, FVector2D MapUV, float WorldZ = 0.0f, bool bClampToBounds = true);
 
+	/**
+	 * UVs to sample BaseMapTexture with at a map UV. The same UVs for a single texture; for a UDIM virtual texture,
+	 * the map spans UDIMPageCount pages in UV space, minus the padding of the last pages.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Minimap")
+	static FVector2D MapUVToTextureUV(const UMinimapDefinitionDataAsset* MinimapDefinition, FVector2D MapUV);
+
 	UFUNCTION(BlueprintPure, Category = "Minimap")
 	static void GetOverlayElementsByCategory(const UMinimapDefinitionDataAsset* MinimapDefinition, FName Category, TArray<FMinimapOverlayElement>& OutElements);
 
 	UFUNCTION(BlueprintPure, Category = "Minimap")
 	static void GetOverlayElementsByTag(const UMinimapDefinitionDataAsset* MinimapDefinition, FName Tag, TArray<FMinimapOverlayElement>& OutElements);
+
+	/** Index of the floor whose Z range contains WorldZ, or -1 when none does. */
+	UFUNCTION(BlueprintPure, Category = "Minimap")
+	static int32 FindFloorIndex(const UMinimapDefinitionDataAsset* MinimapDefinition, float WorldZ);
 };
@@ -77,6 +77,51 @@ struct PANORAMICMINIMAPGENERATORRUNTIME_API FMinimapOverlayLayer
 	TArray<FMinimapOverlayElement> Elements;
 };
 
+/** How BaseMapTexture stores the map. */
+UENUM(BlueprintType)
+enum class EMinimapTextureMode : uint8
+{
+	/** One regular texture over the whole map, sampled with the map UVs. */
+	SingleTexture UMETA(DisplayName = "Single Texture"),
+	/**
+	 * A streaming virtual texture with one UDIM page per UDIMPageSize block of the map, so maps beyond the largest
+	 * texture size can be stored and only the pages on screen are loaded. Sampled with MapUVToTextureUV.
+	 */
+	VirtualTextureUDIM UMETA(DisplayName = "Virtual Texture (UDIM)"),
+};
+
+/** A horizontal slice of the level, e.g. one floor of a building, captured into its own map. */
+USTRUCT(BlueprintType)
+struct PANORAMICMINIMAPGENERATORRUNTIME_API FMinimapFloorRange
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floor")
+	FName Name;
+
+	/** Geometry entirely below this height is not drawn. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floor")
+	float MinZ = 0.0f;
+
+	/** Geometry above this height, such as the floors overhead, is clipped away. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floor")
+	float MaxZ = 400.0f;
+};
+
+USTRUCT(BlueprintType)
+struct PANORAMICMINIMAPGENERATORRUNTIME_API FMinimapFloor
+{
+	GENERATED_BODY()
+
+	/** The name and Z range the floor was captured with. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floor", meta = (ShowOnlyInnerProperties))
+	FMinimapFloorRange Range;
+
+	/** The floor's map, in the same projection and bounds as BaseMapTexture. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floor")
+	TObjectPtr<UTexture2D> Texture = nullptr;
+};
+
 UCLASS(BlueprintType)
 class PANORAMICMINIMAPGENERATORRUNTIME_API UMinimapDefinitionDataAsset : public UDataAsset
 {
@@ -95,9 +140,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Minimap")
 	float MapRotationDegrees = 0.0f;
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Minimap")
+	EMinimapTextureMode TextureMode = EMinimapTextureMode::SingleTexture;
+
+	/** Virtual Texture (UDIM) only: pixel size of every page. Pages on the right and bottom edges are padded to it. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Minimap", meta = (EditCondition = "TextureMode == EMinimapTextureMode::VirtualTextureUDIM"))
+	int32 UDIMPageSize = 0;
+
+	/** Virtual Texture (UDIM) only: pages across and down. Page (X, Y) is UDIM 1001 + X + 10 * Y and covers texture UVs X..X+1, Y..Y+1. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Minimap", meta = (EditCondition = "TextureMode == EMinimapTextureMode::VirtualTextureUDIM"))
+	FIntPoint UDIMPageCount = FIntPoint::ZeroValue;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Minimap")
 	bool bClampQueriesToBounds = true;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Overlay")
 	TArray<FMinimapOverlayLayer> OverlayLayers;
+
+	/** One map per floor, lowest first when captured that way; empty for single-level maps. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Floors")
+	TArray<FMinimapFloor> Floors;
 };